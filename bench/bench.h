@@ -0,0 +1,171 @@
+/*!
+ * \file bench.h
+ * \author Akhatar Abdelhamid <abdelhamid.akhatar@etu.cyu.fr>
+ * \version 1.0
+ * \date November 2, 2025
+ * \brief Timing and syscall counting shared by the benchmark programs
+ * 
+ * Each benchmark is one file with its own main, built and run by make
+ * bench. The syscalls are counted with the syscr and syscw fields of
+ * /proc/self/io, the time with the monotonic clock.
+ */
+
+#ifndef BENCH_H
+#define BENCH_H
+
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+/*!
+ * \struct BenchIo
+ * \brief Syscall counters of the process
+ */
+typedef struct
+{
+    long long int_nb_reads;   /*!< Read syscalls (syscr) */
+    long long int_nb_writes;  /*!< Write syscalls (syscw) */
+} BenchIo;
+
+/*!
+ * \fn static inline double get_bench_time(void)
+ * \brief Reads the monotonic clock
+ * \return Time in seconds
+ */
+static inline double get_bench_time(void)
+{
+    struct timespec now;
+    
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    
+    return (now.tv_sec + now.tv_nsec * 1e-9);
+}
+
+/*!
+ * \fn static inline BenchIo get_bench_io(void)
+ * \brief Reads the syscall counters of the process
+ * \return Counters, zero if /proc/self/io cannot be read
+ * 
+ * Reading the file itself costs syscalls: get_bench_io_cost measures them.
+ */
+static inline BenchIo get_bench_io(void)
+{
+    BenchIo io;
+    char line[128];
+    int file;
+    ssize_t size_read;
+    char* field;
+    
+    memset(&io, 0, sizeof(BenchIo));
+    file = open("/proc/self/io", O_RDONLY);
+    if (file < 0)
+    {
+        return (io);
+    }
+    size_read = read(file, line, sizeof(line) - 1);
+    close(file);
+    if (size_read <= 0)
+    {
+        return (io);
+    }
+    line[size_read] = '\0';
+    
+    field = strstr(line, "syscr: ");
+    if (field != NULL)
+    {
+        sscanf(field + 7, "%lld", &io.int_nb_reads);
+    }
+    field = strstr(line, "syscw: ");
+    if (field != NULL)
+    {
+        sscanf(field + 7, "%lld", &io.int_nb_writes);
+    }
+    
+    return (io);
+}
+
+/*!
+ * \fn static inline BenchIo get_bench_io_since(BenchIo start, BenchIo cost)
+ * \brief Counts the syscalls made since a reading of the counters
+ * \param start Counters read at the start
+ * \param cost Syscalls of one reading, from get_bench_io_cost
+ * \return Syscalls made between the two readings
+ */
+static inline BenchIo get_bench_io_since(BenchIo start, BenchIo cost)
+{
+    BenchIo now;
+    
+    now = get_bench_io();
+    now.int_nb_reads -= start.int_nb_reads + cost.int_nb_reads;
+    now.int_nb_writes -= start.int_nb_writes + cost.int_nb_writes;
+    
+    return (now);
+}
+
+/*!
+ * \fn static inline BenchIo get_bench_io_cost(void)
+ * \brief Measures the syscalls made by one reading of the counters
+ * \return Syscalls of get_bench_io
+ */
+static inline BenchIo get_bench_io_cost(void)
+{
+    BenchIo zero;
+    
+    memset(&zero, 0, sizeof(BenchIo));
+    
+    return (get_bench_io_since(get_bench_io(), zero));
+}
+
+/*!
+ * \fn static inline int mute_stdout(void)
+ * \brief Sends the standard output to /dev/null, for the messages of the library
+ * \return Descriptor of the previous standard output, -1 if it cannot be muted
+ * 
+ * The benchmark must make stdout fully buffered before its first output:
+ * the messages then stay in the buffer until unmute_stdout, and do not
+ * add write syscalls to a measure.
+ */
+static inline int mute_stdout(void)
+{
+    int saved;
+    int null;
+    
+    fflush(stdout);
+    saved = dup(STDOUT_FILENO);
+    null = open("/dev/null", O_WRONLY);
+    if (saved < 0 || null < 0)
+    {
+        if (saved >= 0)
+        {
+            close(saved);
+        }
+        if (null >= 0)
+        {
+            close(null);
+        }
+        return (-1);
+    }
+    dup2(null, STDOUT_FILENO);
+    close(null);
+    
+    return (saved);
+}
+
+/*!
+ * \fn static inline void unmute_stdout(int saved)
+ * \brief Restores the standard output muted by mute_stdout
+ * \param saved Descriptor returned by mute_stdout
+ */
+static inline void unmute_stdout(int saved)
+{
+    fflush(stdout);
+    if (saved >= 0)
+    {
+        dup2(saved, STDOUT_FILENO);
+        close(saved);
+    }
+}
+
+#endif
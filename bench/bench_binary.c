@@ -0,0 +1,419 @@
+/*!
+ * \file bench_binary.c
+ * \author Akhatar Abdelhamid <abdelhamid.akhatar@etu.cyu.fr>
+ * \version 1.0
+ * \date November 2, 2025
+ * \brief Benchmark of the syscalls and throughput of the binary files
+ * 
+ * Builds a synthetic cohort of BENCH_STUDENTS students, each following
+ * the BENCH_COURSES courses with BENCH_GRADES grades, then saves and
+ * loads it BENCH_ROUNDS times:
+ * - with a copy of the legacy version 1 writer and reader, one fwrite or
+ *   fread per field, as the baseline
+ * - with write_prom_binary_v1, the single buffer of the version 1 save,
+ *   to a plain file like the baseline
+ * - with save_prom_binary_v1, which adds the temporary file, the fsync
+ *   and the rename
+ * - with the version 1 and version 2 loads of load_prom_binary
+ * Each line gives the read and write syscalls of one operation and the
+ * throughput over the size of the file.
+ */
+
+#include "bench.h"
+#include "binary.h"
+#include "init.h"
+#include "arena.h"
+#include "courseCatalog.h"
+#include "studentIndex.h"
+#include "update.h"
+#include <stdlib.h>
+#include <sys/stat.h>
+
+/*! \brief Binary file written by the benchmark */
+#define BENCH_FILE "bin/bench_binary.bin"
+
+#ifndef BENCH_STUDENTS
+/*! \brief Number of students of the synthetic cohort */
+#define BENCH_STUDENTS 20000
+#endif
+
+#ifndef BENCH_COURSES
+/*! \brief Number of courses of the synthetic cohort, all followed by every student */
+#define BENCH_COURSES 20
+#endif
+
+#ifndef BENCH_GRADES
+/*! \brief Number of grades of each course of each student */
+#define BENCH_GRADES 12
+#endif
+
+#ifndef BENCH_ROUNDS
+/*! \brief Number of times each operation is repeated */
+#define BENCH_ROUNDS 5
+#endif
+
+/*!
+ * \fn static int build_cohort(Prom* prom)
+ * \brief Fills an empty arena promotion with the synthetic cohort
+ * \param prom Pointer to the promotion
+ * \return 0 on success, -1 on allocation error
+ * 
+ * The grades are one-decimal values between 0 and 20, from a fixed seed.
+ */
+static int build_cohort(Prom* prom)
+{
+    Student student;
+    Course course;
+    char name[32];
+    float* data;
+    int i;
+    int j;
+    int k;
+    
+    srand(42);
+    for (j = 0; j < BENCH_COURSES; j++)
+    {
+        snprintf(name, sizeof(name), "Course %d", j);
+        if (intern_course(&prom->catalog, name, strlen(name), 1.0f + (j % 4) * 0.5f) != j)
+        {
+            return (-1);
+        }
+    }
+    if (reserve_prom_students(prom, BENCH_STUDENTS) != 0)
+    {
+        return (-1);
+    }
+    
+    for (i = 0; i < BENCH_STUDENTS; i++)
+    {
+        memset(&student, 0, sizeof(Student));
+        student.int_id = 100000000 + i;
+        student.int_age = 17 + i % 8;
+        snprintf(name, sizeof(name), "First%d", i);
+        student.char_first_name = arena_strdup(prom->arena_memory, name);
+        snprintf(name, sizeof(name), "Last%d", i);
+        student.char_last_name = arena_strdup(prom->arena_memory, name);
+        if (student.char_first_name == NULL || student.char_last_name == NULL
+            || reserve_student_courses_in(prom->arena_memory, &student, BENCH_COURSES) != 0)
+        {
+            return (-1);
+        }
+        
+        for (j = 0; j < BENCH_COURSES; j++)
+        {
+            memset(&course, 0, sizeof(Course));
+            course.int_course_id = j;
+            course.grades = create_grades_in(prom->arena_memory, BENCH_GRADES);
+            if (course.grades.int_nb_grades != BENCH_GRADES)
+            {
+                return (-1);
+            }
+            data = get_grades_data(&course.grades);
+            for (k = 0; k < BENCH_GRADES; k++)
+            {
+                data[k] = (float)(rand() % 201) / 10.0f;
+            }
+            if (push_student_course_in(prom->arena_memory, &student, course) != 0)
+            {
+                return (-1);
+            }
+        }
+        if (push_prom_student(prom, student) != 0)
+        {
+            return (-1);
+        }
+    }
+    
+    build_student_index(prom);
+    update_course_average(prom);
+    update_student_average(prom);
+    
+    return (0);
+}
+
+/*!
+ * \fn static int save_legacy_v1(const char* str_filename, Prom* prom)
+ * \brief Legacy version 1 writer, one fwrite per field, kept as the baseline
+ * \param str_filename Name of the destination binary file
+ * \param prom Pointer to the Prom structure to save
+ * \return 0 if success, -1 in case of error
+ */
+static int save_legacy_v1(const char* str_filename, Prom* prom)
+{
+    FILE* file;
+    int i;
+    int j;
+    int str_len;
+    
+    file = fopen(str_filename, "wb");
+    if (file == NULL)
+    {
+        return (-1);
+    }
+    
+    fwrite(&prom->int_nb_students, sizeof(int), 1, file);
+    for (i = 0; i < prom->int_nb_students; i++)
+    {
+        Student* student = &prom->student_students[i];
+        
+        fwrite(&student->int_id, sizeof(int), 1, file);
+        fwrite(&student->int_age, sizeof(int), 1, file);
+        fwrite(&student->float_average, sizeof(float), 1, file);
+        fwrite(&student->int_nb_courses, sizeof(int), 1, file);
+        str_len = strlen(student->char_last_name) + 1;
+        fwrite(&str_len, sizeof(int), 1, file);
+        fwrite(student->char_last_name, sizeof(char), str_len, file);
+        str_len = strlen(student->char_first_name) + 1;
+        fwrite(&str_len, sizeof(int), 1, file);
+        fwrite(student->char_first_name, sizeof(char), str_len, file);
+        
+        for (j = 0; j < student->int_nb_courses; j++)
+        {
+            Course* course = &student->course_courses[j];
+            CourseInfo* info = &prom->catalog.info_courses[course->int_course_id];
+            
+            fwrite(&info->float_coef, sizeof(float), 1, file);
+            fwrite(&course->float_average, sizeof(float), 1, file);
+            str_len = strlen(info->char_course_name) + 1;
+            fwrite(&str_len, sizeof(int), 1, file);
+            fwrite(info->char_course_name, sizeof(char), str_len, file);
+            fwrite(&course->grades.int_nb_grades, sizeof(int), 1, file);
+            if (course->grades.int_nb_grades > 0)
+            {
+                fwrite(get_grades_data(&course->grades), sizeof(float), course->grades.int_nb_grades, file);
+            }
+        }
+    }
+    
+    return (fclose(file) == 0 ? 0 : -1);
+}
+
+/*!
+ * \fn static Prom load_legacy_v1(const char* str_filename)
+ * \brief Legacy version 1 reader, one fread per field, kept as the baseline
+ * \param str_filename Name of the source binary file
+ * \return Restored Prom structure, or empty structure in case of error
+ * 
+ * As the legacy reader, it trusts the file: it only runs on the file
+ * written just before.
+ */
+static Prom load_legacy_v1(const char* str_filename)
+{
+    FILE* file;
+    Prom prom;
+    int i;
+    int j;
+    int str_len;
+    int nb_grades;
+    float coef;
+    char buffer[256];
+    
+    prom = create_arena_prom(0);
+    file = fopen(str_filename, "rb");
+    if (file == NULL)
+    {
+        return (prom);
+    }
+    
+    fread(&prom.int_nb_students, sizeof(int), 1, file);
+    free(prom.student_students);
+    prom.student_students = (Student*)calloc(prom.int_nb_students, sizeof(Student));
+    prom.int_max_students = prom.int_nb_students;
+    if (prom.student_students == NULL)
+    {
+        fclose(file);
+        prom.int_nb_students = 0;
+        prom.int_max_students = 0;
+        return (prom);
+    }
+    
+    for (i = 0; i < prom.int_nb_students; i++)
+    {
+        Student* student = &prom.student_students[i];
+        
+        fread(&student->int_id, sizeof(int), 1, file);
+        fread(&student->int_age, sizeof(int), 1, file);
+        fread(&student->float_average, sizeof(float), 1, file);
+        fread(&student->int_nb_courses, sizeof(int), 1, file);
+        fread(&str_len, sizeof(int), 1, file);
+        fread(buffer, sizeof(char), str_len, file);
+        student->char_last_name = arena_strdup(prom.arena_memory, buffer);
+        fread(&str_len, sizeof(int), 1, file);
+        fread(buffer, sizeof(char), str_len, file);
+        student->char_first_name = arena_strdup(prom.arena_memory, buffer);
+        student->course_courses = (Course*)arena_grow(prom.arena_memory, NULL, 0, student->int_nb_courses * sizeof(Course));
+        student->int_max_courses = student->int_nb_courses;
+        
+        for (j = 0; j < student->int_nb_courses; j++)
+        {
+            Course* course = &student->course_courses[j];
+            
+            fread(&coef, sizeof(float), 1, file);
+            fread(&course->float_average, sizeof(float), 1, file);
+            fread(&str_len, sizeof(int), 1, file);
+            fread(buffer, sizeof(char), str_len, file);
+            course->int_course_id = intern_course(&prom.catalog, buffer, strlen(buffer), coef);
+            fread(&nb_grades, sizeof(int), 1, file);
+            course->grades = create_grades_in(prom.arena_memory, nb_grades);
+            fread(get_grades_data(&course->grades), sizeof(float), course->grades.int_nb_grades, file);
+        }
+    }
+    fclose(file);
+    build_student_index(&prom);
+    
+    return (prom);
+}
+
+/*!
+ * \fn static int write_single_buffer_v1(const char* str_filename, Prom* prom)
+ * \brief Writes a version 1 file with write_prom_binary_v1 to a plain unbuffered file, as save_prom_binary_v1 does before its sync and rename
+ * \param str_filename Name of the destination binary file
+ * \param prom Pointer to the Prom structure to save
+ * \return 0 if success, -1 in case of error
+ */
+static int write_single_buffer_v1(const char* str_filename, Prom* prom)
+{
+    FILE* file;
+    int result;
+    
+    file = fopen(str_filename, "wb");
+    if (file == NULL)
+    {
+        return (-1);
+    }
+    setvbuf(file, NULL, _IONBF, 0);
+    result = write_prom_binary_v1(file, prom, 1);
+    if (fclose(file) != 0)
+    {
+        result = -1;
+    }
+    
+    return (result);
+}
+
+/*!
+ * \fn static void print_measure(const char* str_name, int int_failed, BenchIo used, double float_time)
+ * \brief Displays the syscalls of one operation and the throughput over the size of the test file
+ * \param str_name Name of the operation
+ * \param int_failed Nonzero if one of the rounds failed
+ * \param used Syscalls of all the rounds
+ * \param float_time Time of all the rounds (seconds)
+ */
+static void print_measure(const char* str_name, int int_failed, BenchIo used, double float_time)
+{
+    struct stat info;
+    
+    if (int_failed != 0 || stat(BENCH_FILE, &info) != 0)
+    {
+        printf("%-14s failed\n", str_name);
+        return;
+    }
+    printf("%-14s %10.1f reads %10.1f writes %10.1f MB/s\n", str_name,
+           (double)used.int_nb_reads / BENCH_ROUNDS, (double)used.int_nb_writes / BENCH_ROUNDS,
+           (double)info.st_size * BENCH_ROUNDS / float_time / 1e6);
+}
+
+/*!
+ * \fn static void run_save(const char* str_name, int (*save)(const char*, Prom*), Prom* prom)
+ * \brief Measures the save of a promotion
+ * \param str_name Name of the operation
+ * \param save Save function
+ * \param prom Pointer to the promotion to save
+ */
+static void run_save(const char* str_name, int (*save)(const char*, Prom*), Prom* prom)
+{
+    BenchIo cost;
+    BenchIo start;
+    BenchIo used;
+    double float_start;
+    double float_time;
+    int int_failed;
+    int saved;
+    int i;
+    
+    int_failed = 0;
+    cost = get_bench_io_cost();
+    saved = mute_stdout();
+    start = get_bench_io();
+    float_start = get_bench_time();
+    for (i = 0; i < BENCH_ROUNDS; i++)
+    {
+        int_failed |= save(BENCH_FILE, prom);
+    }
+    float_time = get_bench_time() - float_start;
+    used = get_bench_io_since(start, cost);
+    unmute_stdout(saved);
+    
+    print_measure(str_name, int_failed, used, float_time);
+}
+
+/*!
+ * \fn static void run_load(const char* str_name, Prom (*load)(const char*), int int_nb_students)
+ * \brief Measures the load of the file written by the last run_save
+ * \param str_name Name of the operation
+ * \param load Load function
+ * \param int_nb_students Number of students the file holds
+ */
+static void run_load(const char* str_name, Prom (*load)(const char*), int int_nb_students)
+{
+    BenchIo cost;
+    BenchIo start;
+    BenchIo used;
+    Prom prom;
+    double float_start;
+    double float_time;
+    int int_failed;
+    int saved;
+    int i;
+    
+    int_failed = 0;
+    cost = get_bench_io_cost();
+    saved = mute_stdout();
+    start = get_bench_io();
+    float_start = get_bench_time();
+    for (i = 0; i < BENCH_ROUNDS; i++)
+    {
+        prom = load(BENCH_FILE);
+        int_failed |= (prom.int_nb_students != int_nb_students);
+        destroy_prom(&prom);
+    }
+    float_time = get_bench_time() - float_start;
+    used = get_bench_io_since(start, cost);
+    unmute_stdout(saved);
+    
+    print_measure(str_name, int_failed, used, float_time);
+}
+
+/*!
+ * \fn int main(void)
+ * \brief Runs the binary file benchmark
+ * \return 0 if success, 1 if the cohort cannot be built
+ */
+int main(void)
+{
+    Prom prom;
+    
+    setvbuf(stdout, NULL, _IOFBF, BUFSIZ);
+    prom = create_arena_prom(0);
+    if (build_cohort(&prom) != 0)
+    {
+        printf("bench_binary: cannot build the synthetic cohort\n");
+        destroy_prom(&prom);
+        return (1);
+    }
+    
+    printf("bench_binary: %d students x %d courses x %d grades, %d rounds per operation\n",
+           BENCH_STUDENTS, BENCH_COURSES, BENCH_GRADES, BENCH_ROUNDS);
+    run_save("legacy save v1", save_legacy_v1, &prom);
+    run_load("legacy load v1", load_legacy_v1, prom.int_nb_students);
+    run_save("write v1", write_single_buffer_v1, &prom);
+    run_save("save v1", save_prom_binary_v1, &prom);
+    run_load("load v1", load_prom_binary, prom.int_nb_students);
+    run_save("save v2", save_prom_binary, &prom);
+    run_load("load v2", load_prom_binary, prom.int_nb_students);
+    
+    destroy_prom(&prom);
+    remove(BENCH_FILE);
+    
+    return (0);
+}
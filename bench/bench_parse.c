@@ -0,0 +1,224 @@
+/*!
+ * \file bench_parse.c
+ * \author Akhatar Abdelhamid <abdelhamid.akhatar@etu.cyu.fr>
+ * \version 1.0
+ * \date November 2, 2025
+ * \brief Benchmark of sscanf against the field tokenizer on the grade lines
+ * 
+ * Reads the NOTES section of data.txt and parses its lines BENCH_ROUNDS
+ * times with sscanf, as the loader did before the tokenizer, then with
+ * parse_grade_view. Each line gives the time per line; the lines whose
+ * fields differ between the two parsers are counted.
+ */
+
+#include "bench.h"
+#include "read.h"
+#include "fieldParser.h"
+#include <stdlib.h>
+
+/*! \brief Data file of the benchmark */
+#define BENCH_DATA "data.txt"
+
+#ifndef BENCH_ROUNDS
+/*! \brief Number of times the section is parsed */
+#define BENCH_ROUNDS 100
+#endif
+
+/*! \brief Largest course name read by sscanf (bytes) */
+#define BENCH_NAME_SIZE 64
+
+/*!
+ * \struct BenchLines
+ * \brief Lines of the NOTES section, each ending with a NUL instead of its newline
+ */
+typedef struct
+{
+    char* char_data;          /*!< Content of the data file */
+    char** str_lines;         /*!< First character of each line */
+    size_t* size_lines;       /*!< Length of each line */
+    int int_nb_lines;         /*!< Number of lines */
+} BenchLines;
+
+/*!
+ * \fn static int read_grade_lines(BenchLines* lines)
+ * \brief Reads the data lines of the NOTES section of the data file
+ * \param lines Pointer to the lines to fill
+ * \return 0 on success, -1 if the file or its section cannot be read
+ */
+static int read_grade_lines(BenchLines* lines)
+{
+    FILE* file;
+    char* text;
+    char* newline;
+    long size_file;
+    int int_max_lines;
+    
+    memset(lines, 0, sizeof(BenchLines));
+    file = fopen(BENCH_DATA, "rb");
+    if (file == NULL)
+    {
+        return (-1);
+    }
+    fseek(file, 0, SEEK_END);
+    size_file = ftell(file);
+    fseek(file, 0, SEEK_SET);
+    lines->char_data = (char*)malloc(size_file + 1);
+    if (lines->char_data == NULL || fread(lines->char_data, 1, size_file, file) != (size_t)size_file)
+    {
+        fclose(file);
+        return (-1);
+    }
+    fclose(file);
+    lines->char_data[size_file] = '\0';
+    
+    /* The data lines follow the section name and the column names */
+    text = strstr(lines->char_data, "NOTES\n");
+    if (text == NULL || (text = strchr(text + 6, '\n')) == NULL)
+    {
+        return (-1);
+    }
+    text++;
+    
+    int_max_lines = 1;
+    for (newline = text; (newline = strchr(newline, '\n')) != NULL; newline++)
+    {
+        int_max_lines++;
+    }
+    lines->str_lines = (char**)malloc(int_max_lines * sizeof(char*));
+    lines->size_lines = (size_t*)malloc(int_max_lines * sizeof(size_t));
+    if (lines->str_lines == NULL || lines->size_lines == NULL)
+    {
+        return (-1);
+    }
+    while (*text != '\0' && *text != '\n')
+    {
+        newline = strchr(text, '\n');
+        if (newline == NULL)
+        {
+            newline = text + strlen(text);
+        }
+        lines->str_lines[lines->int_nb_lines] = text;
+        lines->size_lines[lines->int_nb_lines] = newline - text;
+        lines->int_nb_lines++;
+        text = (*newline == '\n' ? newline + 1 : newline);
+        *newline = '\0';
+    }
+    
+    return (0);
+}
+
+/*!
+ * \fn static void free_grade_lines(BenchLines* lines)
+ * \brief Frees the lines read by read_grade_lines
+ * \param lines Pointer to the lines
+ */
+static void free_grade_lines(BenchLines* lines)
+{
+    free(lines->char_data);
+    free(lines->str_lines);
+    free(lines->size_lines);
+}
+
+/*!
+ * \fn static int count_differences(const BenchLines* lines)
+ * \brief Counts the lines that sscanf and the tokenizer read differently
+ * \param lines Pointer to the lines
+ * \return Number of lines accepted by only one parser or with different fields
+ */
+static int count_differences(const BenchLines* lines)
+{
+    char name[BENCH_NAME_SIZE];
+    const char* course_name;
+    size_t size_course_len;
+    int int_nb_differences;
+    int scanned_id;
+    int id;
+    float scanned_grade;
+    float grade;
+    int int_scanned;
+    int int_parsed;
+    int i;
+    
+    int_nb_differences = 0;
+    for (i = 0; i < lines->int_nb_lines; i++)
+    {
+        int_scanned = (sscanf(lines->str_lines[i], "%d;%63[^;];%f", &scanned_id, name, &scanned_grade) == 3);
+        int_parsed = (parse_grade_view(lines->str_lines[i], lines->size_lines[i], &id, &course_name,
+                                       &size_course_len, &grade) == PARSE_OK);
+        if (int_scanned != int_parsed
+            || (int_parsed && (scanned_id != id || scanned_grade != grade || strlen(name) != size_course_len
+                               || memcmp(name, course_name, size_course_len) != 0)))
+        {
+            int_nb_differences++;
+        }
+    }
+    
+    return (int_nb_differences);
+}
+
+/*!
+ * \fn int main(void)
+ * \brief Runs the parsing benchmark
+ * \return 0 if success, 1 if the data file cannot be read
+ */
+int main(void)
+{
+    BenchLines lines;
+    char name[BENCH_NAME_SIZE];
+    const char* course_name;
+    size_t size_course_len;
+    double float_start;
+    double float_scanf;
+    double float_tokenizer;
+    double float_sum;
+    int id;
+    float grade;
+    int round;
+    int i;
+    
+    if (read_grade_lines(&lines) != 0 || lines.int_nb_lines == 0)
+    {
+        printf("bench_parse: cannot read the NOTES section of %s\n", BENCH_DATA);
+        free_grade_lines(&lines);
+        return (1);
+    }
+    
+    /* The sums keep the parsed fields alive */
+    float_sum = 0.0;
+    float_start = get_bench_time();
+    for (round = 0; round < BENCH_ROUNDS; round++)
+    {
+        for (i = 0; i < lines.int_nb_lines; i++)
+        {
+            if (sscanf(lines.str_lines[i], "%d;%63[^;];%f", &id, name, &grade) == 3)
+            {
+                float_sum += grade + id + name[0];
+            }
+        }
+    }
+    float_scanf = get_bench_time() - float_start;
+    
+    float_start = get_bench_time();
+    for (round = 0; round < BENCH_ROUNDS; round++)
+    {
+        for (i = 0; i < lines.int_nb_lines; i++)
+        {
+            if (parse_grade_view(lines.str_lines[i], lines.size_lines[i], &id, &course_name, &size_course_len,
+                                 &grade) == PARSE_OK)
+            {
+                float_sum -= grade + id + course_name[0];
+            }
+        }
+    }
+    float_tokenizer = get_bench_time() - float_start;
+    
+    printf("bench_parse: %d grade lines, %d rounds (checksum %g)\n", lines.int_nb_lines, BENCH_ROUNDS, float_sum);
+    printf("sscanf    %8.1f ns/line\n", float_scanf * 1e9 / ((double)lines.int_nb_lines * BENCH_ROUNDS));
+    printf("tokenizer %8.1f ns/line  (%.1fx)\n", float_tokenizer * 1e9 / ((double)lines.int_nb_lines * BENCH_ROUNDS),
+           float_scanf / float_tokenizer);
+    printf("lines read differently: %d\n", count_differences(&lines));
+    
+    free_grade_lines(&lines);
+    
+    return (0);
+}
@@ -0,0 +1,141 @@
+/*!
+ * \file arena.h
+ * \author Akhatar Abdelhamid <abdelhamid.akhatar@etu.cyu.fr>
+ * \version 1.0
+ * \date November 2, 2025
+ * \brief Interface for the arena allocator module
+ * 
+ * This file contains the prototypes of a region allocator: memory is carved
+ * out of large blocks and only given back to the system when the whole arena
+ * is destroyed. Every function also accepts a NULL arena, in which case it
+ * falls back to malloc, realloc and free.
+ */
+
+#include "structures.h"
+#include <stddef.h>
+
+#ifndef ARENA_H
+#define ARENA_H
+
+#ifndef ARENA_BLOCK_SIZE
+/*! \brief Default size of the blocks of an arena (bytes) */
+#define ARENA_BLOCK_SIZE (1 << 20)
+#endif
+
+/*! \brief Alignment of the allocations of an arena (bytes) */
+#define ARENA_ALIGNMENT 8
+
+/*! \brief Smallest size class of the growable arrays of an arena (bytes) */
+#define ARENA_MIN_ARRAY 16
+
+/*!
+ * \struct ArenaBlock
+ * \brief Block of memory of an arena (defined in arena.c)
+ */
+typedef struct ArenaBlock ArenaBlock;
+
+/*!
+ * \struct Arena
+ * \brief Region allocator
+ */
+struct Arena
+{
+    ArenaBlock* block_head;   /*!< Block being filled, followed by the full blocks */
+    size_t size_block;        /*!< Size of a regular block */
+    size_t size_reserved;     /*!< Bytes obtained from the system */
+    size_t size_used;         /*!< Bytes handed out, padding included */
+    size_t size_released;     /*!< Bytes handed out then given back (not reusable) */
+    int int_nb_blocks;        /*!< Number of blocks */
+};
+
+/*!
+ * \struct ArenaStats
+ * \brief Statistics of an arena
+ */
+typedef struct
+{
+    size_t size_reserved;     /*!< Bytes obtained from the system */
+    size_t size_used;         /*!< Bytes handed out and still in use */
+    size_t size_wasted;       /*!< Bytes given back plus the unused ends of the full blocks */
+    int int_nb_blocks;        /*!< Number of blocks */
+} ArenaStats;
+
+/*!
+ * \fn Arena* create_arena(size_t size_block)
+ * \brief Creates an empty arena
+ * \param size_block Size of a regular block (0: ARENA_BLOCK_SIZE)
+ * \return Pointer to the arena, or NULL on allocation error
+ */
+Arena* create_arena(size_t size_block);
+
+/*!
+ * \fn void destroy_arena(Arena* arena)
+ * \brief Frees all the blocks of an arena at once
+ * \param arena Pointer to the arena (may be NULL)
+ */
+void destroy_arena(Arena* arena);
+
+/*!
+ * \fn void* arena_alloc(Arena* arena, size_t size)
+ * \brief Allocates memory in an arena
+ * \param arena Pointer to the arena (NULL: malloc)
+ * \param size Number of bytes
+ * \return Pointer to the memory, or NULL on allocation error
+ */
+void* arena_alloc(Arena* arena, size_t size);
+
+/*!
+ * \fn char* arena_strdup(Arena* arena, const char* str)
+ * \brief Duplicates a string in an arena
+ * \param arena Pointer to the arena (NULL: strdup)
+ * \param str String to duplicate
+ * \return Pointer to the copy, or NULL on allocation error
+ * \pre str != NULL
+ */
+char* arena_strdup(Arena* arena, const char* str);
+
+/*!
+ * \fn char* arena_strndup(Arena* arena, const char* text, size_t size_len)
+ * \brief Copies a string view to a NUL-terminated string in an arena
+ * \param arena Pointer to the arena (NULL: malloc)
+ * \param text First character of the view (not necessarily NUL-terminated)
+ * \param size_len Number of characters of the view
+ * \return Pointer to the copy, or NULL on allocation error
+ * \pre text != NULL
+ */
+char* arena_strndup(Arena* arena, const char* text, size_t size_len);
+
+/*!
+ * \fn void arena_free(Arena* arena, void* ptr, size_t size)
+ * \brief Gives back memory allocated by arena_alloc or arena_strdup
+ * \param arena Pointer to the arena (NULL: free)
+ * \param ptr Pointer to the memory (may be NULL)
+ * \param size Number of bytes allocated
+ * 
+ * The memory of an arena is only counted as released, it is reused once the arena is destroyed.
+ */
+void arena_free(Arena* arena, void* ptr, size_t size);
+
+/*!
+ * \fn void* arena_grow(Arena* arena, void* ptr, size_t size_old, size_t size_new)
+ * \brief Resizes a growable array of an arena
+ * \param arena Pointer to the arena (NULL: realloc, or free when size_new is 0)
+ * \param ptr Pointer to the array, NULL or allocated by arena_grow in the same arena
+ * \param size_old Current size of the array (bytes)
+ * \param size_new New size of the array (bytes, 0 releases the array)
+ * \return Pointer to the array (NULL when released or on allocation error, the old array being kept)
+ * 
+ * Arrays of an arena are allocated in power-of-two size classes, so that
+ * an array growing one element at a time is only moved when its class is full.
+ */
+void* arena_grow(Arena* arena, void* ptr, size_t size_old, size_t size_new);
+
+/*!
+ * \fn ArenaStats get_arena_stats(const Arena* arena)
+ * \brief Returns the statistics of an arena
+ * \param arena Pointer to the arena (NULL: all statistics are 0)
+ * \return Statistics of the arena
+ */
+ArenaStats get_arena_stats(const Arena* arena);
+
+#endif
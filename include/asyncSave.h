@@ -0,0 +1,69 @@
+/*!
+ * \file asyncSave.h
+ * \author Akhatar Abdelhamid <abdelhamid.akhatar@etu.cyu.fr>
+ * \version 1.0
+ * \date November 2, 2025
+ * \brief Interface for the background save module
+ * 
+ * This file contains the prototypes of functions saving a promotion to a
+ * version 2 binary file on a background thread. The promotion is first
+ * encoded to memory, which gives a consistent snapshot: as soon as the
+ * save is started, the promotion may be read, modified or destroyed while
+ * the snapshot goes to disk.
+ * 
+ * The snapshot is not free: the calling thread pays a full serialization
+ * of the promotion (the same work as a synchronous save, without the
+ * syscalls), and a second full copy of the file stays in memory until the
+ * background thread has written it. Only the disk writes, the sync and
+ * the rename are taken off the caller.
+ * 
+ * The file is written to a temporary file in the same directory, synced,
+ * then renamed over the destination, and the directory is synced too:
+ * readers see the old file or the new one, never a partial one.
+ */
+
+#ifndef ASYNCSAVE_H
+#define ASYNCSAVE_H
+
+#include "structures.h"
+
+/*!
+ * \typedef AsyncSave
+ * \brief Opaque background save structure
+ */
+typedef struct AsyncSave AsyncSave;
+
+/*!
+ * \fn AsyncSave* start_save_prom_binary(const char* str_filename, Prom* prom, int int_compact)
+ * \brief Takes a snapshot of a promotion and starts writing it on a background thread
+ * \param str_filename Name of the destination binary file
+ * \param prom Pointer to the Prom structure to save
+ * \param int_compact 1 for a compact version 2 file, 0 for a plain one
+ * \return Pointer to the save, to end with wait_async_save, or NULL if the snapshot or the thread cannot be created
+ * \pre str_filename != NULL
+ * \pre prom != NULL
+ * 
+ * The snapshot costs a full serialization of the promotion on the calling
+ * thread and a buffer as large as the file, freed once it is on disk.
+ */
+AsyncSave* start_save_prom_binary(const char* str_filename, Prom* prom, int int_compact);
+
+/*!
+ * \fn int is_async_save_done(const AsyncSave* save)
+ * \brief Tells whether a background save is finished, without waiting
+ * \param save Pointer to the save
+ * \return 1 if the file is written (or the save failed), 0 if it is still running
+ * \pre save != NULL
+ */
+int is_async_save_done(const AsyncSave* save);
+
+/*!
+ * \fn int wait_async_save(AsyncSave* save)
+ * \brief Waits for the end of a background save and frees it
+ * \param save Pointer to the save
+ * \return 0 if the file was replaced, -1 in case of error (the old file is then left as is)
+ * \pre save != NULL
+ */
+int wait_async_save(AsyncSave* save);
+
+#endif
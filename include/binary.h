@@ -13,10 +13,122 @@
 #define BINARY_H
 
 #include "init.h"
+#include "binaryFormat.h"
+#include <stdio.h>
 
 /*!
  * \fn int save_prom_binary(const char* str_filename, Prom* prom)
- * \brief Saves a complete promotion to a binary file
+ * \brief Saves a complete promotion to a version 2 binary file
+ * \param str_filename Name of the destination binary file
+ * \param prom Pointer to the Prom structure to save
+ * \return 0 on success, -1 on error
+ * \pre str_filename != NULL
+ * \pre prom != NULL
+ * 
+ * The layout of the file is described in binaryFormat.h. Like every save
+ * of this module, the file is written to "<name>.tmp", synced and renamed
+ * over the old one: a promotion mapped from the old file can be saved
+ * back to its own name, and a failed save leaves the old file as is.
+ */
+int save_prom_binary(const char* str_filename, Prom* prom);
+
+/*!
+ * \fn FILE* open_replacement(const char* str_filename, char** str_temporary)
+ * \brief Opens the temporary file "<name>.tmp" receiving the new content of a file
+ * \param str_filename Name of the file to replace
+ * \param str_temporary Pointer receiving the name of the temporary file, to give to close_replacement
+ * \return Temporary file opened in binary write mode, or NULL in case of error
+ * \pre str_filename != NULL
+ * \pre str_temporary != NULL
+ */
+FILE* open_replacement(const char* str_filename, char** str_temporary);
+
+/*!
+ * \fn int close_replacement(FILE* file, char* str_temporary, const char* str_filename, int result)
+ * \brief Syncs and closes a temporary file, then renames it over the file it replaces
+ * \param file Temporary file opened by open_replacement
+ * \param str_temporary Name of the temporary file, freed
+ * \param str_filename Name of the file to replace
+ * \param result 0 if the content was written, -1 to drop the temporary file
+ * \return 0 on success, -1 in case of error (the old file is then left as is,
+ *         unless only the sync of the directory failed)
+ * \pre file != NULL
+ * 
+ * The directory is synced after the rename, so that the new name survives a crash.
+ */
+int close_replacement(FILE* file, char* str_temporary, const char* str_filename, int result);
+
+/*!
+ * \fn int sync_parent_directory(const char* str_filename)
+ * \brief Syncs the directory of a file, so that a rename to its name is on disk
+ * \param str_filename Name of the file
+ * \return 0 on success, -1 in case of error
+ * \pre str_filename != NULL
+ */
+int sync_parent_directory(const char* str_filename);
+
+/*!
+ * \fn int write_prom_binary(FILE* file, Prom* prom)
+ * \brief Writes a complete promotion as a version 2 binary file
+ * \param file Destination file, opened in binary write mode
+ * \param prom Pointer to the Prom structure to save
+ * \return 0 on success, -1 on error
+ * \pre file != NULL
+ * \pre prom != NULL
+ * 
+ * Layout written by save_prom_binary, to any stream (e.g. a memory stream).
+ */
+int write_prom_binary(FILE* file, Prom* prom);
+
+/*!
+ * \fn int write_prom_binary_compact(FILE* file, Prom* prom)
+ * \brief Writes a complete promotion as a compact version 2 binary file
+ * \param file Destination file, opened in binary write mode
+ * \param prom Pointer to the Prom structure to save
+ * \return 0 on success, -1 on error
+ * \pre file != NULL
+ * \pre prom != NULL
+ * 
+ * Layout written by save_prom_binary_compact, to any stream.
+ */
+int write_prom_binary_compact(FILE* file, Prom* prom);
+
+/*!
+ * \fn int save_prom_binary_compact(const char* str_filename, Prom* prom)
+ * \brief Saves a complete promotion to a compact version 2 binary file
+ * \param str_filename Name of the destination binary file
+ * \param prom Pointer to the Prom structure to save
+ * \return 0 on success, -1 on error
+ * \pre str_filename != NULL
+ * \pre prom != NULL
+ * 
+ * The grades are stored as fixed-point numbers on 1 or 2 bytes and the
+ * courses as varints; the course averages are not stored (see
+ * binaryFormat.h). A compact file is read back with the same grades, bit
+ * for bit, and averages recomputed from them. If a grade has no exact
+ * one-decimal form, a plain file is written instead.
+ */
+int save_prom_binary_compact(const char* str_filename, Prom* prom);
+
+/*!
+ * \fn int write_prom_binary_v1(FILE* file, Prom* prom, int int_header)
+ * \brief Writes a promotion in the version 1 layout to an open file
+ * \param file Destination file
+ * \param prom Pointer to the Prom structure to save
+ * \param int_header 1 to start with the number of students, 0 for the student records only
+ * \return 0 on success, -1 on error
+ * \pre file != NULL
+ * \pre prom != NULL
+ * 
+ * The records are built in one buffer and written with a single fwrite.
+ * Without the header, the records of several promotions can follow one
+ * another after a number of students written by the caller.
+ */
+int write_prom_binary_v1(FILE* file, Prom* prom, int int_header);
+
+/*!
+ * \fn int save_prom_binary_v1(const char* str_filename, Prom* prom)
+ * \brief Saves a complete promotion to a version 1 binary file
  * \param str_filename Name of the destination binary file
  * \param prom Pointer to the Prom structure to save
  * \return 0 on success, -1 on error
@@ -28,7 +140,71 @@
  * - For each student: ID, last name, first name, age, number of courses, average
  * - For each course of each student: name, coefficient, average, number of grades, grades
  */
-int save_prom_binary(const char* str_filename, Prom* prom);
+int save_prom_binary_v1(const char* str_filename, Prom* prom);
+
+/*!
+ * \fn int load_image_catalog(const PromImage* image, Prom* prom)
+ * \brief Fills the empty catalog of a promotion with the courses of a located image
+ * \param image Pointer to the view of the file
+ * \param prom Pointer to the Prom structure
+ * \return 0 on success, -1 on duplicated name or allocation error
+ * \pre image != NULL
+ * \pre prom != NULL
+ * 
+ * The ID of each course is its index in the file.
+ */
+int load_image_catalog(const PromImage* image, Prom* prom);
+
+/*!
+ * \fn void read_image_courses(const PromImage* image, int int_student, Course* courses)
+ * \brief Fills the courses of one student from a checked image
+ * \param image Pointer to the view of the file
+ * \param int_student Index of the student record
+ * \param courses Array of at least as many courses as the student follows
+ * \pre image != NULL
+ * \pre courses != NULL
+ * 
+ * The grades of the courses are not copied: they point into the image.
+ */
+void read_image_courses(const PromImage* image, int int_student, Course* courses);
+
+/*!
+ * \fn GradeStore* create_image_store(const PromImage* image)
+ * \brief Creates a columnar store borrowing the grades and the offset tables of a checked image
+ * \param image Pointer to the view of the file
+ * \return Pointer to the store (int_borrowed set), or NULL on allocation error
+ * \pre image != NULL
+ */
+GradeStore* create_image_store(const PromImage* image);
+
+/*!
+ * \fn int load_prom_image(const PromImage* image, Prom* prom)
+ * \brief Fills an empty promotion from a checked version 2 image, in place
+ * \param image Pointer to the view of the file
+ * \param prom Pointer to an empty promotion created by create_arena_prom
+ * \return 0 on success, -1 on error
+ * \pre image != NULL
+ * \pre prom != NULL
+ * 
+ * Names and grades are not copied: they point into the image, whose data
+ * must outlive the promotion. The grades form a GradeStore borrowing the
+ * grades block and the offset tables of the image.
+ */
+int load_prom_image(const PromImage* image, Prom* prom);
+
+/*!
+ * \fn int load_prom_compact(const PromImage* image, Prom* prom)
+ * \brief Fills an empty promotion from a located compact image
+ * \param image Pointer to the view of the file (see locate_compact_image)
+ * \param prom Pointer to an empty promotion created by create_arena_prom
+ * \return 0 on success, -1 on invalid data or allocation error
+ * \pre image != NULL
+ * \pre prom != NULL
+ * 
+ * Names point into the image, whose data must outlive the promotion. The
+ * grades are unpacked into a GradeStore and all averages are recomputed.
+ */
+int load_prom_compact(const PromImage* image, Prom* prom);
 
 /*!
  * \fn Prom load_prom_binary(const char* str_filename)
@@ -37,7 +213,12 @@ int save_prom_binary(const char* str_filename, Prom* prom);
  * \return Restored Prom structure, or empty structure on error
  * \pre str_filename != NULL
  * 
- * This function reads the binary file and reconstructs in memory:
+ * A version 2 file is mapped and used in place: the promotion keeps the
+ * mapping, its names and grades point into it and no record is parsed.
+ * A compact version 2 file is mapped too, but its courses and grades are decoded.
+ * A packed file (see packedFile.h) is decompressed in memory, then used
+ * as the version 2 file it holds.
+ * A version 1 file is read and reconstructed in memory:
  * - All students with their information
  * - All courses of each student
  * - All grades of each course
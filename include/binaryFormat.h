@@ -0,0 +1,317 @@
+/*!
+ * \file binaryFormat.h
+ * \author Akhatar Abdelhamid <abdelhamid.akhatar@etu.cyu.fr>
+ * \version 1.0
+ * \date November 2, 2025
+ * \brief Layout of the version 2 binary file of a promotion
+ * 
+ * A version 2 file starts with a BinHeader followed by a table of
+ * BinSection entries. Each section starts on a BIN_SECTION_ALIGNMENT
+ * boundary and holds an array of fixed-size records, so that a mapped
+ * file can be used in place without parsing:
+ * - BIN_SECTION_CATALOG: one BinCatalogRecord per course of the catalog
+ * - BIN_SECTION_STUDENTS: one BinStudentRecord per student
+ * - BIN_SECTION_STUDENT_OFFSETS: first course slot of each student (nb_students + 1 int32)
+ * - BIN_SECTION_COURSES: one BinCourseRecord per course slot, student by student
+ * - BIN_SECTION_COURSE_OFFSETS: first grade of each course slot (nb_slots + 1 int32)
+ * - BIN_SECTION_GRADES: all the grades (float), course slot by course slot
+ * - BIN_SECTION_STRINGS: NUL-terminated names referenced by offset
+ * - BIN_SECTION_STUDENT_INDEX (optional): one BinIndexEntry per student,
+ *   by increasing identifier, giving the file offset of its record
+ * 
+ * The offset sections and the grades block have the layout of a GradeStore.
+ * 
+ * A compact file (BIN_FLAG_COMPACT) cannot be used in place: it keeps the
+ * catalog, student, string and index sections, but replaces the four
+ * course and grade sections by:
+ * - BIN_SECTION_COURSE_STREAM: for each student, its number of courses,
+ *   then the ID and the number of grades of each course, as varints
+ * - BIN_SECTION_PACKED_GRADES: all the grades as fixed-point numbers
+ *   (grade * BIN_GRADE_SCALE), on 1 byte, or 2 with BIN_FLAG_GRADES_16
+ * The averages of the courses are not stored: they are recomputed on load.
+ * 
+ * Numbers are stored in the byte order of the machine, which the magic
+ * number detects. Unknown section types are ignored by readers.
+ */
+
+#ifndef BINARYFORMAT_H
+#define BINARYFORMAT_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+/*! \brief Magic number of a version 2 file ("PROM" in little-endian order) */
+#define BIN_MAGIC 0x4D4F5250u
+
+/*! \brief Current version of the binary format */
+#define BIN_VERSION 2
+
+/*! \brief Alignment of the sections in the file (bytes) */
+#define BIN_SECTION_ALIGNMENT 64
+
+/*! \brief Maximum number of sections of a file */
+#define BIN_MAX_SECTIONS 32
+
+/*! \brief Courses of the catalog */
+#define BIN_SECTION_CATALOG 1
+/*! \brief Fixed-size student records */
+#define BIN_SECTION_STUDENTS 2
+/*! \brief First course slot of each student */
+#define BIN_SECTION_STUDENT_OFFSETS 3
+/*! \brief Fixed-size course records */
+#define BIN_SECTION_COURSES 4
+/*! \brief First grade of each course slot */
+#define BIN_SECTION_COURSE_OFFSETS 5
+/*! \brief Contiguous block of grades */
+#define BIN_SECTION_GRADES 6
+/*! \brief String pool */
+#define BIN_SECTION_STRINGS 7
+/*! \brief Student records by identifier (optional) */
+#define BIN_SECTION_STUDENT_INDEX 8
+
+/*! \brief Courses and grade counts of a compact file (varints) */
+#define BIN_SECTION_COURSE_STREAM 9
+/*! \brief Fixed-point grades of a compact file */
+#define BIN_SECTION_PACKED_GRADES 10
+
+/*! \brief Largest section type known by this version of the readers */
+#define BIN_SECTION_LAST BIN_SECTION_PACKED_GRADES
+
+/*! \brief Number of sections written in a plain file */
+#define BIN_PLAIN_SECTIONS 8
+
+/*! \brief Number of sections written in a compact file */
+#define BIN_COMPACT_SECTIONS 6
+
+/*! \brief Compact file: courses and grades are packed */
+#define BIN_FLAG_COMPACT 0x1u
+/*! \brief Packed grades take 2 bytes instead of 1 */
+#define BIN_FLAG_GRADES_16 0x2u
+
+/*! \brief Scale of the fixed-point grades (one decimal) */
+#define BIN_GRADE_SCALE 10
+
+/*!
+ * \struct BinHeader
+ * \brief Header of a version 2 file
+ */
+typedef struct
+{
+    uint32_t int_magic;       /*!< BIN_MAGIC */
+    uint32_t int_version;     /*!< Version of the format */
+    uint32_t int_nb_sections; /*!< Number of entries of the section table */
+    uint32_t int_flags;       /*!< BIN_FLAG_... bits, 0 for a plain file */
+    uint64_t size_file;       /*!< Size of the whole file (bytes) */
+} BinHeader;
+
+/*!
+ * \struct BinSection
+ * \brief Entry of the section table
+ */
+typedef struct
+{
+    uint32_t int_type;        /*!< Type of the section (BIN_SECTION_...) */
+    uint32_t int_count;       /*!< Number of records (bytes for the string pool) */
+    uint64_t size_offset;     /*!< Position of the section in the file */
+    uint64_t size_bytes;      /*!< Size of the section */
+} BinSection;
+
+/*!
+ * \struct BinCatalogRecord
+ * \brief Course of the catalog (its ID is its index)
+ */
+typedef struct
+{
+    uint32_t int_name;        /*!< Offset of the name in the string pool */
+    float float_coef;         /*!< Coefficient of the course */
+} BinCatalogRecord;
+
+/*!
+ * \struct BinStudentRecord
+ * \brief Fixed-size record of a student
+ */
+typedef struct
+{
+    int32_t int_id;           /*!< Unique identifier of the student */
+    int32_t int_age;          /*!< Age of the student */
+    float float_average;      /*!< Overall average of the student */
+    uint32_t int_last_name;   /*!< Offset of the last name in the string pool */
+    uint32_t int_first_name;  /*!< Offset of the first name in the string pool */
+    uint32_t int_reserved;    /*!< Reserved, 0 */
+} BinStudentRecord;
+
+/*!
+ * \struct BinCourseRecord
+ * \brief Fixed-size record of a course followed by a student
+ */
+typedef struct
+{
+    int32_t int_course_id;    /*!< Identifier of the course in the catalog */
+    float float_average;      /*!< Average of the student in the course */
+} BinCourseRecord;
+
+/*!
+ * \struct BinIndexEntry
+ * \brief Entry of the student index
+ */
+typedef struct
+{
+    int32_t int_id;           /*!< Identifier of the student */
+    uint32_t int_reserved;    /*!< Reserved, 0 */
+    uint64_t size_offset;     /*!< Position of the BinStudentRecord of the student in the file */
+} BinIndexEntry;
+
+/*!
+ * \struct PromImage
+ * \brief Checked view of a version 2 file held in memory
+ */
+typedef struct
+{
+    const void* ptr_data;     /*!< First byte of the file */
+    size_t size_data;         /*!< Size of the file */
+    int int_mapped;           /*!< 1 if ptr_data is a mapping owned by the image */
+    int int_nb_students;      /*!< Number of students */
+    int int_nb_courses;       /*!< Number of courses of the catalog */
+    int int_nb_slots;         /*!< Number of course slots (all students) */
+    int int_nb_grades;        /*!< Number of grades */
+    size_t size_strings;      /*!< Size of the string pool */
+    const BinCatalogRecord* record_catalog; /*!< Courses of the catalog */
+    const BinStudentRecord* record_students; /*!< Student records */
+    const int32_t* tab_student_offsets; /*!< First course slot of each student */
+    const BinCourseRecord* record_courses;  /*!< Course records */
+    const int32_t* tab_course_offsets;  /*!< First grade of each course slot */
+    const float* tab_grades;  /*!< All the grades */
+    const char* char_strings; /*!< String pool */
+    const BinIndexEntry* record_index; /*!< Student index, NULL if the file has none */
+    uint32_t int_flags;       /*!< Flags of the header */
+    const uint8_t* byte_course_stream; /*!< Courses of a compact file, NULL for a plain file */
+    size_t size_course_stream; /*!< Size of the course stream */
+    const uint8_t* byte_packed_grades; /*!< Grades of a compact file, NULL for a plain file */
+    int int_grade_bytes;      /*!< Size of a packed grade (1 or 2), 0 for a plain file */
+} PromImage;
+
+/*!
+ * \fn int open_prom_image(const void* data, size_t size, PromImage* image)
+ * \brief Checks a version 2 file held in memory and locates its sections
+ * \param data First byte of the file (aligned on 8 bytes at least, as the sections)
+ * \param size Size of the file
+ * \param image Pointer to the view to fill
+ * \return 0 on success, -1 if the data is not a valid version 2 file
+ * \pre image != NULL
+ * 
+ * All offsets, counts and string references are checked, so that the
+ * view can then be read without any bound check.
+ */
+int open_prom_image(const void* data, size_t size, PromImage* image);
+
+/*!
+ * \fn int locate_prom_image(const void* data, size_t size, PromImage* image)
+ * \brief Checks the header and the section table of a version 2 file and locates its sections
+ * \param data First byte of the file (aligned on 8 bytes at least)
+ * \param size Size of the file
+ * \param image Pointer to the view to fill
+ * \return 0 on success, -1 if the header or the section table is invalid
+ * \pre image != NULL
+ * 
+ * Only the sections are checked, in O(1): the records must then be
+ * checked with check_image_student before being read. A compact file is
+ * refused, since it cannot be read in place.
+ */
+int locate_prom_image(const void* data, size_t size, PromImage* image);
+
+/*!
+ * \fn int locate_compact_image(const void* data, size_t size, PromImage* image)
+ * \brief Checks the header and the section table of a compact file and locates its sections
+ * \param data First byte of the file (aligned on 8 bytes at least)
+ * \param size Size of the file
+ * \param image Pointer to the view to fill
+ * \return 0 on success, -1 if the file is not a valid compact file
+ * \pre image != NULL
+ * 
+ * The offset tables, course records and grades of the view stay NULL and
+ * int_nb_slots 0: the course stream and the packed grades must be decoded.
+ */
+int locate_compact_image(const void* data, size_t size, PromImage* image);
+
+/*!
+ * \fn int check_image_header(const PromImage* image, int int_student)
+ * \brief Checks the record of one student of a located image, but not its courses
+ * \param image Pointer to the view
+ * \param int_student Index of the student record
+ * \return 0 if its names and its range of course slots lie in the file, -1 otherwise
+ * \pre image != NULL
+ */
+int check_image_header(const PromImage* image, int int_student);
+
+/*!
+ * \fn int check_image_student(const PromImage* image, int int_student)
+ * \brief Checks the records of one student of a located image
+ * \param image Pointer to the view
+ * \param int_student Index of the student record
+ * \return 0 if its names, course slots and grades lie in the file, -1 otherwise
+ * \pre image != NULL
+ */
+int check_image_student(const PromImage* image, int int_student);
+
+/*!
+ * \fn int find_image_student(const PromImage* image, int int_id)
+ * \brief Looks a student up in the index of a located image (O(log n))
+ * \param image Pointer to the view
+ * \param int_id Identifier of the student
+ * \return Index of the student record, or -1 if the identifier is unknown, the index is missing or invalid
+ * \pre image != NULL
+ */
+int find_image_student(const PromImage* image, int int_id);
+
+/*!
+ * \fn int map_prom_image(const char* str_filename, PromImage* image)
+ * \brief Maps a version 2 file and checks it
+ * \param str_filename Name of the file
+ * \param image Pointer to the view to fill
+ * \return 0 on success, -1 if the file cannot be mapped or is not a valid version 2 file
+ * \pre image != NULL
+ * 
+ * The mapping is private and writable: writing to it never changes the file.
+ */
+int map_prom_image(const char* str_filename, PromImage* image);
+
+/*!
+ * \fn int map_prom_sections(const char* str_filename, PromImage* image)
+ * \brief Maps a version 2 file and only checks its header and sections (O(1))
+ * \param str_filename Name of the file
+ * \param image Pointer to the view to fill
+ * \return 0 on success, -1 if the file cannot be mapped or its sections are invalid
+ * \pre image != NULL
+ * 
+ * The records of a student must be checked with check_image_student before being read.
+ */
+int map_prom_sections(const char* str_filename, PromImage* image);
+
+/*!
+ * \fn int map_compact_image(const char* str_filename, PromImage* image)
+ * \brief Maps a compact file and locates its sections (see locate_compact_image)
+ * \param str_filename Name of the file
+ * \param image Pointer to the view to fill
+ * \return 0 on success, -1 if the file cannot be mapped or is not a valid compact file
+ * \pre image != NULL
+ */
+int map_compact_image(const char* str_filename, PromImage* image);
+
+/*!
+ * \fn void close_prom_image(PromImage* image)
+ * \brief Unmaps the file of a view opened by map_prom_image or map_prom_sections
+ * \param image Pointer to the view
+ * \pre image != NULL
+ */
+void close_prom_image(PromImage* image);
+
+/*!
+ * \fn const char* get_image_string(const PromImage* image, uint32_t int_offset)
+ * \brief Returns a string of the pool of a checked image
+ * \param image Pointer to the view
+ * \param int_offset Offset of the string in the pool
+ * \return Pointer to the NUL-terminated string
+ */
+const char* get_image_string(const PromImage* image, uint32_t int_offset);
+
+#endif
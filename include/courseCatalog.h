@@ -0,0 +1,72 @@
+/*!
+ * \file courseCatalog.h
+ * \author Akhatar Abdelhamid <abdelhamid.akhatar@etu.cyu.fr>
+ * \version 1.0
+ * \date November 2, 2025
+ * \brief Interface for the course catalog module
+ * 
+ * This file contains the prototypes of functions managing the catalog
+ * of courses of a promotion: each course name is stored once with its
+ * coefficient and identified by a dense ID used by the students' courses.
+ */
+
+#ifndef COURSECATALOG_H
+#define COURSECATALOG_H
+
+#include "structures.h"
+#include <stddef.h>
+
+/*!
+ * \fn CourseCatalog create_catalog(void)
+ * \brief Creates an empty course catalog
+ * \return Initialized CourseCatalog structure
+ */
+CourseCatalog create_catalog(void);
+
+/*!
+ * \fn void destroy_catalog(CourseCatalog* catalog)
+ * \brief Frees the memory allocated for a course catalog
+ * \param catalog Pointer to the CourseCatalog structure to destroy
+ * \pre catalog != NULL
+ */
+void destroy_catalog(CourseCatalog* catalog);
+
+/*!
+ * \fn int find_course_id(const CourseCatalog* catalog, const char* char_name, size_t size_len)
+ * \brief Finds the ID of a course from its name in O(1)
+ * \param catalog Pointer to the CourseCatalog structure
+ * \param char_name Name of the course (not necessarily NUL-terminated)
+ * \param size_len Length of the name
+ * \return ID of the course, or -1 if the name is unknown
+ * \pre catalog != NULL
+ * \pre char_name != NULL
+ */
+int find_course_id(const CourseCatalog* catalog, const char* char_name, size_t size_len);
+
+/*!
+ * \fn int intern_course(CourseCatalog* catalog, const char* char_name, size_t size_len, float float_coef)
+ * \brief Returns the ID of a course, adding it to the catalog if it is new
+ * \param catalog Pointer to the CourseCatalog structure
+ * \param char_name Name of the course (not necessarily NUL-terminated)
+ * \param size_len Length of the name
+ * \param float_coef Coefficient of the course (ignored if the course already exists)
+ * \return ID of the course, or -1 on allocation error
+ * \pre catalog != NULL
+ * \pre char_name != NULL
+ */
+int intern_course(CourseCatalog* catalog, const char* char_name, size_t size_len, float float_coef);
+
+/*!
+ * \fn Course* find_student_course(const Student* student, int int_course_id)
+ * \brief Finds the course of a student with a given catalog ID
+ * \param student Pointer to the student
+ * \param int_course_id ID of the course in the catalog
+ * \return Pointer to the student's course, or NULL if the student does not follow it
+ * \pre student != NULL
+ * 
+ * Students loaded from a data file hold the course with ID i at position i,
+ * which makes this lookup O(1); other layouts fall back to a scan.
+ */
+Course* find_student_course(const Student* student, int int_course_id);
+
+#endif
@@ -0,0 +1,118 @@
+/*!
+ * \file fieldParser.h
+ * \author Akhatar Abdelhamid <abdelhamid.akhatar@etu.cyu.fr>
+ * \version 1.0
+ * \date November 2, 2025
+ * \brief Interface for the field parser of the data file lines
+ * 
+ * This file contains the prototypes of the functions splitting a line view
+ * (pointer and length, not NUL-terminated) into its ';'-separated fields
+ * and converting the numeric fields. Unlike sscanf and strtof, they do not
+ * depend on the locale: the decimal separator is always '.'.
+ * 
+ * A decimal field is read as an integer q of at most 2^24 and a number k
+ * of decimals, then divided by 10^k: both are exact floats, so the
+ * division gives the float nearest to the text, as strtof does.
+ */
+
+#ifndef FIELDPARSER_H
+#define FIELDPARSER_H
+
+#include <stddef.h>
+
+/*! \brief The line was parsed */
+#define PARSE_OK 0
+/*! \brief The line has fewer fields than expected */
+#define PARSE_MISSING_FIELD 1
+/*! \brief The line has more fields than expected */
+#define PARSE_EXTRA_FIELD 2
+/*! \brief A field is not an integer or does not fit in an int */
+#define PARSE_BAD_INTEGER 3
+/*! \brief A field is not a decimal number or has too many significant digits */
+#define PARSE_BAD_NUMBER 4
+/*! \brief The line was valid but its copy could not be allocated (-1, as other allocation errors) */
+#define PARSE_NO_MEMORY -1
+
+/*! \brief Largest integer q of a decimal field (every integer up to it is an exact float) */
+#define PARSE_MAX_DIGITS_VALUE (1 << 24)
+/*! \brief Largest number of decimals of a decimal field (10^k is then an exact float) */
+#define PARSE_MAX_DECIMALS 10
+
+/*!
+ * \struct FieldReader
+ * \brief Cursor on the fields of a line view
+ */
+typedef struct
+{
+    const char* char_next;    /*!< First character of the next field, NULL once the last field was read */
+    const char* char_end;     /*!< End of the line, a trailing '\r' excluded */
+} FieldReader;
+
+/*!
+ * \fn void start_fields(FieldReader* reader, const char* text, size_t len)
+ * \brief Places a field reader on the first field of a line
+ * \param reader Pointer to the FieldReader to initialize
+ * \param text First character of the line
+ * \param len Length of the line, without its newline
+ * \pre reader != NULL
+ * \pre text != NULL
+ */
+void start_fields(FieldReader* reader, const char* text, size_t len);
+
+/*!
+ * \fn int next_field(FieldReader* reader, const char** field, size_t* len)
+ * \brief Reads the next ';'-separated field of a line
+ * \param reader Pointer to the FieldReader
+ * \param field Pointer receiving the first character of the field
+ * \param len Pointer receiving the length of the field
+ * \return 1 if a field was read, 0 after the last field
+ * \pre reader != NULL
+ * \pre field != NULL
+ * \pre len != NULL
+ */
+int next_field(FieldReader* reader, const char** field, size_t* len);
+
+/*!
+ * \fn int has_more_fields(const FieldReader* reader)
+ * \brief Tells whether fields remain to be read
+ * \param reader Pointer to the FieldReader
+ * \return 1 if next_field would read a field, 0 otherwise
+ * \pre reader != NULL
+ */
+int has_more_fields(const FieldReader* reader);
+
+/*!
+ * \fn int parse_int_field(const char* text, size_t len, int* value)
+ * \brief Converts a whole field to an int
+ * \param text First character of the field
+ * \param len Length of the field
+ * \param value Pointer receiving the integer
+ * \return PARSE_OK, or PARSE_BAD_INTEGER if the field is not an optionally signed decimal int
+ * \pre value != NULL
+ */
+int parse_int_field(const char* text, size_t len, int* value);
+
+/*!
+ * \fn int parse_decimal_field(const char* text, size_t len, float* value)
+ * \brief Converts a whole field "[sign]digits[.digits]" to the nearest float
+ * \param text First character of the field
+ * \param len Length of the field
+ * \param value Pointer receiving the number
+ * \return PARSE_OK, or PARSE_BAD_NUMBER if the field is not a decimal number or is too precise
+ * \pre value != NULL
+ * 
+ * Trailing zeros of the decimals are ignored. Without them, the digits
+ * must form an integer of at most PARSE_MAX_DIGITS_VALUE, with at most
+ * PARSE_MAX_DECIMALS decimals: "12.5" and "0.25" are read, "123456789" is not.
+ */
+int parse_decimal_field(const char* text, size_t len, float* value);
+
+/*!
+ * \fn const char* get_parse_error(int int_error)
+ * \brief Describes a parse error
+ * \param int_error PARSE_OK or one of the PARSE_ error codes
+ * \return Static description of the error
+ */
+const char* get_parse_error(int int_error);
+
+#endif
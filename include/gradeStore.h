@@ -0,0 +1,84 @@
+/*!
+ * \file gradeStore.h
+ * \author Akhatar Abdelhamid <abdelhamid.akhatar@etu.cyu.fr>
+ * \version 1.0
+ * \date November 2, 2025
+ * \brief Interface for the columnar grade store module
+ * 
+ * This file contains the prototypes of functions moving all the grades
+ * of a promotion into one contiguous array (compressed sparse row layout)
+ * and of the accessors reading it.
+ * 
+ * While the store exists, the tab_grades array of each course points into
+ * it: the grades can be read as before but must not be reallocated or freed.
+ */
+
+#ifndef GRADESTORE_H
+#define GRADESTORE_H
+
+#include "init.h"
+
+/*!
+ * \fn GradeStore* create_grade_store(int int_nb_students, int int_nb_slots, int int_nb_grades)
+ * \brief Allocates an empty columnar store owning its arrays
+ * \param int_nb_students Number of students
+ * \param int_nb_slots Number of course slots
+ * \param int_nb_grades Number of grades
+ * \return Pointer to the store, its offset tables and grades to fill, or NULL on allocation error
+ * 
+ * The store is attached to a promotion by setting prom->store_grades.
+ */
+GradeStore* create_grade_store(int int_nb_students, int int_nb_slots, int int_nb_grades);
+
+/*!
+ * \fn int build_grade_store(Prom* prom)
+ * \brief Moves all the grades of a promotion into a columnar store
+ * \param prom Pointer to the Prom structure
+ * \return 0 on success (or if the store already exists), -1 on allocation error
+ * \pre prom != NULL
+ */
+int build_grade_store(Prom* prom);
+
+/*!
+ * \fn int release_grade_store(Prom* prom)
+ * \brief Gives each course its own grades array again and frees the store
+ * \param prom Pointer to the Prom structure
+ * \return 0 on success, -1 on allocation error (the store is then kept)
+ * \pre prom != NULL
+ * 
+ * Must be called before adding, removing or reordering grades or students.
+ */
+int release_grade_store(Prom* prom);
+
+/*!
+ * \fn void destroy_grade_store(Prom* prom)
+ * \brief Frees the store and empties the grades of all courses
+ * \param prom Pointer to the Prom structure
+ * \pre prom != NULL
+ */
+void destroy_grade_store(Prom* prom);
+
+/*!
+ * \fn int get_store_slot(const GradeStore* store, int int_position, int int_course)
+ * \brief Returns the course slot of a course of a student
+ * \param store Pointer to the GradeStore structure
+ * \param int_position Position of the student in the promotion
+ * \param int_course Position of the course in the student's course array
+ * \return Course slot in the store
+ * \pre store != NULL
+ */
+int get_store_slot(const GradeStore* store, int int_position, int int_course);
+
+/*!
+ * \fn const float* get_store_grades(const GradeStore* store, int int_slot, int* int_nb_grades)
+ * \brief Returns the contiguous grades of a course slot
+ * \param store Pointer to the GradeStore structure
+ * \param int_slot Course slot in the store
+ * \param int_nb_grades Pointer receiving the number of grades
+ * \return Pointer to the first grade of the slot
+ * \pre store != NULL
+ * \pre int_nb_grades != NULL
+ */
+const float* get_store_grades(const GradeStore* store, int int_slot, int* int_nb_grades);
+
+#endif
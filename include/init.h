@@ -17,6 +17,11 @@
 #ifndef INIT_H
 #define INIT_H
 
+#ifndef GROW_MIN_CAPACITY
+/*! \brief First capacity of a growable array filled one element at a time */
+#define GROW_MIN_CAPACITY 4
+#endif
+
 /*!
  * \fn Grades create_grades(int int_nb_grades)
  * \brief Creates a Grades structure with dynamic allocation
@@ -27,17 +32,37 @@
 Grades create_grades(int int_nb_grades);
 
 /*!
- * \fn Course create_course(const char* char_course_name, float float_coef, int int_nb_grades)
+ * \fn Grades create_grades_in(Arena* arena, int int_nb_grades)
+ * \brief Creates a Grades structure whose array is allocated in an arena
+ * \param arena Pointer to the arena (NULL: heap)
+ * \param int_nb_grades Number of grades to allocate
+ * \return Initialized Grades structure with grades set to 0.0
+ * \pre int_nb_grades >= 0
+ */
+Grades create_grades_in(Arena* arena, int int_nb_grades);
+
+/*!
+ * \fn Course create_course(int int_course_id, int int_nb_grades)
  * \brief Creates a Course structure (subject) with dynamic allocation
- * \param char_course_name Name of the course
- * \param float_coef Coefficient of the course
+ * \param int_course_id ID of the course in the catalog of the promotion
+ * \param int_nb_grades Number of grades to allocate
+ * \return Initialized Course structure
+ * \pre int_course_id >= 0
+ * \pre int_nb_grades >= 0
+ */
+Course create_course(int int_course_id, int int_nb_grades);
+
+/*!
+ * \fn Course create_course_in(Arena* arena, int int_course_id, int int_nb_grades)
+ * \brief Creates a Course structure whose grades are allocated in an arena
+ * \param arena Pointer to the arena (NULL: heap)
+ * \param int_course_id ID of the course in the catalog of the promotion
  * \param int_nb_grades Number of grades to allocate
  * \return Initialized Course structure
- * \pre char_course_name != NULL
- * \pre float_coef >= 0
+ * \pre int_course_id >= 0
  * \pre int_nb_grades >= 0
  */
-Course create_course(const char* char_course_name, float float_coef, int int_nb_grades);
+Course create_course_in(Arena* arena, int int_course_id, int int_nb_grades);
 
 /*!
  * \fn Student create_student(int int_id, const char* char_last_name, const char* char_first_name, int int_age, int int_nb_courses)
@@ -56,6 +81,22 @@ Course create_course(const char* char_course_name, float float_coef, int int_nb_
  */
 Student create_student(int int_id, const char* char_last_name, const char* char_first_name, int int_age, int int_nb_courses);
 
+/*!
+ * \fn Student create_student_in(Arena* arena, int int_id, const char* char_last_name, const char* char_first_name, int int_age, int int_nb_courses)
+ * \brief Creates a Student structure whose names and courses are allocated in an arena
+ * \param arena Pointer to the arena (NULL: heap)
+ * \param int_id Unique identifier of the student
+ * \param char_last_name Last name of the student
+ * \param char_first_name First name of the student
+ * \param int_age Age of the student
+ * \param int_nb_courses Number of courses to allocate
+ * \return Initialized Student structure
+ * \pre char_last_name != NULL
+ * \pre char_first_name != NULL
+ * \pre int_nb_courses >= 0
+ */
+Student create_student_in(Arena* arena, int int_id, const char* char_last_name, const char* char_first_name, int int_age, int int_nb_courses);
+
 /*!
  * \fn Prom create_prom(int int_nb_students)
  * \brief Creates a Prom structure (promotion) with dynamic allocation
@@ -65,6 +106,18 @@ Student create_student(int int_id, const char* char_last_name, const char* char_
  */
 Prom create_prom(int int_nb_students);
 
+/*!
+ * \fn Prom create_arena_prom(int int_nb_students)
+ * \brief Creates a Prom structure whose names, courses and grades will be allocated in an arena
+ * \param int_nb_students Number of students to allocate
+ * \return Initialized Prom structure (without arena if it cannot be allocated)
+ * \pre int_nb_students >= 0
+ * 
+ * Students added to this promotion must be created with create_student_in(prom.arena_memory, ...).
+ * destroy_prom then releases all of them at once with the arena.
+ */
+Prom create_arena_prom(int int_nb_students);
+
 /*!
  * \fn void destroy_prom(Prom* prom)
  * \brief Frees the memory allocated for a Prom structure
@@ -81,6 +134,15 @@ void destroy_prom(Prom* prom);
  */
 void destroy_student(Student* student);
 
+/*!
+ * \fn void destroy_student_in(Arena* arena, Student* student)
+ * \brief Gives back to an arena the memory of a Student structure
+ * \param arena Pointer to the arena the student was created in (NULL: heap)
+ * \param student Pointer to the Student structure to destroy
+ * \pre student != NULL
+ */
+void destroy_student_in(Arena* arena, Student* student);
+
 /*!
  * \fn void destroy_course(Course* course)
  * \brief Frees the memory allocated for a Course structure
@@ -89,6 +151,15 @@ void destroy_student(Student* student);
  */
 void destroy_course(Course* course);
 
+/*!
+ * \fn void destroy_course_in(Arena* arena, Course* course)
+ * \brief Gives back to an arena the memory of a Course structure
+ * \param arena Pointer to the arena the course was created in (NULL: heap)
+ * \param course Pointer to the Course structure to destroy
+ * \pre course != NULL
+ */
+void destroy_course_in(Arena* arena, Course* course);
+
 /*!
  * \fn void destroy_grades(Grades* grades)
  * \brief Frees the memory allocated for a Grades structure
@@ -97,4 +168,133 @@ void destroy_course(Course* course);
  */
 void destroy_grades(Grades* grades);
 
+/*!
+ * \fn void destroy_grades_in(Arena* arena, Grades* grades)
+ * \brief Gives back to an arena the memory of a Grades structure
+ * \param arena Pointer to the arena the grades were created in (NULL: heap)
+ * \param grades Pointer to the Grades structure to destroy
+ * \pre grades != NULL
+ */
+void destroy_grades_in(Arena* arena, Grades* grades);
+
+/*!
+ * \fn float* get_grades_data(const Grades* grades)
+ * \brief Returns the array holding the grades of a Grades structure
+ * \param grades Pointer to the Grades structure
+ * \return tab_grades, or the inline array when the grades are stored inline
+ * \pre grades != NULL
+ * 
+ * The inline array moves with the structure: the pointer is only valid
+ * until the Grades (or its Course) is copied or grown.
+ */
+float* get_grades_data(const Grades* grades);
+
+/*!
+ * \fn void borrow_grades(Grades* grades, float* tab_grades, int int_nb_grades)
+ * \brief Makes a Grades structure read its grades from an array it does not own
+ * \param grades Pointer to the Grades structure (its own array already released)
+ * \param tab_grades Grades in a columnar store or a mapped file
+ * \param int_nb_grades Number of grades
+ * \pre grades != NULL
+ */
+void borrow_grades(Grades* grades, float* tab_grades, int int_nb_grades);
+
+/*!
+ * \fn int reserve_grades_in(Arena* arena, Grades* grades, int int_capacity)
+ * \brief Makes room in a grades array for a number of grades
+ * \param arena Pointer to the arena the grades were created in (NULL: heap)
+ * \param grades Pointer to the Grades structure
+ * \param int_capacity Number of grades the array must hold
+ * \return 0 on success, -1 on allocation error (the array is unchanged)
+ * \pre grades != NULL
+ */
+int reserve_grades_in(Arena* arena, Grades* grades, int int_capacity);
+
+/*!
+ * \fn void shrink_grades_in(Arena* arena, Grades* grades)
+ * \brief Gives back the unused end of a grades array
+ * \param arena Pointer to the arena the grades were created in (NULL: heap)
+ * \param grades Pointer to the Grades structure
+ * \pre grades != NULL
+ */
+void shrink_grades_in(Arena* arena, Grades* grades);
+
+/*!
+ * \fn int push_grade_in(Arena* arena, Grades* grades, float float_grade)
+ * \brief Appends a grade to a grades array, doubling its capacity when full
+ * \param arena Pointer to the arena the grades were created in (NULL: heap)
+ * \param grades Pointer to the Grades structure
+ * \param float_grade Grade to add
+ * \return 0 on success, -1 on allocation error
+ * \pre grades != NULL
+ */
+int push_grade_in(Arena* arena, Grades* grades, float float_grade);
+
+/*!
+ * \fn int reserve_student_courses_in(Arena* arena, Student* student, int int_capacity)
+ * \brief Makes room in the courses array of a student for a number of courses
+ * \param arena Pointer to the arena the student was created in (NULL: heap)
+ * \param student Pointer to the Student structure
+ * \param int_capacity Number of courses the array must hold
+ * \return 0 on success, -1 on allocation error (the array is unchanged)
+ * \pre student != NULL
+ */
+int reserve_student_courses_in(Arena* arena, Student* student, int int_capacity);
+
+/*!
+ * \fn void shrink_student_courses_in(Arena* arena, Student* student)
+ * \brief Gives back the unused end of the courses array of a student and of their grades arrays
+ * \param arena Pointer to the arena the student was created in (NULL: heap)
+ * \param student Pointer to the Student structure
+ * \pre student != NULL
+ */
+void shrink_student_courses_in(Arena* arena, Student* student);
+
+/*!
+ * \fn int push_student_course_in(Arena* arena, Student* student, Course course)
+ * \brief Appends a course to the courses array of a student, doubling its capacity when full
+ * \param arena Pointer to the arena the student was created in (NULL: heap)
+ * \param student Pointer to the Student structure
+ * \param course Course to add (the student takes its grades)
+ * \return 0 on success, -1 on allocation error
+ * \pre student != NULL
+ */
+int push_student_course_in(Arena* arena, Student* student, Course course);
+
+/*!
+ * \fn int reserve_prom_students(Prom* prom, int int_capacity)
+ * \brief Makes room in the students array of a cohort for a number of students
+ * \param prom Pointer to the Prom structure
+ * \param int_capacity Number of students the array must hold
+ * \return 0 on success, -1 on allocation error (the array is unchanged)
+ * \pre prom != NULL
+ */
+int reserve_prom_students(Prom* prom, int int_capacity);
+
+/*!
+ * \fn void shrink_prom_students(Prom* prom)
+ * \brief Gives back the unused end of the students array of a cohort
+ * \param prom Pointer to the Prom structure
+ * \pre prom != NULL
+ */
+void shrink_prom_students(Prom* prom);
+
+/*!
+ * \fn int push_prom_student(Prom* prom, Student student)
+ * \brief Appends a student to the students array of a cohort, doubling its capacity when full
+ * \param prom Pointer to the Prom structure
+ * \param student Student to add (the cohort takes its names and courses)
+ * \return 0 on success, -1 on allocation error
+ * \pre prom != NULL
+ */
+int push_prom_student(Prom* prom, Student student);
+
+/*!
+ * \fn void shrink_prom_to_fit(Prom* prom)
+ * \brief Gives back the unused end of all the arrays of a cohort once it is loaded
+ * \param prom Pointer to the Prom structure
+ * \pre prom != NULL
+ */
+void shrink_prom_to_fit(Prom* prom);
+
 #endif
\ No newline at end of file
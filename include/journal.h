@@ -0,0 +1,186 @@
+/*!
+ * \file journal.h
+ * \author Akhatar Abdelhamid <abdelhamid.akhatar@etu.cyu.fr>
+ * \version 1.0
+ * \date November 2, 2025
+ * \brief Interface for the journal of grade changes of a binary file
+ * 
+ * A journaled promotion is a snapshot (any binary file read by
+ * load_prom_binary) plus the file "<snapshot>.journal", to which grade
+ * insertions and updates are appended as fixed-size records:
+ * - a JournalHeader naming the snapshot the records apply to
+ * - the JournalRecord entries, in the order they were made
+ * Saving a batch of changes then writes only its records. Once the
+ * journal grows past a threshold, it is folded into a new snapshot.
+ * 
+ * The snapshot is identified by its inode, size and modification time:
+ * a journal left behind by an interrupted compaction no longer matches
+ * the new snapshot and is ignored. A record cut by a crash fails its
+ * check and ends the replay.
+ */
+
+#ifndef JOURNAL_H
+#define JOURNAL_H
+
+#include "structures.h"
+#include <stdio.h>
+#include <stdint.h>
+
+/*! \brief Magic number of a journal ("PRMJ" in little-endian order) */
+#define JOURNAL_MAGIC 0x4A4D5250u
+
+/*! \brief Current version of the journal */
+#define JOURNAL_VERSION 1
+
+#ifndef JOURNAL_DEFAULT_THRESHOLD
+/*! \brief Size of the journal from which a commit compacts it (bytes) */
+#define JOURNAL_DEFAULT_THRESHOLD (1 << 20)
+#endif
+
+/*! \brief Record appending a grade to a course */
+#define JOURNAL_ADD_GRADE 1
+/*! \brief Record replacing a grade of a course */
+#define JOURNAL_SET_GRADE 2
+
+/*!
+ * \struct JournalHeader
+ * \brief Header of a journal
+ */
+typedef struct
+{
+    uint32_t int_magic;       /*!< JOURNAL_MAGIC */
+    uint32_t int_version;     /*!< JOURNAL_VERSION */
+    uint64_t size_snapshot;   /*!< Size of the snapshot (bytes) */
+    uint64_t int_inode;       /*!< Inode of the snapshot */
+    int64_t int_mtime_sec;    /*!< Modification time of the snapshot (seconds) */
+    int64_t int_mtime_nsec;   /*!< Modification time of the snapshot (nanoseconds) */
+} JournalHeader;
+
+/*!
+ * \struct JournalRecord
+ * \brief Grade change of a journal
+ */
+typedef struct
+{
+    uint32_t int_kind;        /*!< JOURNAL_ADD_GRADE or JOURNAL_SET_GRADE */
+    int32_t int_student_id;   /*!< Identifier of the student */
+    int32_t int_course_id;    /*!< ID of the course in the catalog of the snapshot */
+    int32_t int_index;        /*!< Index of the replaced grade, -1 for an added grade */
+    float float_grade;        /*!< New grade */
+    uint32_t int_check;       /*!< Hash of the previous fields */
+} JournalRecord;
+
+/*!
+ * \struct Journal
+ * \brief Journal opened for appending
+ */
+typedef struct
+{
+    char *str_snapshot;       /*!< Name of the snapshot */
+    char *str_journal;        /*!< Name of the journal */
+    FILE *file;               /*!< Journal, positioned after its last record */
+    JournalRecord *record_pending; /*!< Dynamic array of the records not committed yet */
+    int int_nb_pending;       /*!< Number of records not committed yet */
+    int int_max_pending;      /*!< Allocated size of the pending array */
+    uint64_t size_journal;    /*!< Size of the committed journal (bytes) */
+    uint64_t size_threshold;  /*!< Size from which a commit compacts the journal, 0 for never */
+} Journal;
+
+/*!
+ * \fn int create_journal(const char* str_snapshot, Prom* prom, Journal* journal)
+ * \brief Saves a promotion as a new snapshot with an empty journal
+ * \param str_snapshot Name of the snapshot
+ * \param prom Pointer to the Prom structure to save
+ * \param journal Pointer to the Journal structure to open
+ * \return 0 on success, -1 in case of error
+ * \pre str_snapshot != NULL
+ * \pre prom != NULL
+ * \pre journal != NULL
+ * 
+ * The snapshot is written to a temporary file renamed over the old one,
+ * so that it is never seen half written.
+ */
+int create_journal(const char* str_snapshot, Prom* prom, Journal* journal);
+
+/*!
+ * \fn Prom load_prom_journaled(const char* str_snapshot, Journal* journal)
+ * \brief Restores a promotion from a snapshot and replays its journal
+ * \param str_snapshot Name of the snapshot
+ * \param journal Pointer to the Journal structure to open for the next changes, NULL to only load
+ * \return Restored Prom structure, or empty structure in case of error
+ * \pre str_snapshot != NULL
+ * 
+ * The averages are recomputed if any record was replayed. A journal that
+ * does not match the snapshot is replaced by an empty one when opened.
+ */
+Prom load_prom_journaled(const char* str_snapshot, Journal* journal);
+
+/*!
+ * \fn int journal_add_grade(Journal* journal, Prom* prom, int int_student_id, int int_course_id, float float_grade)
+ * \brief Appends a grade to the course of a student and records it
+ * \param journal Pointer to the opened journal
+ * \param prom Pointer to the Prom structure
+ * \param int_student_id Identifier of the student
+ * \param int_course_id ID of the course in the catalog
+ * \param float_grade Grade to add
+ * \return 0 on success, -1 if the student does not follow the course or on allocation error
+ * \pre journal != NULL
+ * \pre prom != NULL
+ * 
+ * The record is only written by commit_journal. As after get_all_grades,
+ * the averages are not updated.
+ */
+int journal_add_grade(Journal* journal, Prom* prom, int int_student_id, int int_course_id, float float_grade);
+
+/*!
+ * \fn int journal_set_grade(Journal* journal, Prom* prom, int int_student_id, int int_course_id, int int_index, float float_grade)
+ * \brief Replaces a grade of the course of a student and records it
+ * \param journal Pointer to the opened journal
+ * \param prom Pointer to the Prom structure
+ * \param int_student_id Identifier of the student
+ * \param int_course_id ID of the course in the catalog
+ * \param int_index Index of the grade in the course
+ * \param float_grade New grade
+ * \return 0 on success, -1 if the grade does not exist or on allocation error
+ * \pre journal != NULL
+ * \pre prom != NULL
+ * 
+ * The record is only written by commit_journal. The averages are not updated.
+ */
+int journal_set_grade(Journal* journal, Prom* prom, int int_student_id, int int_course_id, int int_index, float float_grade);
+
+/*!
+ * \fn int commit_journal(Journal* journal, Prom* prom)
+ * \brief Writes the pending records in one write and syncs the journal
+ * \param journal Pointer to the opened journal
+ * \param prom Pointer to the Prom structure the records were applied to
+ * \return 0 on success, -1 in case of error (the journal is then left as before the call)
+ * \pre journal != NULL
+ * \pre prom != NULL
+ * 
+ * The journal is compacted once it exceeds journal->size_threshold.
+ */
+int commit_journal(Journal* journal, Prom* prom);
+
+/*!
+ * \fn int compact_journal(Journal* journal, Prom* prom)
+ * \brief Folds the journal into a new snapshot of the promotion and empties it
+ * \param journal Pointer to the opened journal
+ * \param prom Pointer to the Prom structure the records were applied to
+ * \return 0 on success, -1 in case of error
+ * \pre journal != NULL
+ * \pre prom != NULL
+ * 
+ * The pending records are dropped: the snapshot already holds them.
+ */
+int compact_journal(Journal* journal, Prom* prom);
+
+/*!
+ * \fn void close_journal(Journal* journal)
+ * \brief Closes a journal, dropping the records not committed
+ * \param journal Pointer to the Journal structure
+ * \pre journal != NULL
+ */
+void close_journal(Journal* journal);
+
+#endif
@@ -0,0 +1,79 @@
+/*!
+ * \file kernels.h
+ * \author Akhatar Abdelhamid <abdelhamid.akhatar@etu.cyu.fr>
+ * \version 1.0
+ * \date November 2, 2025
+ * \brief Interface for the vectorized average kernels
+ * 
+ * This file contains the prototypes of the arithmetic kernels used to
+ * compute averages: the sum of an array of grades and the dot product of
+ * course averages with their coefficients. An SSE2 or AVX2 version is
+ * selected at run time depending on the processor, with a scalar fallback.
+ * 
+ * Short arrays (below KERNEL_MIN_VECTOR values) always use the scalar loop.
+ * The vector versions only reassociate the additions (several partial sums
+ * are accumulated then added together). Compared with the scalar
+ * left-to-right loop, the result of a sum of n floats x_i differs by at most
+ * 2 * n * 2^-24 * sum(|x_i|): for grades in [0, 20] this stays far below
+ * the 0.01 precision of the displayed averages.
+ */
+
+#ifndef KERNELS_H
+#define KERNELS_H
+
+/*! \brief Plain C loops */
+#define KERNEL_SCALAR 0
+/*! \brief 4 floats per instruction */
+#define KERNEL_SSE2 1
+/*! \brief 8 floats per instruction */
+#define KERNEL_AVX2 2
+
+/*!
+ * \def KERNEL_MIN_VECTOR
+ * \brief Arrays shorter than this are handled by the scalar loop
+ * 
+ * Below two AVX2 registers, the horizontal sum costs more than it saves.
+ */
+#ifndef KERNEL_MIN_VECTOR
+#define KERNEL_MIN_VECTOR 16
+#endif
+
+/*!
+ * \fn int set_kernel_level(int int_level)
+ * \brief Selects the instruction set used by the kernels
+ * \param int_level Requested level (KERNEL_SCALAR, KERNEL_SSE2 or KERNEL_AVX2)
+ * \return Selected level: the requested one, lowered to what the processor supports
+ */
+int set_kernel_level(int int_level);
+
+/*!
+ * \fn int get_kernel_level(void)
+ * \brief Returns the instruction set used by the kernels
+ * \return KERNEL_SCALAR, KERNEL_SSE2 or KERNEL_AVX2
+ * 
+ * The first call selects the best level supported by the processor.
+ */
+int get_kernel_level(void);
+
+/*!
+ * \fn float sum_floats(const float* tab_values, int int_nb_values)
+ * \brief Computes the sum of an array of floats
+ * \param tab_values Array of values
+ * \param int_nb_values Number of values
+ * \return Sum of the values
+ * \pre tab_values != NULL || int_nb_values == 0
+ */
+float sum_floats(const float* tab_values, int int_nb_values);
+
+/*!
+ * \fn float dot_floats(const float* tab_a, const float* tab_b, int int_nb_values)
+ * \brief Computes the dot product of two arrays of floats
+ * \param tab_a First array
+ * \param tab_b Second array
+ * \param int_nb_values Number of values in each array
+ * \return Sum of the products tab_a[i] * tab_b[i]
+ * \pre tab_a != NULL && tab_b != NULL || int_nb_values == 0
+ */
+float dot_floats(const float* tab_a, const float* tab_b, int int_nb_values);
+
+#endif
@@ -0,0 +1,122 @@
+/*!
+ * \file lazyLoad.h
+ * \author Akhatar Abdelhamid <abdelhamid.akhatar@etu.cyu.fr>
+ * \version 1.0
+ * \date November 2, 2025
+ * \brief Interface for the lazy loading module of binary files
+ * 
+ * This file contains the prototypes of functions loading a version 2
+ * binary file lazily: the student headers (identifier, names, age,
+ * average) are read at once, the courses and grades of a student are
+ * only paged in from the mapped file the first time they are used.
+ * Resident courses are evicted again, least recently used first, once
+ * they exceed a memory budget.
+ * 
+ * A lazy promotion can be ranked, displayed and saved. Any function
+ * modifying courses or grades first calls materialize_prom, which loads
+ * all the remaining courses and turns it into a regular promotion.
+ */
+
+#ifndef LAZYLOAD_H
+#define LAZYLOAD_H
+
+#include "structures.h"
+#include "binaryFormat.h"
+
+#ifndef LAZY_DEFAULT_BUDGET
+/*! \brief Default memory budget of the courses and grades of a lazy promotion (bytes) */
+#define LAZY_DEFAULT_BUDGET (4 << 20)
+#endif
+
+/*!
+ * \struct LazyPages
+ * \brief Paging state of a lazily loaded promotion
+ * 
+ * A student is resident when its course array is allocated. The resident
+ * students form a queue swept as a clock: a student used since the last
+ * sweep gets a second chance, the others are evicted.
+ */
+struct LazyPages
+{
+    PromImage image;          /*!< Mapped file, owned by the promotion */
+    size_t size_budget;       /*!< Bytes of resident courses and grades allowed, 0 for no limit */
+    size_t size_resident;     /*!< Bytes of resident courses and grades */
+    unsigned char *tab_referenced; /*!< 1 if the student at this position was used since the last sweep */
+    int *tab_queue;           /*!< Positions of the resident students, circular, oldest first */
+    int int_queue_head;       /*!< Index of the oldest resident student in tab_queue */
+    int int_nb_resident;      /*!< Number of resident students */
+};
+
+/*!
+ * \fn Prom load_prom_binary_lazy(const char* str_filename, size_t size_budget)
+ * \brief Restores the student headers of a version 2 binary file, courses on demand
+ * \param str_filename Name of the source binary file
+ * \param size_budget Bytes of courses and grades kept in memory, 0 for no limit
+ * \return Restored Prom structure, or empty structure on error
+ * \pre str_filename != NULL
+ * 
+ * Only the student records, the offset tables and the names are read:
+ * every course_courses is NULL until page_student_courses is called. A
+ * version 1 file has no random access and is loaded entirely by
+ * load_prom_binary.
+ */
+Prom load_prom_binary_lazy(const char* str_filename, size_t size_budget);
+
+/*!
+ * \fn int page_student_courses(const Prom* prom, int int_position)
+ * \brief Makes the courses of a student resident before they are read
+ * \param prom Pointer to the Prom structure
+ * \param int_position Position of the student in the student array
+ * \return 0 if course_courses can be read, -1 on allocation error
+ * \pre prom != NULL
+ * \pre 0 <= int_position < prom->int_nb_students
+ * 
+ * Does nothing if the promotion is not lazy. Paging a student in may
+ * evict other students, so a course pointer is only valid until the next
+ * call. The grades are not copied: they point into the mapped file, whose
+ * pages are given back to the system when the student is evicted.
+ */
+int page_student_courses(const Prom* prom, int int_position);
+
+/*!
+ * \fn int materialize_prom(Prom* prom)
+ * \brief Loads all the courses of a lazy promotion and ends lazy loading
+ * \param prom Pointer to the Prom structure
+ * \return 0 on success (or if the promotion is not lazy), -1 on allocation error
+ * \pre prom != NULL
+ * 
+ * The promotion is then the same as one loaded by load_prom_binary: its
+ * course arrays are in its arena and its grades in a borrowed GradeStore.
+ * On error it stays lazy.
+ */
+int materialize_prom(Prom* prom);
+
+/*!
+ * \fn void set_lazy_budget(Prom* prom, size_t size_budget)
+ * \brief Changes the memory budget of a lazy promotion, evicting students if needed
+ * \param prom Pointer to the Prom structure
+ * \param size_budget Bytes of courses and grades kept in memory, 0 for no limit
+ * \pre prom != NULL
+ */
+void set_lazy_budget(Prom* prom, size_t size_budget);
+
+/*!
+ * \fn size_t get_lazy_resident_size(const Prom* prom)
+ * \brief Returns the bytes of courses and grades currently paged in
+ * \param prom Pointer to the Prom structure
+ * \return Resident bytes, 0 if the promotion is not lazy
+ * \pre prom != NULL
+ */
+size_t get_lazy_resident_size(const Prom* prom);
+
+/*!
+ * \fn void destroy_lazy_pages(Prom* prom)
+ * \brief Frees the resident courses and the paging state, and unmaps the file
+ * \param prom Pointer to the Prom structure
+ * \pre prom != NULL
+ * 
+ * Called by destroy_prom, after which the names of the students are no longer valid.
+ */
+void destroy_lazy_pages(Prom* prom);
+
+#endif
@@ -0,0 +1,77 @@
+/*!
+ * \file lzCodec.h
+ * \author Akhatar Abdelhamid <abdelhamid.akhatar@etu.cyu.fr>
+ * \version 1.0
+ * \date November 2, 2025
+ * \brief Interface for the LZ compression module
+ * 
+ * This file contains the prototypes of a small byte-oriented LZ77 codec
+ * in the LZ4 family. A compressed block is a list of sequences, each made
+ * of a token byte, literals copied as is, then a match copied from the
+ * already decoded output:
+ * - token: number of literals (high 4 bits) and match length minus
+ *   LZ_MIN_MATCH (low 4 bits); 15 means the length continues in the next
+ *   bytes, each adding 0 to 255, up to a byte below 255
+ * - the literals
+ * - match offset on 2 bytes (little-endian, 1 to LZ_MAX_OFFSET), then
+ *   the continuation of the match length
+ * The last sequence has literals only and ends the block. Blocks are
+ * independent: each one can be decoded alone.
+ */
+
+#ifndef LZCODEC_H
+#define LZCODEC_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/*! \brief Shortest match encoded (bytes) */
+#define LZ_MIN_MATCH 4
+
+/*! \brief Largest distance of a match (bytes) */
+#define LZ_MAX_OFFSET 65535
+
+/*! \brief Number of bits of the hash table of the compressor */
+#define LZ_HASH_BITS 12
+
+/*!
+ * \fn size_t get_lz_bound(size_t size_src)
+ * \brief Returns the largest size of a compressed block
+ * \param size_src Size of the data to compress
+ * \return Size of a destination always large enough for lz_compress
+ */
+size_t get_lz_bound(size_t size_src);
+
+/*!
+ * \fn size_t lz_compress(const uint8_t* src, size_t size_src, uint8_t* dst, size_t size_dst)
+ * \brief Compresses a block
+ * \param src Data to compress
+ * \param size_src Size of the data
+ * \param dst Destination of the compressed block
+ * \param size_dst Size of the destination
+ * \return Size of the compressed block, or 0 if it does not fit in the destination
+ * \pre src != NULL || size_src == 0
+ * \pre dst != NULL
+ * 
+ * Greedy parsing with a hash table of the last position of each 4-byte
+ * sequence: fast, and thread-safe since the table is local.
+ */
+size_t lz_compress(const uint8_t* src, size_t size_src, uint8_t* dst, size_t size_dst);
+
+/*!
+ * \fn int lz_decompress(const uint8_t* src, size_t size_src, uint8_t* dst, size_t size_dst)
+ * \brief Decompresses a block
+ * \param src Compressed block
+ * \param size_src Size of the compressed block
+ * \param dst Destination of the data
+ * \param size_dst Exact size of the data
+ * \return 0 on success, -1 if the block is invalid or does not decode to exactly size_dst bytes
+ * \pre src != NULL
+ * \pre dst != NULL || size_dst == 0
+ * 
+ * Every length and offset is checked: an invalid block never reads or
+ * writes out of its buffers.
+ */
+int lz_decompress(const uint8_t* src, size_t size_src, uint8_t* dst, size_t size_dst);
+
+#endif
@@ -0,0 +1,91 @@
+/*!
+ * \file packedFile.h
+ * \author Akhatar Abdelhamid <abdelhamid.akhatar@etu.cyu.fr>
+ * \version 1.0
+ * \date November 2, 2025
+ * \brief Interface for the block-compressed binary files
+ * 
+ * A packed file holds a version 2 file (plain or compact) cut into blocks
+ * of PACK_DEFAULT_BLOCK bytes, each compressed alone with the LZ codec:
+ * - a PackHeader
+ * - one PackBlock per block, giving where it is and its sizes
+ * - the compressed blocks, one after the other
+ * A block that does not get smaller is stored as is. Since the blocks are
+ * independent, they are compressed and decompressed on all the cores.
+ * 
+ * load_prom_binary recognizes a packed file by its magic number.
+ */
+
+#ifndef PACKEDFILE_H
+#define PACKEDFILE_H
+
+#include "structures.h"
+#include <stdint.h>
+
+/*! \brief Magic number of a packed file ("PRMZ" in little-endian order) */
+#define PACK_MAGIC 0x5A4D5250u
+
+/*! \brief Current version of the packed container */
+#define PACK_VERSION 1
+
+#ifndef PACK_DEFAULT_BLOCK
+/*! \brief Size of the blocks of a packed file (bytes) */
+#define PACK_DEFAULT_BLOCK (64 << 10)
+#endif
+
+/*! \brief Largest block accepted when loading (bytes) */
+#define PACK_MAX_BLOCK (64 << 20)
+
+/*!
+ * \struct PackHeader
+ * \brief Header of a packed file
+ */
+typedef struct
+{
+    uint32_t int_magic;       /*!< PACK_MAGIC */
+    uint32_t int_version;     /*!< PACK_VERSION */
+    uint32_t size_block;      /*!< Size of every block but the last one (bytes) */
+    uint32_t int_nb_blocks;   /*!< Number of blocks */
+    uint64_t size_raw;        /*!< Size of the version 2 file once decompressed (bytes) */
+} PackHeader;
+
+/*!
+ * \struct PackBlock
+ * \brief Entry of the block table of a packed file
+ */
+typedef struct
+{
+    uint64_t size_offset;     /*!< Position of the compressed block in the file */
+    uint32_t size_packed;     /*!< Size of the compressed block, equal to size_raw if stored as is */
+    uint32_t size_raw;        /*!< Size of the block once decompressed */
+} PackBlock;
+
+/*!
+ * \fn int save_prom_binary_packed(const char* str_filename, Prom* prom, int int_compact)
+ * \brief Saves a complete cohort to a packed binary file
+ * \param str_filename Name of the destination binary file
+ * \param prom Pointer to the Prom structure to save
+ * \param int_compact 1 to pack a compact version 2 file, 0 for a plain one
+ * \return 0 if success, -1 in case of error
+ * \pre str_filename != NULL
+ * \pre prom != NULL
+ * 
+ * The version 2 file is first written in memory, then compressed block
+ * by block in parallel.
+ */
+int save_prom_binary_packed(const char* str_filename, Prom* prom, int int_compact);
+
+/*!
+ * \fn Prom load_prom_packed(const char* str_filename)
+ * \brief Restores a cohort from a packed binary file
+ * \param str_filename Name of the source binary file
+ * \return Restored Prom structure, or empty structure in case of error
+ * \pre str_filename != NULL
+ * 
+ * The blocks are decompressed in parallel into one anonymous mapping,
+ * which the promotion then uses as if it were the mapped version 2 file.
+ * Every size and offset of the container is checked.
+ */
+Prom load_prom_packed(const char* str_filename);
+
+#endif
@@ -0,0 +1,65 @@
+/*!
+ * \file promFile.h
+ * \author Akhatar Abdelhamid <abdelhamid.akhatar@etu.cyu.fr>
+ * \version 1.0
+ * \date November 2, 2025
+ * \brief Interface for the point query module of binary files
+ * 
+ * This file contains the prototypes of functions opening a version 2
+ * binary file once and reading single students by identifier through
+ * its student index, without loading the whole promotion.
+ */
+
+#ifndef PROMFILE_H
+#define PROMFILE_H
+
+#include "init.h"
+#include "binaryFormat.h"
+
+/*!
+ * \struct PromFile
+ * \brief Version 2 binary file opened for point queries
+ */
+typedef struct
+{
+    PromImage image;          /*!< Mapped file, sections checked */
+    CourseCatalog catalog;    /*!< Courses of the file, IDs as in the file */
+} PromFile;
+
+/*!
+ * \fn int open_prom_file(const char* str_filename, PromFile* file)
+ * \brief Opens a version 2 binary file for point queries
+ * \param str_filename Name of the file
+ * \param file Pointer to the PromFile structure to fill
+ * \return 0 on success, -1 if the file is not a version 2 file with a student index
+ * \pre str_filename != NULL
+ * \pre file != NULL
+ * 
+ * Only the header, the section table and the catalog are read: the cost
+ * does not depend on the number of students.
+ */
+int open_prom_file(const char* str_filename, PromFile* file);
+
+/*!
+ * \fn void close_prom_file(PromFile* file)
+ * \brief Closes a binary file opened for point queries
+ * \param file Pointer to the PromFile structure
+ * \pre file != NULL
+ */
+void close_prom_file(PromFile* file);
+
+/*!
+ * \fn int read_prom_file_student(const PromFile* file, int int_id, Student* student)
+ * \brief Reads one student of the file by identifier (O(log n))
+ * \param file Pointer to the opened file
+ * \param int_id Identifier of the student
+ * \param student Pointer to the Student structure to fill, to destroy with destroy_student
+ * \return 0 on success, -1 if the identifier is unknown, its records are invalid or on allocation error
+ * \pre file != NULL
+ * \pre student != NULL
+ * 
+ * The course IDs of the student refer to file->catalog.
+ */
+int read_prom_file_student(const PromFile* file, int int_id, Student* student);
+
+#endif
@@ -10,6 +10,7 @@
  */
 
 #include "init.h"
+#include "fieldParser.h"
 #include <stdlib.h>
 #include <string.h> 
 #include <stdio.h>
@@ -18,39 +19,148 @@
 #define READ_H
 
 /*!
- * \fn char* read_line(FILE* file)
- * \brief Reads a complete line from a file
+ * \def LINE_READER_BLOCK_SIZE
+ * \brief Size in bytes of the block buffer filled by a LineReader
+ */
+#ifndef LINE_READER_BLOCK_SIZE
+#define LINE_READER_BLOCK_SIZE (64 * 1024)
+#endif
+
+/*!
+ * \struct Line
+ * \brief Non-owning view on one line of text (without its newline)
+ *
+ * The text is NUL-terminated and stays valid until the next call
+ * to read_next_line() on the reader that produced it.
+ */
+typedef struct
+{
+    const char* char_text;    /*!< First character of the line */
+    size_t size_len;          /*!< Number of characters in the line */
+} Line;
+
+/*!
+ * \struct LineReader
+ * \brief Block-buffered reader handing out lines without allocation
+ *
+ * The file is read by blocks of LINE_READER_BLOCK_SIZE bytes. The buffer
+ * only grows when a single line does not fit in it.
+ */
+typedef struct
+{
+    FILE* file;               /*!< Source file */
+    char* char_buffer;        /*!< Block buffer */
+    size_t size_capacity;     /*!< Allocated size of the buffer */
+    size_t size_start;        /*!< Offset of the first unread byte */
+    size_t size_end;          /*!< Offset past the last valid byte */
+    int int_eof;              /*!< 1 once the whole file has been read */
+    int int_nb_lines;         /*!< Number of lines handed out, i.e. number of the last line read */
+} LineReader;
+
+/*!
+ * \fn int create_line_reader(LineReader* reader, FILE* file)
+ * \brief Initializes a line reader on an open file
+ * \param reader Pointer to the LineReader to initialize
  * \param file Pointer to the file to read
- * \return Pointer to the read string (dynamic allocation) or NULL if end of file
+ * \return 0 on success, -1 if the block buffer cannot be allocated
+ * \pre reader != NULL
  * \pre file != NULL
  */
-char* read_line(FILE* file);
+int create_line_reader(LineReader* reader, FILE* file);
+
+/*!
+ * \fn void destroy_line_reader(LineReader* reader)
+ * \brief Frees the block buffer of a line reader (the file is not closed)
+ * \param reader Pointer to the LineReader to destroy
+ * \pre reader != NULL
+ */
+void destroy_line_reader(LineReader* reader);
+
+/*!
+ * \fn int read_next_line(LineReader* reader, Line* line)
+ * \brief Reads the next line of the file
+ * \param reader Pointer to the LineReader
+ * \param line Pointer to the Line view to fill
+ * \return 1 if a line was read, 0 at end of file or on error
+ * \pre reader != NULL
+ * \pre line != NULL
+ */
+int read_next_line(LineReader* reader, Line* line);
 
 /*!
- * \fn char* get_to_type(FILE* file, char* type)
+ * \fn int get_to_type(LineReader* reader, const char* type, Line* line)
  * \brief Navigates through the file until finding a section separator
- * \param file Pointer to the file to read
+ * \param reader Pointer to the LineReader
  * \param type Name of the section to find (e.g., "ETUDIANTS", "MATIERES", "NOTES")
- * \return Pointer to the first data line after the separator
- * \pre file != NULL
+ * \param line Pointer to the Line view receiving the first data line after the separator
+ * \return 1 if the section and a first data line were found, 0 otherwise
+ * \pre reader != NULL
  * \pre type != NULL
+ * \pre line != NULL
+ */
+int get_to_type(LineReader* reader, const char* type, Line* line);
+
+/*!
+ * \fn int parse_student_view(Arena* arena, const char* text, size_t len, Student* student)
+ * \brief Parses a line view "id;firstname;lastname;age" into a Student structure without courses
+ * \param arena Pointer to the arena receiving the names (NULL: heap)
+ * \param text First character of the line (not necessarily NUL-terminated)
+ * \param len Length of the line
+ * \param student Pointer to the Student structure to fill, only on success
+ * \return PARSE_OK, the PARSE_ error code of the line, or PARSE_NO_MEMORY (-1) if a name cannot be copied
+ * \pre text != NULL
+ * \pre student != NULL
+ */
+int parse_student_view(Arena* arena, const char* text, size_t len, Student* student);
+
+/*!
+ * \fn int parse_course_view(const char* text, size_t len, CourseCatalog* catalog, int* int_course_id)
+ * \brief Parses a line view "name;coefficient" and adds the course to a catalog
+ * \param text First character of the line (not necessarily NUL-terminated)
+ * \param len Length of the line
+ * \param catalog Pointer to the catalog receiving the course
+ * \param int_course_id Pointer receiving the ID of the course, -1 on allocation error
+ * \return PARSE_OK, the PARSE_ error code of the line (the catalog is then unchanged),
+ *         or PARSE_NO_MEMORY (-1) if the course cannot be added to the catalog
+ * \pre text != NULL
+ * \pre catalog != NULL
+ * \pre int_course_id != NULL
+ * 
+ * A name already in the catalog keeps its ID and its first coefficient.
+ */
+int parse_course_view(const char* text, size_t len, CourseCatalog* catalog, int* int_course_id);
+
+/*!
+ * \fn int parse_grade_view(const char* text, size_t len, int* int_student_id, const char** course_name, size_t* size_course_len, float* float_grade)
+ * \brief Splits a line view "id;course;grade" into its fields
+ * \param text First character of the line (not necessarily NUL-terminated)
+ * \param len Length of the line
+ * \param int_student_id Pointer receiving the student identifier
+ * \param course_name Pointer receiving the first character of the course name, inside the line
+ * \param size_course_len Pointer receiving the length of the course name
+ * \param float_grade Pointer receiving the grade
+ * \return PARSE_OK or the PARSE_ error code of the line
+ * \pre text != NULL
  */
-char* get_to_type(FILE* file, char* type);
+int parse_grade_view(const char* text, size_t len, int* int_student_id, const char** course_name,
+                     size_t* size_course_len, float* float_grade);
 
 /*!
- * \fn Course parse_course_line(const char* line)
- * \brief Parses a data line to create a Course structure
+ * \fn int parse_course_line(const char* line, CourseCatalog* catalog)
+ * \brief Parses a data line and adds the course to a catalog
  * \param line Line to parse in format "name;coefficient"
- * \return Course structure created from the line
+ * \param catalog Pointer to the catalog receiving the course
+ * \return ID of the course in the catalog, or -1 on error
  * \pre line != NULL
+ * \pre catalog != NULL
  */
-Course parse_course_line(const char* line);
+int parse_course_line(const char* line, CourseCatalog* catalog);
 
 /*!
  * \fn Student parse_student_line(const char* line)
  * \brief Parses a data line to create a Student structure
  * \param line Line to parse in format "id;firstname;lastname;age"
- * \return Student structure created from the line
+ * \return Student structure created from the line, with identifier 0 and no names if the line is invalid
  * \pre line != NULL
  */
 Student parse_student_line(const char* line);
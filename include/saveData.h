@@ -10,39 +10,143 @@
  */
 
 #include "read.h"
+#include "threadPool.h"
 #include <stdio.h>
 #include <stdlib.h>
 
 #ifndef SAVEDATA_H
 #define SAVEDATA_H
 
+#ifndef CONVERT_DEFAULT_BUDGET
+/*! \brief Default memory budget of the grades of a conversion (bytes) */
+#define CONVERT_DEFAULT_BUDGET (64 * 1024 * 1024)
+#endif
+
+#ifndef NOTES_CHUNK_SIZE
+/*! \brief Size of the pieces of the NOTES section parsed by one task of a parallel load (bytes) */
+#define NOTES_CHUNK_SIZE (64 * 1024)
+#endif
+
+#ifndef PIPELINE_QUEUE_BATCHES
+/*! \brief Number of batches each queue of the loading pipeline holds before its producer waits */
+#define PIPELINE_QUEUE_BATCHES 4
+#endif
+
+#ifndef PIPELINE_MIN_SIZE
+/*! \brief Size of the rest of the data file from which get_all_grades uses the loading pipeline (bytes) */
+#define PIPELINE_MIN_SIZE (4 * NOTES_CHUNK_SIZE)
+#endif
+
+/*! \brief Maximum number of parser threads of the loading pipeline */
+#define PIPELINE_MAX_PARSERS 16
+
+#ifndef CONVERT_MAX_BUCKETS
+/*! \brief Maximum number of bucket files a conversion keeps open at once (a bucket over the budget is split again later) */
+#define CONVERT_MAX_BUCKETS 256
+#endif
+
 /*!
- * \fn Prom get_all_students(FILE* file)
+ * \fn void get_all_students(LineReader* reader, Prom* prom)
  * \brief Loads all students from a file
- * \param file Pointer to the file containing the data
- * \return Prom structure containing all loaded students
- * \pre file != NULL
+ * \param reader Pointer to the reader of the file containing the data
+ * \param prom Pointer to the Prom structure to fill
+ * \pre reader != NULL
+ * \pre prom != NULL
  */
-void get_all_students(FILE* file, Prom* prom);
+void get_all_students(LineReader* reader, Prom* prom);
 
 /*!
- * \fn void get_all_courses(FILE* file, Prom* prom)
+ * \fn void get_all_courses(LineReader* reader, Prom* prom)
  * \brief Loads all courses and assigns them to each student
- * \param file Pointer to the file containing the data
+ * \param reader Pointer to the reader of the file containing the data
  * \param prom Pointer to the Prom structure to fill
- * \pre file != NULL
+ * \pre reader != NULL
  * \pre prom != NULL
  */
-void get_all_courses(FILE* file, Prom* prom);
+void get_all_courses(LineReader* reader, Prom* prom);
 
 /*!
- * \fn void get_all_grades(FILE* file, Prom* prom)
+ * \fn void get_all_grades(LineReader* reader, Prom* prom)
  * \brief Loads all grades and assigns them to student courses
- * \param file Pointer to the file containing the data
+ * \param reader Pointer to the reader of the file containing the data
+ * \param prom Pointer to the Prom structure to fill
+ * \pre reader != NULL
+ * \pre prom != NULL
+ *
+ * When at least PIPELINE_MIN_SIZE bytes of the file remain, the grades
+ * are loaded by get_all_grades_pipelined with one parser per spare
+ * processor; smaller files are read on the calling thread.
+ */
+void get_all_grades(LineReader* reader, Prom* prom);
+
+/*!
+ * \fn int get_all_grades_pipelined(LineReader* reader, Prom* prom, int int_nb_parsers)
+ * \brief Loads all grades like get_all_grades, reading, parsing and inserting them on separate threads
+ * \param reader Pointer to the reader of the file containing the data
  * \param prom Pointer to the Prom structure to fill
- * \pre file != NULL
+ * \param int_nb_parsers Number of parser threads (0 or less: one less than the online processors)
+ * \return 0 on success, -1 on allocation error (some grades may then be missing)
+ * \pre reader != NULL
  * \pre prom != NULL
+ *
+ * A reader thread cuts the NOTES section into batches of about
+ * NOTES_CHUNK_SIZE bytes and deals them to the parser threads in turn.
+ * The calling thread inserts the parsed batches, taking the parsers in the
+ * same turn: the grades, warnings and averages are those of get_all_grades.
+ * The stages are connected by single-producer single-consumer queues of
+ * PIPELINE_QUEUE_BATCHES batches, so that reading and parsing overlap with
+ * a bounded memory use. If no thread can be started, the grades are loaded
+ * on the calling thread.
+ */
+int get_all_grades_pipelined(LineReader* reader, Prom* prom, int int_nb_parsers);
+
+/*!
+ * \fn int load_prom_mapped(const char* str_filename, Prom* prom)
+ * \brief Loads students, courses and grades by mapping the data file in memory
+ * \param str_filename Name of the data file
+ * \param prom Pointer to the Prom structure to fill
+ * \return 0 on success, -1 on error
+ * \pre str_filename != NULL
+ * \pre prom != NULL
+ *
+ * The ETUDIANTS, MATIERES and NOTES sections are located in a single scan,
+ * in any order, then parsed in place without copying the file.
+ */
+int load_prom_mapped(const char* str_filename, Prom* prom);
+
+/*!
+ * \fn int load_prom_mapped_parallel(const char* str_filename, Prom* prom, ThreadPool* pool)
+ * \brief Loads students, courses and grades by mapping the data file, parsing the grades on a thread pool
+ * \param str_filename Name of the data file
+ * \param prom Pointer to the Prom structure to fill
+ * \param pool Pointer to the thread pool (NULL: same as load_prom_mapped)
+ * \return 0 on success, -1 on error
+ * \pre str_filename != NULL
+ * \pre prom != NULL
+ *
+ * The NOTES section is cut at line boundaries into pieces of about
+ * NOTES_CHUNK_SIZE bytes. Each task parses its pieces into its own array
+ * of resolved grades, without any lock; the calling thread then appends
+ * them piece after piece. The grades of each course, the warnings and the
+ * averages are therefore the same as with load_prom_mapped.
+ */
+int load_prom_mapped_parallel(const char* str_filename, Prom* prom, ThreadPool* pool);
+
+/*!
+ * \fn int convert_text_to_binary(const char* str_text, const char* str_binary, size_t size_budget)
+ * \brief Converts a data file to a version 1 binary file without loading its grades at once
+ * \param str_text Name of the data file
+ * \param str_binary Name of the binary file
+ * \param size_budget Memory budget of the grades (bytes), 0 for CONVERT_DEFAULT_BUDGET
+ * \return 0 on success, -1 in case of error (no binary file is then left)
+ * \pre str_text != NULL
+ * \pre str_binary != NULL
+ *
+ * Only the students and the catalog are held in memory. The grades are
+ * spilled to temporary bucket files by range of students, then each bucket
+ * is loaded, averaged and written in turn. The file is the same as the one
+ * written by save_prom_binary_v1 after load_prom_mapped.
  */
-void get_all_grades(FILE* file, Prom* prom);
+int convert_text_to_binary(const char* str_text, const char* str_binary, size_t size_budget);
 
 #endif
\ No newline at end of file
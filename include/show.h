@@ -23,18 +23,20 @@
 void show_grades(Grades grades);
 
 /*!
- * \fn void show_course(Course course)
+ * \fn void show_course(Course course, const CourseCatalog* catalog)
  * \brief Displays complete information about a course
  * \param course Course structure to display
+ * \param catalog Catalog holding the name and coefficient of the course
  */
-void show_course(Course course);
+void show_course(Course course, const CourseCatalog* catalog);
 
 /*!
- * \fn void show_student(Student student)
+ * \fn void show_student(Student student, const CourseCatalog* catalog)
  * \brief Displays complete information about a student
  * \param student Student structure to display
+ * \param catalog Catalog of the courses of the promotion
  */
-void show_student(Student student);
+void show_student(Student student, const CourseCatalog* catalog);
 
 /*!
  * \fn void show_student_info(Student student)
@@ -51,13 +53,24 @@ void show_student_info(Student student);
 void show_prom(Prom prom);
 
 /*!
-* \fn void show_best(Student* students, int n)
+* \fn void show_best(const Prom* prom, int n)
 * \brief Displays the n best students of a promotion
-* \param students Array of students
-* \param n Number of students to display
+* \param prom Pointer to the promotion
+* \param n Number of students to display (clamped to the number of students)
 * 
-* Displays the n students with the highest averages
+* Displays the n students with the highest averages, selected in O(n log k)
+* by select_best_students without sorting the promotion
 */
-void show_best(Student* students, int n);
+void show_best(const Prom* prom, int n);
+
+/*!
+* \fn void show_best_in_course(const Prom* prom, const char* course_name, const int* positions, int n)
+* \brief Displays the best students of a course
+* \param prom Pointer to the Prom structure
+* \param course_name Name of the course
+* \param positions Positions of the students to display, best first (see sort_students_from_course)
+* \param n Number of positions
+*/
+void show_best_in_course(const Prom* prom, const char* course_name, const int* positions, int n);
 
 #endif
\ No newline at end of file
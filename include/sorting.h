@@ -14,27 +14,111 @@
 
 #include "init.h"
 
+/*!
+* \fn int* rank_students_by_average(const Prom* prom)
+* \brief Computes the positions of the students by descending average
+* 
+* Equal averages are ordered by increasing identifier. The sort is a
+* merge sort in O(n log n) and does not move the students.
+* 
+* \param prom Pointer to the Prom structure containing students
+* \return Array of int_nb_students positions to free by the caller, NULL on error
+*/
+int* rank_students_by_average(const Prom* prom);
+
+/*!
+* \fn int select_best_students(const Prom* prom, int course_id, int k, int* positions)
+* \brief Selects the k best students without sorting nor reordering the promotion
+* 
+* A bounded heap keeps the k best students seen so far, in O(n log k).
+* Equal averages are ordered by increasing identifier. Students who do
+* not follow the course are skipped.
+* 
+* \param prom Pointer to the Prom structure containing students
+* \param course_id ID of the course in the catalog, or -1 for the overall average
+* \param k Number of students wanted
+* \param positions Array of at least k entries receiving the positions, best first
+* \return Number of positions written (at most k), or -1 on invalid parameters or allocation error
+*/
+int select_best_students(const Prom* prom, int course_id, int k, int* positions);
+
 /*!
 * \fn void sort_students_by_average(Prom* prom)
-* \brief Sorts students by descending average
+* \brief Ranks students by descending average
 * 
-* This function sorts the student array of a promotion
-* in descending order of average using selection sort algorithm.
+* This function stores in prom->tab_ranking the positions of the students
+* by descending average. The student array stays in place.
 * 
 * \param prom Pointer to the Prom structure containing students
 */
 void sort_students_by_average(Prom* prom);
 
 /*!
-* \fn void sort_students_from_course(Prom* prom, char* course_name)
-* \brief Sorts students by average in a specific course
+* \fn void clear_student_ranking(Prom* prom)
+* \brief Forgets the ranking of the students once it no longer matches them
+* 
+* Called when students are added or removed and when averages are updated.
+* 
+* \param prom Pointer to the Prom structure containing students
+*/
+void clear_student_ranking(Prom* prom);
+
+/*!
+* \fn int build_course_ranking(Prom* prom)
+* \brief Ranks the students of each course by descending course average
+* 
+* Built once after the averages are computed. Equal averages are ordered
+* by increasing identifier. The ranking is cleared when students are added
+* or removed and when course averages are updated.
+* 
+* \param prom Pointer to the Prom structure containing students
+* \return 0 on success, -1 on allocation error
+*/
+int build_course_ranking(Prom* prom);
+
+/*!
+* \fn void clear_course_ranking(Prom* prom)
+* \brief Forgets the course ranking once it no longer matches the students
+* \param prom Pointer to the Prom structure containing students
+*/
+void clear_course_ranking(Prom* prom);
+
+/*!
+* \fn int get_course_top(const Prom* prom, int course_id, int k, int* positions)
+* \brief Copies the positions of the k best students of a course (O(k))
+* \param prom Pointer to the Prom structure, with a course ranking
+* \param course_id ID of the course in the catalog
+* \param k Number of students wanted
+* \param positions Array of at least k entries receiving the positions, best first
+* \return Number of positions copied (at most k), or -1 if the ranking or the course is missing
+*/
+int get_course_top(const Prom* prom, int course_id, int k, int* positions);
+
+/*!
+* \fn int get_course_rank(const Prom* prom, int course_id, int position)
+* \brief Returns the rank of a student in a course (O(1))
+* \param prom Pointer to the Prom structure, with a course ranking
+* \param course_id ID of the course in the catalog
+* \param position Position of the student in the promotion
+* \return Rank of the student (0 for the best), or -1 if the student does not follow the course
+*         or if the ranking is missing
+*/
+int get_course_rank(const Prom* prom, int course_id, int position);
+
+/*!
+* \fn int sort_students_from_course(Prom* prom, const char* course_name, int k, int* positions)
+* \brief Returns the k best students in a specific course
 * 
-* This function sorts students in a promotion according to
-* their average in a given course and displays the top three.
+* This function builds the course ranking if it is missing and copies
+* the positions of the k best students of the course, best first.
 * 
 * \param prom Pointer to the Prom structure containing students
-* \param course_name Name of the course for sorting
+* \param course_name Name of the course
+* \param k Number of students wanted
+* \param positions Array of at least k entries receiving the positions
+* \return Number of positions copied (at most k), or -1 on invalid parameters,
+*         unknown course or allocation error
 */
-void sort_students_from_course(Prom* prom, char* course_name);
+int sort_students_from_course(Prom* prom, const char* course_name, int k, int* positions);
 
-#endif
\ No newline at end of file
+#endif
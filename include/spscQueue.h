@@ -0,0 +1,91 @@
+/*!
+ * \file spscQueue.h
+ * \author Akhatar Abdelhamid <abdelhamid.akhatar@etu.cyu.fr>
+ * \version 1.0
+ * \date November 2, 2025
+ * \brief Interface for the single-producer single-consumer queue module
+ * 
+ * This file contains the prototypes of a bounded lock-free queue of
+ * pointers between exactly two threads: one pushing, one popping. It
+ * connects the stages of a pipeline: a full queue makes the producer
+ * wait for the consumer (backpressure), an empty one makes the consumer
+ * wait for the producer. Waiting threads spin briefly, then yield.
+ */
+
+#ifndef SPSCQUEUE_H
+#define SPSCQUEUE_H
+
+/*!
+ * \def SPSC_SPIN_COUNT
+ * \brief Number of failed attempts before a waiting thread yields the processor
+ */
+#ifndef SPSC_SPIN_COUNT
+#define SPSC_SPIN_COUNT 64
+#endif
+
+/*!
+ * \typedef SpscQueue
+ * \brief Opaque single-producer single-consumer queue structure
+ */
+typedef struct SpscQueue SpscQueue;
+
+/*!
+ * \fn SpscQueue* create_spsc_queue(int int_capacity)
+ * \brief Creates an empty queue
+ * \param int_capacity Minimum number of items the queue holds (rounded up to a power of two)
+ * \return Pointer to the queue, or NULL on allocation error
+ * \pre int_capacity > 0
+ */
+SpscQueue* create_spsc_queue(int int_capacity);
+
+/*!
+ * \fn void destroy_spsc_queue(SpscQueue* queue)
+ * \brief Frees a queue (the items left in it are not freed)
+ * \param queue Pointer to the queue (may be NULL)
+ */
+void destroy_spsc_queue(SpscQueue* queue);
+
+/*!
+ * \fn int try_push_spsc_queue(SpscQueue* queue, void* item)
+ * \brief Adds an item to a queue if it is not full
+ * \param queue Pointer to the queue
+ * \param item Item to add (may be NULL)
+ * \return 1 if the item was added, 0 if the queue is full
+ * \pre queue != NULL
+ * 
+ * Only the producer thread may call this function and push_spsc_queue.
+ */
+int try_push_spsc_queue(SpscQueue* queue, void* item);
+
+/*!
+ * \fn int try_pop_spsc_queue(SpscQueue* queue, void** item)
+ * \brief Removes the oldest item of a queue if it is not empty
+ * \param queue Pointer to the queue
+ * \param item Pointer receiving the item
+ * \return 1 if an item was removed, 0 if the queue is empty
+ * \pre queue != NULL
+ * \pre item != NULL
+ * 
+ * Only the consumer thread may call this function and pop_spsc_queue.
+ */
+int try_pop_spsc_queue(SpscQueue* queue, void** item);
+
+/*!
+ * \fn void push_spsc_queue(SpscQueue* queue, void* item)
+ * \brief Adds an item to a queue, waiting while it is full
+ * \param queue Pointer to the queue
+ * \param item Item to add (may be NULL)
+ * \pre queue != NULL
+ */
+void push_spsc_queue(SpscQueue* queue, void* item);
+
+/*!
+ * \fn void* pop_spsc_queue(SpscQueue* queue)
+ * \brief Removes the oldest item of a queue, waiting while it is empty
+ * \param queue Pointer to the queue
+ * \return The item
+ * \pre queue != NULL
+ */
+void* pop_spsc_queue(SpscQueue* queue);
+
+#endif
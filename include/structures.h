@@ -12,29 +12,84 @@
 #ifndef STRUCTURES_H
 #define STRUCTURES_H
 
+#include <stddef.h>
+
+/*!
+ * \typedef Arena
+ * \brief Region allocator owning the memory of a promotion (defined in arena.h)
+ */
+typedef struct Arena Arena;
+
+/*!
+ * \typedef LazyPages
+ * \brief Paging state of a lazily loaded promotion (defined in lazyLoad.h)
+ */
+typedef struct LazyPages LazyPages;
+
+#ifndef GRADES_INLINE_CAPACITY
+/*! \brief Number of grades kept inside a Grades structure (with 8, a Course takes 64 bytes) */
+#define GRADES_INLINE_CAPACITY 8
+#endif
+
+#if GRADES_INLINE_CAPACITY < 1
+#error "GRADES_INLINE_CAPACITY must be at least 1"
+#endif
+
 /*!
  * \struct Grades
  * \brief Structure representing a set of grades
+ * 
+ * Up to GRADES_INLINE_CAPACITY grades are kept in tab_inline, without
+ * allocation; tab_grades is then NULL. Beyond that, tab_grades holds them
+ * (allocated, or borrowed from a columnar store or a mapped file).
+ * get_grades_data returns the array in use.
  */
 typedef struct 
 {
-    float* tab_grades;        /*!< Dynamic array of grades */
+    float* tab_grades;        /*!< Dynamic array of grades, NULL when they are stored inline */
     int int_nb_grades;        /*!< Number of grades in the array */
+    int int_max_grades;       /*!< Allocated size of the array (number of grades) */
+    float tab_inline[GRADES_INLINE_CAPACITY]; /*!< Grades of a small course */
 } Grades;
 
 /*!
  * \struct Course
- * \brief Structure representing a course (subject)
+ * \brief Structure representing a course (subject) followed by a student
+ * 
+ * The name and the coefficient are shared by all students and stored
+ * once in the CourseCatalog of the promotion.
  */
 typedef struct 
 {
     Grades grades;            /*!< Grades for the course */
-    char *char_course_name;   /*!< Name of the course */
-    float float_coef;         /*!< Coefficient of the course */
+    int int_course_id;        /*!< Identifier of the course in the catalog */
     float float_average;      /*!< Average grade for the course */
     int int_nb_grades;        /*!< Number of grades */
 } Course;
 
+/*!
+ * \struct CourseInfo
+ * \brief Structure describing a course of the catalog
+ */
+typedef struct
+{
+    char *char_course_name;   /*!< Name of the course */
+    float float_coef;         /*!< Coefficient of the course */
+} CourseInfo;
+
+/*!
+ * \struct CourseCatalog
+ * \brief Interned courses of a promotion, identified by a dense ID
+ */
+typedef struct
+{
+    CourseInfo *info_courses; /*!< Dynamic array of courses, indexed by course ID */
+    int int_nb_courses;       /*!< Number of courses */
+    int int_max_courses;      /*!< Allocated size of the courses array */
+    int *tab_slots;           /*!< Hash table of course IDs by name, -1 if the slot is empty */
+    int int_capacity;         /*!< Number of slots (power of two) */
+} CourseCatalog;
+
 /*!
  * \struct Student
  * \brief Structure representing a student
@@ -46,10 +101,69 @@ typedef struct
     char *char_first_name;    /*!< First name */
     int int_age;              /*!< Age of the student */
     int int_nb_courses;       /*!< Number of courses taken */
+    int int_max_courses;      /*!< Allocated size of the courses array */
     Course *course_courses;   /*!< Dynamic array of courses */
     float float_average;      /*!< Overall average of the student */
 } Student;
 
+/*!
+ * \struct StudentSlot
+ * \brief Slot of the student index (open addressing)
+ */
+typedef struct
+{
+    int int_id;               /*!< Identifier of the student */
+    int int_position;         /*!< Position in the students array, -1 if the slot is empty */
+} StudentSlot;
+
+/*!
+ * \struct StudentIndex
+ * \brief Hash index from a student identifier to its position in the cohort
+ */
+typedef struct
+{
+    StudentSlot *slot_slots;  /*!< Dynamic array of slots (power of two size) */
+    int int_capacity;         /*!< Number of slots */
+    int int_nb_entries;       /*!< Number of occupied slots */
+} StudentIndex;
+
+/*!
+ * \struct GradeStore
+ * \brief Columnar storage of all the grades of a promotion (CSR layout)
+ * 
+ * The grades of course slot k are tab_grades[tab_course_offsets[k]] to
+ * tab_grades[tab_course_offsets[k + 1] - 1]. The course slots of the student
+ * at position i are tab_student_offsets[i] to tab_student_offsets[i + 1] - 1,
+ * in the order of the student's course array.
+ */
+typedef struct
+{
+    float *tab_grades;        /*!< Contiguous array of all grades */
+    int *tab_course_offsets;  /*!< First grade of each course slot (int_nb_slots + 1 entries) */
+    int *tab_student_offsets; /*!< First course slot of each student (int_nb_students + 1 entries) */
+    int int_nb_students;      /*!< Number of students */
+    int int_nb_slots;         /*!< Number of course slots (all students) */
+    int int_nb_grades;        /*!< Number of grades */
+    int int_borrowed;         /*!< 1 if the arrays belong to the mapped file of the promotion */
+} GradeStore;
+
+/*!
+ * \struct CourseRanking
+ * \brief Students of each course of the catalog by descending course average
+ * 
+ * The positions of the students following course c, best first, are
+ * tab_positions[tab_course_offsets[c]] to tab_positions[tab_course_offsets[c + 1] - 1].
+ * The rank of the student at position i in course c is tab_ranks[i * int_nb_courses + c].
+ */
+typedef struct
+{
+    int *tab_positions;       /*!< Positions of the students, course by course, best first */
+    int *tab_course_offsets;  /*!< First position of each course (int_nb_courses + 1 entries) */
+    int *tab_ranks;           /*!< Rank of each student in each course, -1 if the student does not follow it */
+    int int_nb_courses;       /*!< Number of courses of the catalog when the ranking was built */
+    int int_nb_students;      /*!< Number of students when the ranking was built */
+} CourseRanking;
+
 /*!
  * \struct Prom
  * \brief Structure representing a student cohort
@@ -57,7 +171,18 @@ typedef struct
 typedef struct 
 {
     int int_nb_students;      /*!< Number of students in the cohort */
+    int int_max_students;     /*!< Allocated size of the students array */
     Student *student_students; /*!< Dynamic array of students */
+    StudentIndex index;       /*!< Index of the students by identifier */
+    CourseCatalog catalog;    /*!< Courses shared by all students */
+    GradeStore *store_grades; /*!< Columnar grade storage, NULL if the grades are stored per course */
+    int int_nb_unknown_ids;   /*!< Number of grades ignored for an unknown student identifier */
+    Arena *arena_memory;      /*!< Arena owning the names, courses and grades, NULL if they are allocated one by one */
+    int *tab_ranking;         /*!< Positions of the students by descending average, NULL if not ranked */
+    CourseRanking *ranking_courses; /*!< Ranking of the students in each course, NULL if not built */
+    void *ptr_mapping;        /*!< Mapped binary file holding names and grades of the students, NULL if none */
+    size_t size_mapping;      /*!< Size of the mapped binary file */
+    LazyPages *lazy_pages;    /*!< Paging state if the courses are read on demand, NULL if they are all loaded */
 } Prom;
 
 
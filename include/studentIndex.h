@@ -0,0 +1,79 @@
+/*!
+ * \file studentIndex.h
+ * \author Akhatar Abdelhamid <abdelhamid.akhatar@etu.cyu.fr>
+ * \version 1.0
+ * \date November 2, 2025
+ * \brief Interface for the student index module
+ * 
+ * This file contains the prototypes of functions maintaining a hash index
+ * (open addressing) from a student identifier to its position in a cohort,
+ * and of functions adding and removing students while keeping it in sync.
+ */
+
+#ifndef STUDENTINDEX_H
+#define STUDENTINDEX_H
+
+#include "init.h"
+
+/*!
+ * \fn int build_student_index(Prom* prom)
+ * \brief Builds (or rebuilds) the index of all students of a cohort
+ * \param prom Pointer to the Prom structure to index
+ * \return 0 on success, -1 on allocation error
+ * \pre prom != NULL
+ * 
+ * When several students share an identifier, the first one is indexed.
+ */
+int build_student_index(Prom* prom);
+
+/*!
+ * \fn void destroy_student_index(StudentIndex* index)
+ * \brief Frees the memory allocated for a student index
+ * \param index Pointer to the StudentIndex structure to destroy
+ * \pre index != NULL
+ */
+void destroy_student_index(StudentIndex* index);
+
+/*!
+ * \fn int find_student_position(const Prom* prom, int int_id)
+ * \brief Finds the position of a student in the cohort in O(1)
+ * \param prom Pointer to the indexed Prom structure
+ * \param int_id Identifier of the student
+ * \return Position in prom->student_students, or -1 if the identifier is unknown
+ * \pre prom != NULL
+ */
+int find_student_position(const Prom* prom, int int_id);
+
+/*!
+ * \fn Student* find_student_by_id(const Prom* prom, int int_id)
+ * \brief Finds a student of the cohort by identifier in O(1)
+ * \param prom Pointer to the indexed Prom structure
+ * \param int_id Identifier of the student
+ * \return Pointer to the student, or NULL if the identifier is unknown
+ * \pre prom != NULL
+ */
+Student* find_student_by_id(const Prom* prom, int int_id);
+
+/*!
+ * \fn int add_student_to_prom(Prom* prom, Student student)
+ * \brief Appends a student to the cohort and indexes it
+ * \param prom Pointer to the Prom structure
+ * \param student Student to add (the cohort takes ownership)
+ * \return 0 on success, -1 if the identifier already exists or on allocation error
+ * \pre prom != NULL
+ */
+int add_student_to_prom(Prom* prom, Student student);
+
+/*!
+ * \fn int remove_student_from_prom(Prom* prom, int int_id)
+ * \brief Destroys a student of the cohort and removes it from the index
+ * \param prom Pointer to the Prom structure
+ * \param int_id Identifier of the student to remove
+ * \return 0 on success, -1 if the identifier is unknown
+ * \pre prom != NULL
+ * 
+ * The last student of the array takes the place of the removed one.
+ */
+int remove_student_from_prom(Prom* prom, int int_id);
+
+#endif
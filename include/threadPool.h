@@ -0,0 +1,70 @@
+/*!
+ * \file threadPool.h
+ * \author Akhatar Abdelhamid <abdelhamid.akhatar@etu.cyu.fr>
+ * \version 1.0
+ * \date November 2, 2025
+ * \brief Interface for the thread pool module
+ * 
+ * This file contains the prototypes of a small pthreads pool running a
+ * task over a range of items split in chunks. Each thread first takes the
+ * chunks of its own part of the range, then steals the chunks left in the
+ * parts of the other threads, so that uneven chunks do not leave cores idle.
+ */
+
+#ifndef THREADPOOL_H
+#define THREADPOOL_H
+
+/*!
+ * \typedef ThreadPool
+ * \brief Opaque thread pool structure
+ */
+typedef struct ThreadPool ThreadPool;
+
+/*!
+ * \typedef ThreadTask
+ * \brief Function processing the items [int_begin, int_end[ of a range
+ */
+typedef void (*ThreadTask)(void* context, int int_begin, int int_end);
+
+/*!
+ * \fn ThreadPool* create_thread_pool(int int_nb_threads)
+ * \brief Creates a pool of threads
+ * \param int_nb_threads Number of threads working on a task, the calling thread included
+ *        (0 or less: number of online processors)
+ * \return Pointer to the pool, or NULL on error
+ */
+ThreadPool* create_thread_pool(int int_nb_threads);
+
+/*!
+ * \fn void destroy_thread_pool(ThreadPool* pool)
+ * \brief Stops the threads and frees the pool
+ * \param pool Pointer to the pool (may be NULL)
+ */
+void destroy_thread_pool(ThreadPool* pool);
+
+/*!
+ * \fn int get_thread_pool_size(const ThreadPool* pool)
+ * \brief Returns the number of threads working on a task, the calling thread included
+ * \param pool Pointer to the pool
+ * \return Number of threads
+ * \pre pool != NULL
+ */
+int get_thread_pool_size(const ThreadPool* pool);
+
+/*!
+ * \fn void run_thread_pool(ThreadPool* pool, int int_nb_items, int int_chunk, ThreadTask task, void* context)
+ * \brief Runs a task over the items [0, int_nb_items[ and waits for its completion
+ * \param pool Pointer to the pool
+ * \param int_nb_items Number of items
+ * \param int_chunk Number of items processed per call of the task (0 or less: automatic)
+ * \param task Function processing a chunk of items
+ * \param context Pointer passed to the task
+ * \pre pool != NULL
+ * \pre task != NULL
+ * 
+ * The calling thread takes part in the work. Chunks may be processed in any
+ * order, and the task must be safe to run concurrently on distinct chunks.
+ */
+void run_thread_pool(ThreadPool* pool, int int_nb_items, int int_chunk, ThreadTask task, void* context);
+
+#endif
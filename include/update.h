@@ -13,6 +13,7 @@
 #include <string.h> 
 #include <stdio.h>
 #include "init.h"
+#include "threadPool.h"
 
 #ifndef UPDATE_H
 #define UPDATE_H
@@ -33,4 +34,16 @@ void update_student_average(Prom* prom);
  */
 void update_course_average(Prom* prom);
 
+/*!
+ * \fn void update_averages_parallel(Prom* prom, ThreadPool* pool)
+ * \brief Updates the course and overall averages of all students with a thread pool
+ * \param prom Pointer to the Prom structure containing the students
+ * \param pool Pointer to the thread pool (NULL: serial update)
+ * \pre prom != NULL
+ * 
+ * Students are processed in chunks claimed by the threads of the pool, so
+ * the result is the same as update_course_average then update_student_average.
+ */
+void update_averages_parallel(Prom* prom, ThreadPool* pool);
+
 #endif
\ No newline at end of file
@@ -0,0 +1,343 @@
+/*!
+ * \file arena.c
+ * \author Akhatar Abdelhamid <abdelhamid.akhatar@etu.cyu.fr>
+ * \version 1.0
+ * \date November 2, 2025
+ * \brief Arena allocator module
+ * 
+ * This file contains the implementation of the arena allocator: a list of
+ * blocks filled by bumping an offset, released all together.
+ */
+
+#include "arena.h"
+#include <stdlib.h>
+#include <string.h>
+
+/*!
+ * \struct ArenaBlock
+ * \brief Block of memory of an arena
+ */
+struct ArenaBlock
+{
+    ArenaBlock* block_next;   /*!< Next (full) block */
+    size_t size_capacity;     /*!< Number of bytes of the data area */
+    size_t size_used;         /*!< Number of bytes handed out */
+    _Alignas(ARENA_ALIGNMENT) char data[]; /*!< Data area */
+};
+
+/*!
+ * \fn static size_t align_size(size_t size)
+ * \brief Rounds a size up to the alignment of the arena
+ * \param size Number of bytes
+ * \return Aligned number of bytes
+ */
+static size_t align_size(size_t size)
+{
+    return ((size + ARENA_ALIGNMENT - 1) & ~(size_t)(ARENA_ALIGNMENT - 1));
+}
+
+/*!
+ * \fn static size_t array_class(size_t size)
+ * \brief Returns the size class of a growable array
+ * \param size Number of bytes of the array
+ * \return Power of two at least equal to size (ARENA_MIN_ARRAY at least), 0 for an empty array
+ */
+static size_t array_class(size_t size)
+{
+    size_t capacity;
+    
+    if (size == 0)
+    {
+        return (0);
+    }
+    capacity = ARENA_MIN_ARRAY;
+    while (capacity < size)
+    {
+        capacity <<= 1;
+    }
+    
+    return (capacity);
+}
+
+/*!
+ * \fn static ArenaBlock* add_block(Arena* arena, size_t size)
+ * \brief Adds a block able to hold an allocation
+ * \param arena Pointer to the arena
+ * \param size Number of bytes of the allocation
+ * \return Pointer to the new block, or NULL on allocation error
+ * 
+ * A regular block becomes the head of the list. An allocation larger than
+ * a regular block gets a block of its own, placed behind the head so that
+ * the free space of the head stays available.
+ */
+static ArenaBlock* add_block(Arena* arena, size_t size)
+{
+    ArenaBlock* block;
+    size_t capacity;
+    
+    capacity = (size > arena->size_block ? size : arena->size_block);
+    block = (ArenaBlock*)malloc(sizeof(ArenaBlock) + capacity);
+    if (block == NULL)
+    {
+        return (NULL);
+    }
+    block->size_capacity = capacity;
+    block->size_used = 0;
+    
+    if (capacity > arena->size_block && arena->block_head != NULL)
+    {
+        block->block_next = arena->block_head->block_next;
+        arena->block_head->block_next = block;
+    }
+    else
+    {
+        block->block_next = arena->block_head;
+        arena->block_head = block;
+    }
+    arena->size_reserved += capacity;
+    arena->int_nb_blocks++;
+    
+    return (block);
+}
+
+/*!
+ * \fn Arena* create_arena(size_t size_block)
+ * \brief Creates an empty arena
+ * \param size_block Size of a regular block (0: ARENA_BLOCK_SIZE)
+ * \return Pointer to the arena, or NULL on allocation error
+ */
+Arena* create_arena(size_t size_block)
+{
+    Arena* arena;
+    
+    arena = (Arena*)malloc(sizeof(Arena));
+    if (arena == NULL)
+    {
+        return (NULL);
+    }
+    arena->block_head = NULL;
+    arena->size_block = align_size(size_block > 0 ? size_block : ARENA_BLOCK_SIZE);
+    arena->size_reserved = 0;
+    arena->size_used = 0;
+    arena->size_released = 0;
+    arena->int_nb_blocks = 0;
+    
+    return (arena);
+}
+
+/*!
+ * \fn void destroy_arena(Arena* arena)
+ * \brief Frees all the blocks of an arena at once
+ * \param arena Pointer to the arena
+ */
+void destroy_arena(Arena* arena)
+{
+    ArenaBlock* block;
+    ArenaBlock* next;
+    
+    if (arena == NULL)
+    {
+        return;
+    }
+    for (block = arena->block_head; block != NULL; block = next)
+    {
+        next = block->block_next;
+        free(block);
+    }
+    free(arena);
+}
+
+/*!
+ * \fn void* arena_alloc(Arena* arena, size_t size)
+ * \brief Allocates memory in an arena
+ * \param arena Pointer to the arena (NULL: malloc)
+ * \param size Number of bytes
+ * \return Pointer to the memory, or NULL on allocation error
+ */
+void* arena_alloc(Arena* arena, size_t size)
+{
+    ArenaBlock* block;
+    void* ptr;
+    
+    if (arena == NULL)
+    {
+        return (malloc(size));
+    }
+    
+    size = align_size(size > 0 ? size : 1);
+    
+    /* Bump the offset of the head block, or start a new block */
+    block = arena->block_head;
+    if (block == NULL || block->size_capacity - block->size_used < size)
+    {
+        block = add_block(arena, size);
+        if (block == NULL)
+        {
+            return (NULL);
+        }
+    }
+    ptr = block->data + block->size_used;
+    block->size_used += size;
+    arena->size_used += size;
+    
+    return (ptr);
+}
+
+/*!
+ * \fn char* arena_strdup(Arena* arena, const char* str)
+ * \brief Duplicates a string in an arena
+ * \param arena Pointer to the arena (NULL: strdup)
+ * \param str String to duplicate
+ * \return Pointer to the copy, or NULL on allocation error
+ */
+char* arena_strdup(Arena* arena, const char* str)
+{
+    char* copy;
+    size_t len;
+    
+    if (arena == NULL)
+    {
+        return (strdup(str));
+    }
+    
+    len = strlen(str) + 1;
+    copy = (char*)arena_alloc(arena, len);
+    if (copy != NULL)
+    {
+        memcpy(copy, str, len);
+    }
+    
+    return (copy);
+}
+
+/*!
+ * \fn char* arena_strndup(Arena* arena, const char* text, size_t size_len)
+ * \brief Copies a string view to a NUL-terminated string in an arena
+ * \param arena Pointer to the arena (NULL: malloc)
+ * \param text First character of the view
+ * \param size_len Number of characters of the view
+ * \return Pointer to the copy, or NULL on allocation error
+ */
+char* arena_strndup(Arena* arena, const char* text, size_t size_len)
+{
+    char* copy;
+    
+    copy = (char*)arena_alloc(arena, size_len + 1);
+    if (copy != NULL)
+    {
+        memcpy(copy, text, size_len);
+        copy[size_len] = '\0';
+    }
+    
+    return (copy);
+}
+
+/*!
+ * \fn void arena_free(Arena* arena, void* ptr, size_t size)
+ * \brief Gives back memory allocated by arena_alloc or arena_strdup
+ * \param arena Pointer to the arena (NULL: free)
+ * \param ptr Pointer to the memory
+ * \param size Number of bytes allocated
+ */
+void arena_free(Arena* arena, void* ptr, size_t size)
+{
+    if (arena == NULL)
+    {
+        free(ptr);
+        return;
+    }
+    if (ptr != NULL)
+    {
+        arena->size_released += align_size(size > 0 ? size : 1);
+    }
+}
+
+/*!
+ * \fn void* arena_grow(Arena* arena, void* ptr, size_t size_old, size_t size_new)
+ * \brief Resizes a growable array of an arena
+ * \param arena Pointer to the arena (NULL: realloc)
+ * \param ptr Pointer to the array
+ * \param size_old Current size of the array (bytes)
+ * \param size_new New size of the array (bytes, 0 releases the array)
+ * \return Pointer to the array, NULL when released or on allocation error
+ */
+void* arena_grow(Arena* arena, void* ptr, size_t size_old, size_t size_new)
+{
+    size_t class_old;
+    size_t class_new;
+    void* new_ptr;
+    
+    if (arena == NULL)
+    {
+        if (size_new == 0)
+        {
+            free(ptr);
+            return (NULL);
+        }
+        return (realloc(ptr, size_new));
+    }
+    
+    class_old = (ptr != NULL ? array_class(size_old) : 0);
+    class_new = array_class(size_new);
+    
+    /* Still room in the size class (or shrinking): stay in place */
+    if (class_new != 0 && class_new <= class_old)
+    {
+        return (ptr);
+    }
+    
+    /* Move the array to a larger class */
+    new_ptr = NULL;
+    if (class_new != 0)
+    {
+        new_ptr = arena_alloc(arena, class_new);
+        if (new_ptr == NULL)
+        {
+            return (NULL);
+        }
+        if (ptr != NULL && size_old > 0)
+        {
+            memcpy(new_ptr, ptr, size_old);
+        }
+    }
+    if (class_old != 0)
+    {
+        arena->size_released += class_old;
+    }
+    
+    return (new_ptr);
+}
+
+/*!
+ * \fn ArenaStats get_arena_stats(const Arena* arena)
+ * \brief Returns the statistics of an arena
+ * \param arena Pointer to the arena
+ * \return Statistics of the arena
+ */
+ArenaStats get_arena_stats(const Arena* arena)
+{
+    ArenaStats stats;
+    const ArenaBlock* block;
+    
+    memset(&stats, 0, sizeof(ArenaStats));
+    if (arena == NULL)
+    {
+        return (stats);
+    }
+    
+    stats.size_reserved = arena->size_reserved;
+    stats.size_used = arena->size_used - arena->size_released;
+    stats.size_wasted = arena->size_released;
+    stats.int_nb_blocks = arena->int_nb_blocks;
+    
+    /* The unused end of a full block is lost */
+    if (arena->block_head != NULL)
+    {
+        for (block = arena->block_head->block_next; block != NULL; block = block->block_next)
+        {
+            stats.size_wasted += block->size_capacity - block->size_used;
+        }
+    }
+    
+    return (stats);
+}
@@ -0,0 +1,228 @@
+/*!
+ * \file asyncSave.c
+ * \author Akhatar Abdelhamid <abdelhamid.akhatar@etu.cyu.fr>
+ * \version 1.0
+ * \date November 2, 2025
+ * \brief Background save module
+ * 
+ * This file contains the implementation of the background save: the
+ * version 2 writers fill an in-memory stream, and a thread writes the
+ * resulting buffer to a temporary file before renaming it.
+ */
+
+#include "asyncSave.h"
+#include "binary.h"
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+/*!
+ * \struct AsyncSave
+ * \brief Background save structure
+ */
+struct AsyncSave
+{
+    pthread_t thread;         /*!< Thread writing the file */
+    char* str_filename;       /*!< Name of the destination file */
+    char* str_temporary;      /*!< Name of the temporary file */
+    char* char_data;          /*!< Snapshot: the whole version 2 file */
+    size_t size_data;         /*!< Size of the snapshot */
+    int int_result;           /*!< 0 if the file was replaced, -1 otherwise (read after the join) */
+    atomic_int int_done;      /*!< 1 once the thread has finished */
+};
+
+/*! \brief Number of saves started, to name their temporary files */
+static atomic_int int_nb_saves;
+
+/*!
+ * \fn static int write_all(int fd, const char* data, size_t size)
+ * \brief Writes a buffer to a file descriptor, resuming partial writes
+ * \param fd File descriptor
+ * \param data Buffer
+ * \param size Size of the buffer
+ * \return 0 on success, -1 on write error
+ */
+static int write_all(int fd, const char* data, size_t size)
+{
+    ssize_t size_written;
+    
+    while (size > 0)
+    {
+        size_written = write(fd, data, size);
+        if (size_written < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            return (-1);
+        }
+        data += size_written;
+        size -= size_written;
+    }
+    
+    return (0);
+}
+
+/*!
+ * \fn static void* write_snapshot(void* arg)
+ * \brief Thread writing a snapshot to its temporary file, then renaming it and syncing its directory
+ * \param arg Pointer to the AsyncSave
+ * \return NULL
+ */
+static void* write_snapshot(void* arg)
+{
+    AsyncSave* save;
+    int fd;
+    int result;
+    
+    save = (AsyncSave*)arg;
+    result = -1;
+    fd = open(save->str_temporary, O_WRONLY | O_CREAT | O_EXCL, 0666);
+    if (fd >= 0)
+    {
+        /* On disk before the rename, so that the new name never points to missing data */
+        if (write_all(fd, save->char_data, save->size_data) == 0 && fsync(fd) == 0)
+        {
+            result = 0;
+        }
+        if (close(fd) != 0)
+        {
+            result = -1;
+        }
+        if (result == 0 && rename(save->str_temporary, save->str_filename) != 0)
+        {
+            result = -1;
+        }
+        if (result != 0)
+        {
+            unlink(save->str_temporary);
+        }
+        /* The new name itself is on disk only once its directory is synced */
+        else if (sync_parent_directory(save->str_filename) != 0)
+        {
+            result = -1;
+        }
+    }
+    
+    /* The snapshot is no longer needed */
+    free(save->char_data);
+    save->char_data = NULL;
+    save->int_result = result;
+    atomic_store(&save->int_done, 1);
+    
+    return (NULL);
+}
+
+/*!
+ * \fn static void free_async_save(AsyncSave* save)
+ * \brief Frees a background save whose thread is finished or was never started
+ * \param save Pointer to the save
+ */
+static void free_async_save(AsyncSave* save)
+{
+    free(save->str_filename);
+    free(save->str_temporary);
+    free(save->char_data);
+    free(save);
+}
+
+/*!
+ * \fn AsyncSave* start_save_prom_binary(const char* str_filename, Prom* prom, int int_compact)
+ * \brief Takes a snapshot of a promotion and starts writing it on a background thread
+ * \param str_filename Name of the destination binary file
+ * \param prom Pointer to the Prom structure to save
+ * \param int_compact 1 for a compact version 2 file, 0 for a plain one
+ * \return Pointer to the save, or NULL in case of error
+ * 
+ * The whole file is encoded here, on the calling thread: the promotion is
+ * neither locked nor copied, so the snapshot must be complete before the
+ * caller may touch it again.
+ */
+AsyncSave* start_save_prom_binary(const char* str_filename, Prom* prom, int int_compact)
+{
+    AsyncSave* save;
+    FILE* memory;
+    size_t size_name;
+    int result;
+    
+    /* Parameter verification */
+    if (str_filename == NULL || prom == NULL)
+    {
+        return (NULL);
+    }
+    
+    save = (AsyncSave*)calloc(1, sizeof(AsyncSave));
+    if (save == NULL)
+    {
+        return (NULL);
+    }
+    atomic_init(&save->int_done, 0);
+    
+    /* Unique temporary name next to the file, so that the rename stays on one file system */
+    size_name = strlen(str_filename) + 48;
+    save->str_filename = strdup(str_filename);
+    save->str_temporary = (char*)malloc(size_name);
+    if (save->str_filename == NULL || save->str_temporary == NULL)
+    {
+        free_async_save(save);
+        return (NULL);
+    }
+    snprintf(save->str_temporary, size_name, "%s.%ld.%d.tmp", str_filename, (long)getpid(),
+             atomic_fetch_add(&int_nb_saves, 1));
+    
+    /* Snapshot: the version 2 file, written to memory */
+    memory = open_memstream(&save->char_data, &save->size_data);
+    if (memory == NULL)
+    {
+        free_async_save(save);
+        return (NULL);
+    }
+    result = (int_compact ? write_prom_binary_compact(memory, prom) : write_prom_binary(memory, prom));
+    if (fclose(memory) != 0 || result != 0)
+    {
+        free_async_save(save);
+        return (NULL);
+    }
+    
+    if (pthread_create(&save->thread, NULL, write_snapshot, save) != 0)
+    {
+        free_async_save(save);
+        return (NULL);
+    }
+    
+    return (save);
+}
+
+/*!
+ * \fn int is_async_save_done(const AsyncSave* save)
+ * \brief Tells whether a background save is finished, without waiting
+ * \param save Pointer to the save
+ * \return 1 if finished, 0 if still running
+ */
+int is_async_save_done(const AsyncSave* save)
+{
+    return (atomic_load(&save->int_done));
+}
+
+/*!
+ * \fn int wait_async_save(AsyncSave* save)
+ * \brief Waits for the end of a background save and frees it
+ * \param save Pointer to the save
+ * \return 0 if the file was replaced, -1 in case of error
+ */
+int wait_async_save(AsyncSave* save)
+{
+    int result;
+    
+    pthread_join(save->thread, NULL);
+    result = save->int_result;
+    free_async_save(save);
+    
+    return (result);
+}
@@ -6,200 +6,1713 @@
  * \brief Binary save/restore module for student cohorts
  * 
  * This file contains the implementation of functions allowing to save
- * and restore a complete cohort in a binary file.
+ * and restore a complete cohort in a binary file. Version 2 files (see
+ * binaryFormat.h) are mapped and used in place; version 1 files, a
+ * headerless stream of fields, are still read.
  */
 
 #include "binary.h"
 #include "init.h"
+#include "studentIndex.h"
+#include "courseCatalog.h"
+#include "arena.h"
+#include "gradeStore.h"
+#include "binaryFormat.h"
+#include "lazyLoad.h"
+#include "update.h"
+#include "packedFile.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+/*! \brief Size of the stdio buffer of a saved file (bytes) */
+#define BIN_WRITE_BUFFER (1 << 20)
 
 /*!
- * \fn int save_prom_binary(const char* str_filename, Prom* prom)
- * \brief Saves a complete cohort to a binary file
- * \param str_filename Name of the destination binary file
+ * \fn static void put_v1(unsigned char* buffer, size_t* size_pos, const void* data, size_t size)
+ * \brief Copies a field to the buffer of a version 1 file
+ * \param buffer Buffer of the file
+ * \param size_pos Pointer to the position in the buffer, updated
+ * \param data First byte of the field
+ * \param size Size of the field
+ */
+static void put_v1(unsigned char* buffer, size_t* size_pos, const void* data, size_t size)
+{
+    memcpy(buffer + *size_pos, data, size);
+    *size_pos += size;
+}
+
+/*!
+ * \fn static void put_v1_string(unsigned char* buffer, size_t* size_pos, const char* str)
+ * \brief Copies a name (length with its NUL, then characters) to the buffer of a version 1 file
+ * \param buffer Buffer of the file
+ * \param size_pos Pointer to the position in the buffer, updated
+ * \param str Name
+ */
+static void put_v1_string(unsigned char* buffer, size_t* size_pos, const char* str)
+{
+    int str_len;
+    
+    str_len = strlen(str) + 1;
+    put_v1(buffer, size_pos, &str_len, sizeof(int));
+    put_v1(buffer, size_pos, str, str_len);
+}
+
+/*!
+ * \fn static int get_v1_size(const Prom* prom, size_t* size_file)
+ * \brief Computes the size of the student records of the version 1 file of a cohort
+ * \param prom Pointer to the Prom structure to save
+ * \param size_file Pointer receiving the size of the records
+ * \return 0 on success, -1 if a student cannot be paged in
+ */
+static int get_v1_size(const Prom* prom, size_t* size_file)
+{
+    const Student* student;
+    const Course* course;
+    int i;
+    int j;
+    
+    *size_file = 0;
+    for (i = 0; i < prom->int_nb_students; i++)
+    {
+        student = &prom->student_students[i];
+        if (page_student_courses(prom, i) != 0)
+        {
+            return (-1);
+        }
+        
+        /* Identifier, age, average, number of courses, then the names */
+        *size_file += 6 * sizeof(int) + strlen(student->char_last_name) + strlen(student->char_first_name) + 2;
+        for (j = 0; j < student->int_nb_courses; j++)
+        {
+            course = &student->course_courses[j];
+            
+            /* Coefficient, average, name, then the grades */
+            *size_file += 2 * sizeof(float) + 2 * sizeof(int)
+                          + strlen(prom->catalog.info_courses[course->int_course_id].char_course_name) + 1
+                          + course->grades.int_nb_grades * sizeof(float);
+        }
+    }
+    
+    return (0);
+}
+
+/*!
+ * \fn int write_prom_binary_v1(FILE* file, Prom* prom, int int_header)
+ * \brief Writes a cohort in the version 1 layout to an open file, in one write
+ * \param file Destination file
  * \param prom Pointer to the Prom structure to save
+ * \param int_header 1 to start with the number of students, 0 for the student records only
  * \return 0 if success, -1 in case of error
  */
-int save_prom_binary(const char* str_filename, Prom* prom)
+int write_prom_binary_v1(FILE* file, Prom* prom, int int_header)
 {
-    FILE* file;
+    unsigned char* buffer;
+    size_t size_buffer;
+    size_t size_pos;
+    int result;
     int i;
     int j;
-    int str_len;
     
-    /* Parameter verification */
-    if (str_filename == NULL || prom == NULL)
+    /* The records are built in one buffer, then written at once */
+    if (get_v1_size(prom, &size_buffer) != 0)
     {
         return (-1);
     }
-    
-    /* Open file in binary write mode */
-    file = fopen(str_filename, "wb");
-    if (file == NULL)
+    buffer = (unsigned char*)malloc(size_buffer + sizeof(int));
+    if (buffer == NULL)
     {
         return (-1);
     }
+    size_pos = 0;
     
-    /* Write the number of students in the cohort */
-    fwrite(&prom->int_nb_students, sizeof(int), 1, file);
+    /* Number of students in the cohort */
+    if (int_header)
+    {
+        put_v1(buffer, &size_pos, &prom->int_nb_students, sizeof(int));
+    }
     
     /* Loop through all students */
     for (i = 0; i < prom->int_nb_students; i++)
     {
         Student* student = &prom->student_students[i];
         
-        /* Write student's basic information */
-        fwrite(&student->int_id, sizeof(int), 1, file);
-        fwrite(&student->int_age, sizeof(int), 1, file);
-        fwrite(&student->float_average, sizeof(float), 1, file);
-        fwrite(&student->int_nb_courses, sizeof(int), 1, file);
-        
-        /* Write last name (length + string) */
-        str_len = strlen(student->char_last_name) + 1;
-        fwrite(&str_len, sizeof(int), 1, file);
-        fwrite(student->char_last_name, sizeof(char), str_len, file);
+        /* Page the courses of a lazily loaded student in */
+        if (page_student_courses(prom, i) != 0)
+        {
+            free(buffer);
+            return (-1);
+        }
         
-        /* Write first name (length + string) */
-        str_len = strlen(student->char_first_name) + 1;
-        fwrite(&str_len, sizeof(int), 1, file);
-        fwrite(student->char_first_name, sizeof(char), str_len, file);
+        /* Student's basic information and names */
+        put_v1(buffer, &size_pos, &student->int_id, sizeof(int));
+        put_v1(buffer, &size_pos, &student->int_age, sizeof(int));
+        put_v1(buffer, &size_pos, &student->float_average, sizeof(float));
+        put_v1(buffer, &size_pos, &student->int_nb_courses, sizeof(int));
+        put_v1_string(buffer, &size_pos, student->char_last_name);
+        put_v1_string(buffer, &size_pos, student->char_first_name);
         
         /* Loop through all student's courses */
         for (j = 0; j < student->int_nb_courses; j++)
         {
             Course* course = &student->course_courses[j];
+            CourseInfo* info = &prom->catalog.info_courses[course->int_course_id];
             
-            /* Write course information */
-            fwrite(&course->float_coef, sizeof(float), 1, file);
-            fwrite(&course->float_average, sizeof(float), 1, file);
-            
-            /* Write course name (length + string) */
-            str_len = strlen(course->char_course_name) + 1;
-            fwrite(&str_len, sizeof(int), 1, file);
-            fwrite(course->char_course_name, sizeof(char), str_len, file);
-            
-            /* Write number of grades */
-            fwrite(&course->grades.int_nb_grades, sizeof(int), 1, file);
-            
-            /* Write all course grades */
+            /* Course information, then all course grades */
+            put_v1(buffer, &size_pos, &info->float_coef, sizeof(float));
+            put_v1(buffer, &size_pos, &course->float_average, sizeof(float));
+            put_v1_string(buffer, &size_pos, info->char_course_name);
+            put_v1(buffer, &size_pos, &course->grades.int_nb_grades, sizeof(int));
             if (course->grades.int_nb_grades > 0)
             {
-                fwrite(course->grades.tab_grades, sizeof(float), 
-                       course->grades.int_nb_grades, file);
+                put_v1(buffer, &size_pos, get_grades_data(&course->grades), course->grades.int_nb_grades * sizeof(float));
             }
         }
     }
     
-    /* Close file */
-    fclose(file);
+    result = (fwrite(buffer, 1, size_pos, file) == size_pos ? 0 : -1);
+    free(buffer);
     
-    return (0);
+    return (result);
 }
 
 /*!
- * \fn Prom load_prom_binary(const char* str_filename)
- * \brief Restores a cohort from a binary file
- * \param str_filename Name of the source binary file
- * \return Restored Prom structure, or empty structure in case of error
+ * \fn int sync_parent_directory(const char* str_filename)
+ * \brief Syncs the directory of a file, so that a rename to its name is on disk
+ * \param str_filename Name of the file
+ * \return 0 on success, -1 in case of error
  */
-Prom load_prom_binary(const char* str_filename)
+int sync_parent_directory(const char* str_filename)
+{
+    char* str_directory;
+    const char* slash;
+    int fd;
+    int result;
+    
+    slash = strrchr(str_filename, '/');
+    if (slash == NULL)
+    {
+        str_directory = strdup(".");
+    }
+    else
+    {
+        str_directory = strndup(str_filename, slash > str_filename ? (size_t)(slash - str_filename) : 1);
+    }
+    if (str_directory == NULL)
+    {
+        return (-1);
+    }
+    
+    fd = open(str_directory, O_RDONLY | O_DIRECTORY);
+    free(str_directory);
+    if (fd < 0)
+    {
+        return (-1);
+    }
+    result = (fsync(fd) == 0 ? 0 : -1);
+    if (close(fd) != 0)
+    {
+        result = -1;
+    }
+    
+    return (result);
+}
+
+/*!
+ * \fn FILE* open_replacement(const char* str_filename, char** str_temporary)
+ * \brief Opens the temporary file "<name>.tmp" receiving the new content of a file
+ * \param str_filename Name of the file to replace
+ * \param str_temporary Pointer receiving the name of the temporary file, to give to close_replacement
+ * \return Temporary file opened in binary write mode, or NULL in case of error
+ */
+FILE* open_replacement(const char* str_filename, char** str_temporary)
 {
     FILE* file;
-    Prom prom;
-    int i;
-    int j;
-    int str_len;
-    char buffer[256];
+    size_t size_name;
+    
+    size_name = strlen(str_filename) + 5;
+    *str_temporary = (char*)malloc(size_name);
+    if (*str_temporary == NULL)
+    {
+        return (NULL);
+    }
+    snprintf(*str_temporary, size_name, "%s.tmp", str_filename);
+    
+    file = fopen(*str_temporary, "wb");
+    if (file == NULL)
+    {
+        free(*str_temporary);
+        *str_temporary = NULL;
+    }
+    
+    return (file);
+}
+
+/*!
+ * \fn int close_replacement(FILE* file, char* str_temporary, const char* str_filename, int result)
+ * \brief Syncs and closes a temporary file, then renames it over the file it replaces
+ * \param file Temporary file opened by open_replacement
+ * \param str_temporary Name of the temporary file, freed
+ * \param str_filename Name of the file to replace
+ * \param result 0 if the content was written, -1 to drop the temporary file
+ * \return 0 on success, -1 in case of error
+ */
+int close_replacement(FILE* file, char* str_temporary, const char* str_filename, int result)
+{
+    /* On disk before the rename, so that the name never points to missing data */
+    if (result == 0 && (fflush(file) != 0 || fsync(fileno(file)) != 0))
+    {
+        result = -1;
+    }
+    if (fclose(file) != 0)
+    {
+        result = -1;
+    }
+    if (result == 0 && rename(str_temporary, str_filename) != 0)
+    {
+        result = -1;
+    }
+    if (result != 0)
+    {
+        remove(str_temporary);
+    }
+    else
+    {
+        result = sync_parent_directory(str_filename);
+    }
+    free(str_temporary);
+    
+    return (result);
+}
+
+/*!
+ * \fn static int save_to_file(const char* str_filename, Prom* prom, int (*write)(FILE*, Prom*), size_t size_buffer)
+ * \brief Writes a cohort to a temporary file with a writer, then renames it over a binary file
+ * \param str_filename Name of the destination binary file
+ * \param prom Pointer to the Prom structure to save
+ * \param write Writer of the layout
+ * \param size_buffer Size of the stdio buffer of the file, 0 for an unbuffered file
+ * \return 0 if success, -1 in case of error (the old file is then left as is)
+ * 
+ * The promotion may read its names and grades from a mapping of the old
+ * file: the old file is replaced, never truncated.
+ */
+static int save_to_file(const char* str_filename, Prom* prom, int (*write)(FILE*, Prom*), size_t size_buffer)
+{
+    FILE* file;
+    char* str_temporary;
+    char* buffer;
+    int result;
     
     /* Parameter verification */
-    if (str_filename == NULL)
+    if (str_filename == NULL || prom == NULL)
     {
-        prom.int_nb_students = 0;
-        prom.student_students = NULL;
-        return (prom);
+        return (-1);
     }
     
-    /* Open file in binary read mode */
-    file = fopen(str_filename, "rb");
+    file = open_replacement(str_filename, &str_temporary);
     if (file == NULL)
     {
-        printf("Error: Cannot open binary file %s\n", str_filename);
-        prom.int_nb_students = 0;
-        prom.student_students = NULL;
-        return (prom);
+        return (-1);
+    }
+    
+    /* Buffered, the sections leave in a few large writes; unbuffered, one buffer leaves in one write */
+    buffer = NULL;
+    if (size_buffer == 0)
+    {
+        setvbuf(file, NULL, _IONBF, 0);
+    }
+    else if ((buffer = (char*)malloc(size_buffer)) != NULL)
+    {
+        setvbuf(file, buffer, _IOFBF, size_buffer);
+    }
+    result = write(file, prom);
+    
+    result = close_replacement(file, str_temporary, str_filename, result);
+    free(buffer);
+    
+    return (result);
+}
+
+/*!
+ * \fn static int write_v1_file(FILE* file, Prom* prom)
+ * \brief Writes a complete cohort as a version 1 binary file, with its student count
+ * \param file Destination file
+ * \param prom Pointer to the Prom structure to save
+ * \return 0 if success, -1 in case of error
+ */
+static int write_v1_file(FILE* file, Prom* prom)
+{
+    return (write_prom_binary_v1(file, prom, 1));
+}
+
+/*!
+ * \fn int save_prom_binary_v1(const char* str_filename, Prom* prom)
+ * \brief Saves a complete cohort to a version 1 binary file
+ * \param str_filename Name of the destination binary file
+ * \param prom Pointer to the Prom structure to save
+ * \return 0 if success, -1 in case of error
+ */
+int save_prom_binary_v1(const char* str_filename, Prom* prom)
+{
+    return (save_to_file(str_filename, prom, write_v1_file, 0));
+}
+
+/*!
+ * \fn static int get_v1(const unsigned char* buffer, size_t size_buffer, size_t* size_pos, void* data, size_t size)
+ * \brief Copies a field out of the buffer of a version 1 file
+ * \param buffer Buffer of the file
+ * \param size_buffer Size of the file
+ * \param size_pos Pointer to the position in the buffer, updated
+ * \param data Destination of the field
+ * \param size Size of the field
+ * \return 0 on success, -1 if the file ends first
+ */
+static int get_v1(const unsigned char* buffer, size_t size_buffer, size_t* size_pos, void* data, size_t size)
+{
+    if (size > size_buffer - *size_pos)
+    {
+        return (-1);
     }
+    memcpy(data, buffer + *size_pos, size);
+    *size_pos += size;
     
-    /* Read number of students */
-    fread(&prom.int_nb_students, sizeof(int), 1, file);
+    return (0);
+}
+
+/*!
+ * \fn static const char* get_v1_string(const unsigned char* buffer, size_t size_buffer, size_t* size_pos, size_t* size_len)
+ * \brief Locates a name in the buffer of a version 1 file
+ * \param buffer Buffer of the file
+ * \param size_buffer Size of the file
+ * \param size_pos Pointer to the position in the buffer, updated
+ * \param size_len Pointer receiving the length of the name, without its NUL
+ * \return The NUL-terminated name inside the buffer, or NULL if it does not lie in the file
+ */
+static const char* get_v1_string(const unsigned char* buffer, size_t size_buffer, size_t* size_pos, size_t* size_len)
+{
+    const char* str;
+    int str_len;
     
-    /* Allocate student array */
-    prom.student_students = (Student*)malloc(prom.int_nb_students * sizeof(Student));
-    if (prom.student_students == NULL)
+    if (get_v1(buffer, size_buffer, size_pos, &str_len, sizeof(int)) != 0
+        || str_len <= 0 || (size_t)str_len > size_buffer - *size_pos)
     {
-        fclose(file);
-        prom.int_nb_students = 0;
-        return (prom);
+        return (NULL);
+    }
+    
+    /* Any length: the name is only accepted if it ends with its NUL */
+    str = (const char*)buffer + *size_pos;
+    if (str[str_len - 1] != '\0')
+    {
+        return (NULL);
+    }
+    *size_pos += str_len;
+    *size_len = strlen(str);
+    
+    return (str);
+}
+
+/*!
+ * \fn static int parse_prom_v1(const unsigned char* buffer, size_t size_buffer, Prom* prom)
+ * \brief Rebuilds a cohort from the buffer of a version 1 file
+ * \param buffer Buffer of the file
+ * \param size_buffer Size of the file
+ * \param prom Pointer to the empty arena Prom structure to fill
+ * \return 0 on success, -1 if the file is invalid or on allocation error
+ * 
+ * On error the students already read are kept in prom, to destroy.
+ */
+static int parse_prom_v1(const unsigned char* buffer, size_t size_buffer, Prom* prom)
+{
+    const char* str;
+    size_t size_pos;
+    size_t size_len;
+    int nb_students;
+    int nb_grades;
+    int i;
+    int j;
+    float coef;
+    
+    size_pos = 0;
+    
+    /* Number of students: each one takes 6 int and 2 NUL at least */
+    if (get_v1(buffer, size_buffer, &size_pos, &nb_students, sizeof(int)) != 0
+        || nb_students < 0 || (size_t)nb_students > size_buffer / (6 * sizeof(int) + 2))
+    {
+        return (-1);
     }
+    free(prom->student_students);
+    prom->student_students = (Student*)malloc((nb_students > 0 ? nb_students : 1) * sizeof(Student));
+    prom->int_max_students = 0;
+    if (prom->student_students == NULL)
+    {
+        return (-1);
+    }
+    prom->int_max_students = (nb_students > 0 ? nb_students : 1);
     
     /* Loop through all students */
-    for (i = 0; i < prom.int_nb_students; i++)
+    for (i = 0; i < nb_students; i++)
     {
-        Student* student = &prom.student_students[i];
+        Student* student = &prom->student_students[i];
         
-        /* Read student's basic information */
-        fread(&student->int_id, sizeof(int), 1, file);
-        fread(&student->int_age, sizeof(int), 1, file);
-        fread(&student->float_average, sizeof(float), 1, file);
-        fread(&student->int_nb_courses, sizeof(int), 1, file);
+        memset(student, 0, sizeof(Student));
+        prom->int_nb_students = i + 1;
         
-        /* Read last name */
-        fread(&str_len, sizeof(int), 1, file);
-        fread(buffer, sizeof(char), str_len, file);
-        student->char_last_name = strdup(buffer);
+        /* Student's basic information */
+        if (get_v1(buffer, size_buffer, &size_pos, &student->int_id, sizeof(int)) != 0
+            || get_v1(buffer, size_buffer, &size_pos, &student->int_age, sizeof(int)) != 0
+            || get_v1(buffer, size_buffer, &size_pos, &student->float_average, sizeof(float)) != 0
+            || get_v1(buffer, size_buffer, &size_pos, &student->int_nb_courses, sizeof(int)) != 0)
+        {
+            return (-1);
+        }
         
-        /* Read first name */
-        fread(&str_len, sizeof(int), 1, file);
-        fread(buffer, sizeof(char), str_len, file);
-        student->char_first_name = strdup(buffer);
+        /* Names, allocated to their exact size */
+        str = get_v1_string(buffer, size_buffer, &size_pos, &size_len);
+        student->char_last_name = (str != NULL ? arena_strdup(prom->arena_memory, str) : NULL);
+        str = get_v1_string(buffer, size_buffer, &size_pos, &size_len);
+        student->char_first_name = (str != NULL ? arena_strdup(prom->arena_memory, str) : NULL);
+        if (student->char_last_name == NULL || student->char_first_name == NULL)
+        {
+            return (-1);
+        }
         
-        /* Allocate course array */
-        student->course_courses = (Course*)malloc(student->int_nb_courses * sizeof(Course));
+        /* Course array: each course takes 2 float, 2 int and 1 NUL at least */
+        if (student->int_nb_courses < 0
+            || (size_t)student->int_nb_courses > (size_buffer - size_pos) / (2 * sizeof(float) + 2 * sizeof(int) + 1))
+        {
+            student->int_nb_courses = 0;
+            return (-1);
+        }
+        student->course_courses = (Course*)arena_grow(prom->arena_memory, NULL, 0, student->int_nb_courses * sizeof(Course));
+        if (student->course_courses == NULL && student->int_nb_courses > 0)
+        {
+            student->int_nb_courses = 0;
+            return (-1);
+        }
+        student->int_max_courses = student->int_nb_courses;
+        if (student->int_nb_courses > 0)
+        {
+            memset(student->course_courses, 0, student->int_nb_courses * sizeof(Course));
+        }
         
         /* Loop through all student's courses */
         for (j = 0; j < student->int_nb_courses; j++)
         {
             Course* course = &student->course_courses[j];
             
-            /* Read course information */
-            fread(&course->float_coef, sizeof(float), 1, file);
-            fread(&course->float_average, sizeof(float), 1, file);
-            
-            /* Read course name */
-            fread(&str_len, sizeof(int), 1, file);
-            fread(buffer, sizeof(char), str_len, file);
-            course->char_course_name = strdup(buffer);
-            
-            /* Read number of grades */
-            fread(&course->grades.int_nb_grades, sizeof(int), 1, file);
+            /* Course information, name found in the catalog */
+            if (get_v1(buffer, size_buffer, &size_pos, &coef, sizeof(float)) != 0
+                || get_v1(buffer, size_buffer, &size_pos, &course->float_average, sizeof(float)) != 0)
+            {
+                return (-1);
+            }
+            str = get_v1_string(buffer, size_buffer, &size_pos, &size_len);
+            if (str == NULL)
+            {
+                return (-1);
+            }
+            course->int_course_id = intern_course(&prom->catalog, str, size_len, coef);
             
-            /* Allocate and read grades */
-            if (course->grades.int_nb_grades > 0)
+            /* Grades, copied in one block (inline for a small course) */
+            if (course->int_course_id < 0
+                || get_v1(buffer, size_buffer, &size_pos, &nb_grades, sizeof(int)) != 0
+                || nb_grades < 0
+                || (size_t)nb_grades > (size_buffer - size_pos) / sizeof(float))
+            {
+                return (-1);
+            }
+            course->grades = create_grades_in(prom->arena_memory, nb_grades);
+            if (course->grades.int_nb_grades != nb_grades)
             {
-                course->grades.tab_grades = (float*)malloc(course->grades.int_nb_grades * sizeof(float));
-                fread(course->grades.tab_grades, sizeof(float), course->grades.int_nb_grades, file);
+                return (-1);
             }
-            else
+            if (nb_grades > 0)
             {
-                course->grades.tab_grades = NULL;
+                get_v1(buffer, size_buffer, &size_pos, get_grades_data(&course->grades), nb_grades * sizeof(float));
             }
         }
     }
     
-    /* Close file */
+    return (0);
+}
+
+/*!
+ * \fn static Prom load_prom_binary_v1(FILE* file, const char* str_filename)
+ * \brief Restores a cohort from a version 1 binary file
+ * \param file Binary file, positioned at its beginning
+ * \param str_filename Name of the source binary file
+ * \return Restored Prom structure, or empty structure in case of error
+ */
+static Prom load_prom_binary_v1(FILE* file, const char* str_filename)
+{
+    Prom prom;
+    unsigned char* buffer;
+    long size_file;
+    
+    /* The whole file is read at once, then parsed in memory */
+    buffer = NULL;
+    size_file = -1;
+    if (fseek(file, 0, SEEK_END) == 0)
+    {
+        size_file = ftell(file);
+        rewind(file);
+    }
+    if (size_file >= 0)
+    {
+        buffer = (unsigned char*)malloc(size_file > 0 ? size_file : 1);
+    }
+    if (buffer == NULL || fread(buffer, 1, size_file, file) != (size_t)size_file)
+    {
+        printf("Error: Cannot read binary file %s\n", str_filename);
+        free(buffer);
+        fclose(file);
+        return (create_prom(0));
+    }
     fclose(file);
     
+    /* Names, courses and grades go to the arena of the promotion */
+    prom = create_arena_prom(0);
+    if (parse_prom_v1(buffer, size_file, &prom) != 0)
+    {
+        printf("Error: Invalid binary file %s\n", str_filename);
+        free(buffer);
+        destroy_prom(&prom);
+        return (create_prom(0));
+    }
+    free(buffer);
+    
+    /* Index the students by identifier */
+    build_student_index(&prom);
+    
     printf("Promotion loaded successfully from binary file: %s\n", str_filename);
     return (prom);
-}
\ No newline at end of file
+}
+
+/*!
+ * \fn static uint64_t place_section(BinSection* section, uint32_t int_type, uint32_t int_count, uint64_t size_bytes, uint64_t size_position)
+ * \brief Fills an entry of the section table, the section starting at the next aligned position
+ * \param section Entry of the section table
+ * \param int_type Type of the section
+ * \param int_count Number of records
+ * \param size_bytes Size of the section
+ * \param size_position End of the previous section
+ * \return End of the section
+ */
+static uint64_t place_section(BinSection* section, uint32_t int_type, uint32_t int_count, uint64_t size_bytes, uint64_t size_position)
+{
+    section->int_type = int_type;
+    section->int_count = int_count;
+    section->size_offset = (size_position + BIN_SECTION_ALIGNMENT - 1) & ~(uint64_t)(BIN_SECTION_ALIGNMENT - 1);
+    section->size_bytes = size_bytes;
+    
+    return (section->size_offset + size_bytes);
+}
+
+/*!
+ * \fn static int pad_to_section(FILE* file, const BinSection* section, uint64_t* size_position)
+ * \brief Writes zeros up to the beginning of a section
+ * \param file Destination file
+ * \param section Entry of the section table
+ * \param size_position Pointer to the current position, updated
+ * \return 0 on success, -1 on write error
+ */
+static int pad_to_section(FILE* file, const BinSection* section, uint64_t* size_position)
+{
+    static const char zeros[BIN_SECTION_ALIGNMENT] = {0};
+    size_t size_pad;
+    
+    size_pad = (size_t)(section->size_offset - *size_position);
+    if (size_pad > 0 && fwrite(zeros, 1, size_pad, file) != size_pad)
+    {
+        return (-1);
+    }
+    *size_position = section->size_offset + section->size_bytes;
+    
+    return (0);
+}
+
+/*!
+ * \fn static int write_section(FILE* file, const BinSection* section, const void* data, uint64_t* size_position)
+ * \brief Writes a section held in one array
+ * \param file Destination file
+ * \param section Entry of the section table
+ * \param data Content of the section
+ * \param size_position Pointer to the current position, updated
+ * \return 0 on success, -1 on write error
+ */
+static int write_section(FILE* file, const BinSection* section, const void* data, uint64_t* size_position)
+{
+    if (pad_to_section(file, section, size_position) != 0)
+    {
+        return (-1);
+    }
+    if (section->size_bytes > 0 && fwrite(data, 1, section->size_bytes, file) != section->size_bytes)
+    {
+        return (-1);
+    }
+    
+    return (0);
+}
+
+/*!
+ * \fn static uint32_t add_pool_string(char* pool, size_t* size_pool, const char* str)
+ * \brief Appends a string to the string pool
+ * \param pool String pool
+ * \param size_pool Pointer to the size of the pool, updated
+ * \param str String to append
+ * \return Offset of the string in the pool
+ */
+static uint32_t add_pool_string(char* pool, size_t* size_pool, const char* str)
+{
+    size_t size_len;
+    uint32_t offset;
+    
+    size_len = strlen(str) + 1;
+    offset = (uint32_t)*size_pool;
+    memcpy(pool + offset, str, size_len);
+    *size_pool += size_len;
+    
+    return (offset);
+}
+
+/*!
+ * \fn static int compare_index_entries(const void* a, const void* b)
+ * \brief Compares two entries of the student index by identifier
+ * \param a Pointer to the first BinIndexEntry
+ * \param b Pointer to the second BinIndexEntry
+ * \return Negative, zero or positive value as for qsort
+ */
+static int compare_index_entries(const void* a, const void* b)
+{
+    int32_t id_a;
+    int32_t id_b;
+    
+    id_a = ((const BinIndexEntry*)a)->int_id;
+    id_b = ((const BinIndexEntry*)b)->int_id;
+    
+    return ((id_a > id_b) - (id_a < id_b));
+}
+
+/*!
+ * \fn static int write_grades(FILE* file, const Prom* prom)
+ * \brief Writes all the grades of a promotion, course slot by course slot
+ * \param file Destination file
+ * \param prom Pointer to the Prom structure to save
+ * \return 0 on success, -1 on write error
+ */
+static int write_grades(FILE* file, const Prom* prom)
+{
+    const Student* student;
+    const Grades* grades;
+    int i;
+    int j;
+    
+    /* Grades already contiguous: one block */
+    if (prom->store_grades != NULL)
+    {
+        if (prom->store_grades->int_nb_grades > 0
+            && fwrite(prom->store_grades->tab_grades, sizeof(float), prom->store_grades->int_nb_grades, file)
+               != (size_t)prom->store_grades->int_nb_grades)
+        {
+            return (-1);
+        }
+        return (0);
+    }
+    
+    /* Otherwise course by course */
+    for (i = 0; i < prom->int_nb_students; i++)
+    {
+        student = &prom->student_students[i];
+        if (page_student_courses(prom, i) != 0)
+        {
+            return (-1);
+        }
+        for (j = 0; j < student->int_nb_courses; j++)
+        {
+            grades = &student->course_courses[j].grades;
+            if (grades->int_nb_grades > 0
+                && fwrite(get_grades_data(grades), sizeof(float), grades->int_nb_grades, file) != (size_t)grades->int_nb_grades)
+            {
+                return (-1);
+            }
+        }
+    }
+    
+    return (0);
+}
+
+/*!
+ * \fn static int count_prom(const Prom* prom, int64_t* nb_slots, int64_t* nb_grades, size_t* size_strings)
+ * \brief Counts the course slots, the grades and the characters of the names of a promotion
+ * \param prom Pointer to the Prom structure to save
+ * \param nb_slots Pointer receiving the number of course slots
+ * \param nb_grades Pointer receiving the number of grades
+ * \param size_strings Pointer receiving the size of the string pool
+ * \return 0 on success, -1 if a count does not fit the format or a student cannot be paged in
+ */
+static int count_prom(const Prom* prom, int64_t* nb_slots, int64_t* nb_grades, size_t* size_strings)
+{
+    const Student* student;
+    int i;
+    int j;
+    
+    *nb_slots = 0;
+    *nb_grades = 0;
+    *size_strings = 1;
+    for (i = 0; i < prom->catalog.int_nb_courses; i++)
+    {
+        *size_strings += strlen(prom->catalog.info_courses[i].char_course_name) + 1;
+    }
+    for (i = 0; i < prom->int_nb_students; i++)
+    {
+        student = &prom->student_students[i];
+        *size_strings += strlen(student->char_last_name) + strlen(student->char_first_name) + 2;
+        *nb_slots += student->int_nb_courses;
+        if (page_student_courses(prom, i) != 0)
+        {
+            return (-1);
+        }
+        for (j = 0; j < student->int_nb_courses; j++)
+        {
+            *nb_grades += student->course_courses[j].grades.int_nb_grades;
+        }
+    }
+    if (*nb_slots >= INT32_MAX || *nb_grades >= INT32_MAX || *size_strings >= INT32_MAX)
+    {
+        return (-1);
+    }
+    
+    return (0);
+}
+
+/*!
+ * \fn static void fill_catalog_records(const Prom* prom, BinCatalogRecord* catalog, char* pool, size_t* size_pool)
+ * \brief Starts the string pool and fills the catalog records
+ * \param prom Pointer to the Prom structure to save
+ * \param catalog Array receiving the catalog records
+ * \param pool String pool
+ * \param size_pool Pointer receiving the size of the pool
+ */
+static void fill_catalog_records(const Prom* prom, BinCatalogRecord* catalog, char* pool, size_t* size_pool)
+{
+    int i;
+    
+    /* Offset 0 of the pool is the empty string */
+    pool[0] = '\0';
+    *size_pool = 1;
+    for (i = 0; i < prom->catalog.int_nb_courses; i++)
+    {
+        catalog[i].int_name = add_pool_string(pool, size_pool, prom->catalog.info_courses[i].char_course_name);
+        catalog[i].float_coef = prom->catalog.info_courses[i].float_coef;
+    }
+}
+
+/*!
+ * \fn static void fill_student_record(const Student* student, BinStudentRecord* record, char* pool, size_t* size_pool)
+ * \brief Fills the record of a student and appends its names to the string pool
+ * \param student Pointer to the student
+ * \param record Pointer to the record to fill
+ * \param pool String pool
+ * \param size_pool Pointer to the size of the pool, updated
+ */
+static void fill_student_record(const Student* student, BinStudentRecord* record, char* pool, size_t* size_pool)
+{
+    memset(record, 0, sizeof(BinStudentRecord));
+    record->int_id = student->int_id;
+    record->int_age = student->int_age;
+    record->float_average = student->float_average;
+    record->int_last_name = add_pool_string(pool, size_pool, student->char_last_name);
+    record->int_first_name = add_pool_string(pool, size_pool, student->char_first_name);
+}
+
+/*!
+ * \fn static void fill_index(BinIndexEntry* index, const BinStudentRecord* students, int int_nb_students, uint64_t size_offset)
+ * \brief Fills the student index: file offset of each record, by increasing identifier
+ * \param index Array receiving the entries
+ * \param students Student records
+ * \param int_nb_students Number of students
+ * \param size_offset Position of the student section in the file
+ */
+static void fill_index(BinIndexEntry* index, const BinStudentRecord* students, int int_nb_students, uint64_t size_offset)
+{
+    int i;
+    
+    for (i = 0; i < int_nb_students; i++)
+    {
+        index[i].int_id = students[i].int_id;
+        index[i].int_reserved = 0;
+        index[i].size_offset = size_offset + (uint64_t)i * sizeof(BinStudentRecord);
+    }
+    if (int_nb_students > 1)
+    {
+        qsort(index, int_nb_students, sizeof(BinIndexEntry), compare_index_entries);
+    }
+}
+
+/*!
+ * \fn int write_prom_binary(FILE* file, Prom* prom)
+ * \brief Writes a complete cohort as a version 2 binary file
+ * \param file Destination file, opened in binary write mode
+ * \param prom Pointer to the Prom structure to save
+ * \return 0 if success, -1 in case of error
+ */
+int write_prom_binary(FILE* file, Prom* prom)
+{
+    BinHeader header;
+    BinSection sections[BIN_PLAIN_SECTIONS];
+    BinCatalogRecord* catalog;
+    BinStudentRecord* students;
+    BinCourseRecord* courses;
+    BinIndexEntry* index;
+    int32_t* student_offsets;
+    int32_t* course_offsets;
+    char* pool;
+    const Student* student;
+    const Course* course;
+    uint64_t size_position;
+    size_t size_pool;
+    size_t size_strings;
+    int64_t nb_slots;
+    int64_t nb_grades;
+    int slot;
+    int result;
+    int i;
+    int j;
+    
+    /* Parameter verification */
+    if (file == NULL || prom == NULL)
+    {
+        return (-1);
+    }
+    
+    /* Count the course slots, the grades and the characters of the names */
+    if (count_prom(prom, &nb_slots, &nb_grades, &size_strings) != 0)
+    {
+        return (-1);
+    }
+    
+    /* Build the records, the offset tables and the string pool in memory */
+    catalog = (BinCatalogRecord*)malloc((prom->catalog.int_nb_courses + 1) * sizeof(BinCatalogRecord));
+    students = (BinStudentRecord*)malloc((prom->int_nb_students + 1) * sizeof(BinStudentRecord));
+    courses = (BinCourseRecord*)malloc((nb_slots + 1) * sizeof(BinCourseRecord));
+    student_offsets = (int32_t*)malloc((prom->int_nb_students + 1) * sizeof(int32_t));
+    course_offsets = (int32_t*)malloc((nb_slots + 1) * sizeof(int32_t));
+    index = (BinIndexEntry*)malloc((prom->int_nb_students + 1) * sizeof(BinIndexEntry));
+    pool = (char*)malloc(size_strings);
+    if (catalog == NULL || students == NULL || courses == NULL || index == NULL
+        || student_offsets == NULL || course_offsets == NULL || pool == NULL)
+    {
+        free(catalog);
+        free(students);
+        free(courses);
+        free(index);
+        free(student_offsets);
+        free(course_offsets);
+        free(pool);
+        return (-1);
+    }
+    
+    fill_catalog_records(prom, catalog, pool, &size_pool);
+    slot = 0;
+    course_offsets[0] = 0;
+    result = 0;
+    for (i = 0; i < prom->int_nb_students && result == 0; i++)
+    {
+        student = &prom->student_students[i];
+        result = page_student_courses(prom, i);
+        fill_student_record(student, &students[i], pool, &size_pool);
+        student_offsets[i] = slot;
+        
+        for (j = 0; result == 0 && j < student->int_nb_courses; j++)
+        {
+            course = &student->course_courses[j];
+            courses[slot].int_course_id = course->int_course_id;
+            courses[slot].float_average = course->float_average;
+            course_offsets[slot + 1] = course_offsets[slot] + course->grades.int_nb_grades;
+            slot++;
+        }
+    }
+    student_offsets[prom->int_nb_students] = slot;
+    
+    /* Lay the sections out after the header and the section table */
+    size_position = sizeof(BinHeader) + sizeof(sections);
+    size_position = place_section(&sections[0], BIN_SECTION_CATALOG, prom->catalog.int_nb_courses,
+                                  prom->catalog.int_nb_courses * sizeof(BinCatalogRecord), size_position);
+    size_position = place_section(&sections[1], BIN_SECTION_STUDENTS, prom->int_nb_students,
+                                  prom->int_nb_students * sizeof(BinStudentRecord), size_position);
+    size_position = place_section(&sections[2], BIN_SECTION_STUDENT_OFFSETS, prom->int_nb_students + 1,
+                                  (prom->int_nb_students + 1) * sizeof(int32_t), size_position);
+    size_position = place_section(&sections[3], BIN_SECTION_COURSES, (uint32_t)nb_slots,
+                                  nb_slots * sizeof(BinCourseRecord), size_position);
+    size_position = place_section(&sections[4], BIN_SECTION_COURSE_OFFSETS, (uint32_t)nb_slots + 1,
+                                  (nb_slots + 1) * sizeof(int32_t), size_position);
+    size_position = place_section(&sections[5], BIN_SECTION_GRADES, (uint32_t)nb_grades,
+                                  nb_grades * sizeof(float), size_position);
+    size_position = place_section(&sections[6], BIN_SECTION_STRINGS, (uint32_t)size_pool,
+                                  size_pool, size_position);
+    size_position = place_section(&sections[7], BIN_SECTION_STUDENT_INDEX, prom->int_nb_students,
+                                  prom->int_nb_students * sizeof(BinIndexEntry), size_position);
+    fill_index(index, students, prom->int_nb_students, sections[1].size_offset);
+    
+    header.int_magic = BIN_MAGIC;
+    header.int_version = BIN_VERSION;
+    header.int_nb_sections = BIN_PLAIN_SECTIONS;
+    header.int_flags = 0;
+    header.size_file = size_position;
+    
+    /* Write the header, the section table, then each section, unless a lazily loaded student could not be paged in */
+    if (result == 0)
+    {
+        result = -1;
+        size_position = sizeof(BinHeader) + sizeof(sections);
+        if (fwrite(&header, sizeof(BinHeader), 1, file) == 1
+            && fwrite(sections, sizeof(sections), 1, file) == 1
+            && write_section(file, &sections[0], catalog, &size_position) == 0
+            && write_section(file, &sections[1], students, &size_position) == 0
+            && write_section(file, &sections[2], student_offsets, &size_position) == 0
+            && write_section(file, &sections[3], courses, &size_position) == 0
+            && write_section(file, &sections[4], course_offsets, &size_position) == 0
+            && pad_to_section(file, &sections[5], &size_position) == 0
+            && write_grades(file, prom) == 0
+            && write_section(file, &sections[6], pool, &size_position) == 0
+            && write_section(file, &sections[7], index, &size_position) == 0)
+        {
+            result = 0;
+        }
+    }
+    
+    free(catalog);
+    free(students);
+    free(courses);
+    free(index);
+    free(student_offsets);
+    free(course_offsets);
+    free(pool);
+    
+    return (result);
+}
+
+/*!
+ * \fn static float unpack_grade(uint32_t int_fixed)
+ * \brief Converts a fixed-point grade back to a float
+ * \param int_fixed Grade multiplied by BIN_GRADE_SCALE
+ * \return Grade, the float nearest to int_fixed / BIN_GRADE_SCALE (as strtof gives for the decimal text)
+ */
+static float unpack_grade(uint32_t int_fixed)
+{
+    return ((float)int_fixed / (float)BIN_GRADE_SCALE);
+}
+
+/*!
+ * \fn static int pack_grade(float float_grade, uint32_t* int_fixed)
+ * \brief Converts a grade to fixed point if the conversion is exact
+ * \param float_grade Grade
+ * \param int_fixed Pointer receiving the grade multiplied by BIN_GRADE_SCALE
+ * \return 0 if unpack_grade gives back the same bits, -1 otherwise (negative, NaN, more decimals, too large)
+ */
+static int pack_grade(float float_grade, uint32_t* int_fixed)
+{
+    double scaled;
+    float restored;
+    
+    scaled = (double)float_grade * BIN_GRADE_SCALE;
+    if (!(scaled >= 0.0 && scaled <= (double)UINT16_MAX))
+    {
+        return (-1);
+    }
+    *int_fixed = (uint32_t)(scaled + 0.5);
+    restored = unpack_grade(*int_fixed);
+    
+    return (memcmp(&restored, &float_grade, sizeof(float)) == 0 ? 0 : -1);
+}
+
+/*!
+ * \fn static size_t put_varint(uint8_t* out, uint32_t int_value)
+ * \brief Writes an unsigned number as a varint (7 bits per byte, low bits first)
+ * \param out Destination (5 bytes at most are written)
+ * \param int_value Number to write
+ * \return Number of bytes written
+ */
+static size_t put_varint(uint8_t* out, uint32_t int_value)
+{
+    size_t size_len;
+    
+    size_len = 0;
+    while (int_value >= 0x80)
+    {
+        out[size_len++] = (uint8_t)(int_value | 0x80);
+        int_value >>= 7;
+    }
+    out[size_len++] = (uint8_t)int_value;
+    
+    return (size_len);
+}
+
+/*!
+ * \fn static int get_varint(const uint8_t** cursor, const uint8_t* end, uint32_t* int_value)
+ * \brief Reads a varint written by put_varint
+ * \param cursor Pointer to the read position, moved past the varint
+ * \param end End of the data
+ * \param int_value Pointer receiving the number
+ * \return 0 on success, -1 if the varint is truncated or does not fit 32 bits
+ */
+static int get_varint(const uint8_t** cursor, const uint8_t* end, uint32_t* int_value)
+{
+    uint32_t value;
+    uint8_t byte;
+    int shift;
+    
+    value = 0;
+    for (shift = 0; shift <= 28 && *cursor < end; shift += 7)
+    {
+        byte = *(*cursor)++;
+        if (shift == 28 && (byte & 0xF0) != 0)
+        {
+            return (-1);
+        }
+        value |= (uint32_t)(byte & 0x7F) << shift;
+        if ((byte & 0x80) == 0)
+        {
+            *int_value = value;
+            return (0);
+        }
+    }
+    
+    return (-1);
+}
+
+/*!
+ * \fn static int get_packed_grade_bytes(const Prom* prom)
+ * \brief Returns the size of the narrowest fixed-point grade holding every grade exactly
+ * \param prom Pointer to the Prom structure to save
+ * \return 1 or 2, 0 if a grade has no exact fixed-point form, -1 if a student cannot be paged in
+ */
+static int get_packed_grade_bytes(const Prom* prom)
+{
+    const Grades* grades;
+    const float* data;
+    uint32_t fixed;
+    uint32_t largest;
+    int i;
+    int j;
+    int k;
+    
+    largest = 0;
+    for (i = 0; i < prom->int_nb_students; i++)
+    {
+        if (page_student_courses(prom, i) != 0)
+        {
+            return (-1);
+        }
+        for (j = 0; j < prom->student_students[i].int_nb_courses; j++)
+        {
+            grades = &prom->student_students[i].course_courses[j].grades;
+            data = get_grades_data(grades);
+            for (k = 0; k < grades->int_nb_grades; k++)
+            {
+                if (pack_grade(data[k], &fixed) != 0)
+                {
+                    return (0);
+                }
+                largest = (fixed > largest ? fixed : largest);
+            }
+        }
+    }
+    
+    return (largest <= UINT8_MAX ? 1 : 2);
+}
+
+/*!
+ * \fn int write_prom_binary_compact(FILE* file, Prom* prom)
+ * \brief Writes a complete cohort as a compact version 2 binary file
+ * \param file Destination file, opened in binary write mode
+ * \param prom Pointer to the Prom structure to save
+ * \return 0 if success, -1 in case of error
+ */
+int write_prom_binary_compact(FILE* file, Prom* prom)
+{
+    BinHeader header;
+    BinSection sections[BIN_COMPACT_SECTIONS];
+    BinCatalogRecord* catalog;
+    BinStudentRecord* students;
+    BinIndexEntry* index;
+    uint8_t* stream;
+    uint8_t* packed;
+    char* pool;
+    const Student* student;
+    const Grades* grades;
+    const float* data;
+    uint64_t size_position;
+    size_t size_pool;
+    size_t size_strings;
+    size_t size_stream;
+    int64_t nb_slots;
+    int64_t nb_grades;
+    int64_t nb_packed;
+    uint32_t fixed;
+    uint16_t fixed_16;
+    int grade_bytes;
+    int result;
+    int i;
+    int j;
+    int k;
+    
+    /* Parameter verification */
+    if (file == NULL || prom == NULL)
+    {
+        return (-1);
+    }
+    
+    /* Narrowest grade size: a grade with more than one decimal leaves the plain layout */
+    grade_bytes = get_packed_grade_bytes(prom);
+    if (grade_bytes < 0)
+    {
+        return (-1);
+    }
+    if (grade_bytes == 0)
+    {
+        return (write_prom_binary(file, prom));
+    }
+    
+    /* Count the course slots, the grades and the characters of the names */
+    if (count_prom(prom, &nb_slots, &nb_grades, &size_strings) != 0)
+    {
+        return (-1);
+    }
+    
+    /* Build the records, the course stream, the packed grades and the string pool in memory */
+    catalog = (BinCatalogRecord*)malloc((prom->catalog.int_nb_courses + 1) * sizeof(BinCatalogRecord));
+    students = (BinStudentRecord*)malloc((prom->int_nb_students + 1) * sizeof(BinStudentRecord));
+    index = (BinIndexEntry*)malloc((prom->int_nb_students + 1) * sizeof(BinIndexEntry));
+    stream = (uint8_t*)malloc(5 * ((size_t)prom->int_nb_students + 2 * (size_t)nb_slots) + 1);
+    packed = (uint8_t*)malloc((size_t)nb_grades * grade_bytes + 1);
+    pool = (char*)malloc(size_strings);
+    if (catalog == NULL || students == NULL || index == NULL || stream == NULL || packed == NULL || pool == NULL)
+    {
+        free(catalog);
+        free(students);
+        free(index);
+        free(stream);
+        free(packed);
+        free(pool);
+        return (-1);
+    }
+    
+    fill_catalog_records(prom, catalog, pool, &size_pool);
+    size_stream = 0;
+    nb_packed = 0;
+    result = 0;
+    for (i = 0; i < prom->int_nb_students && result == 0; i++)
+    {
+        student = &prom->student_students[i];
+        result = page_student_courses(prom, i);
+        fill_student_record(student, &students[i], pool, &size_pool);
+        size_stream += put_varint(stream + size_stream, (uint32_t)student->int_nb_courses);
+        
+        for (j = 0; result == 0 && j < student->int_nb_courses; j++)
+        {
+            grades = &student->course_courses[j].grades;
+            data = get_grades_data(grades);
+            size_stream += put_varint(stream + size_stream, (uint32_t)student->course_courses[j].int_course_id);
+            size_stream += put_varint(stream + size_stream, (uint32_t)grades->int_nb_grades);
+            
+            /* Every grade was checked by get_packed_grade_bytes: a failure means the promotion changed */
+            for (k = 0; result == 0 && k < grades->int_nb_grades; k++)
+            {
+                if (pack_grade(data[k], &fixed) != 0)
+                {
+                    result = -1;
+                    break;
+                }
+                if (grade_bytes == 1)
+                {
+                    packed[nb_packed] = (uint8_t)fixed;
+                }
+                else
+                {
+                    fixed_16 = (uint16_t)fixed;
+                    memcpy(packed + 2 * nb_packed, &fixed_16, sizeof(uint16_t));
+                }
+                nb_packed++;
+            }
+        }
+    }
+    if (size_stream >= INT32_MAX)
+    {
+        result = -1;
+    }
+    
+    /* Lay the sections out after the header and the section table */
+    size_position = sizeof(BinHeader) + sizeof(sections);
+    size_position = place_section(&sections[0], BIN_SECTION_CATALOG, prom->catalog.int_nb_courses,
+                                  prom->catalog.int_nb_courses * sizeof(BinCatalogRecord), size_position);
+    size_position = place_section(&sections[1], BIN_SECTION_STUDENTS, prom->int_nb_students,
+                                  prom->int_nb_students * sizeof(BinStudentRecord), size_position);
+    size_position = place_section(&sections[2], BIN_SECTION_STRINGS, (uint32_t)size_pool,
+                                  size_pool, size_position);
+    size_position = place_section(&sections[3], BIN_SECTION_STUDENT_INDEX, prom->int_nb_students,
+                                  prom->int_nb_students * sizeof(BinIndexEntry), size_position);
+    size_position = place_section(&sections[4], BIN_SECTION_COURSE_STREAM, (uint32_t)size_stream,
+                                  size_stream, size_position);
+    size_position = place_section(&sections[5], BIN_SECTION_PACKED_GRADES, (uint32_t)(nb_packed * grade_bytes),
+                                  nb_packed * grade_bytes, size_position);
+    fill_index(index, students, prom->int_nb_students, sections[1].size_offset);
+    
+    header.int_magic = BIN_MAGIC;
+    header.int_version = BIN_VERSION;
+    header.int_nb_sections = BIN_COMPACT_SECTIONS;
+    header.int_flags = BIN_FLAG_COMPACT | (grade_bytes == 2 ? BIN_FLAG_GRADES_16 : 0);
+    header.size_file = size_position;
+    
+    /* Write the header, the section table, then each section, unless a lazily loaded student could not be paged in */
+    if (result == 0)
+    {
+        result = -1;
+        size_position = sizeof(BinHeader) + sizeof(sections);
+        if (fwrite(&header, sizeof(BinHeader), 1, file) == 1
+            && fwrite(sections, sizeof(sections), 1, file) == 1
+            && write_section(file, &sections[0], catalog, &size_position) == 0
+            && write_section(file, &sections[1], students, &size_position) == 0
+            && write_section(file, &sections[2], pool, &size_position) == 0
+            && write_section(file, &sections[3], index, &size_position) == 0
+            && write_section(file, &sections[4], stream, &size_position) == 0
+            && write_section(file, &sections[5], packed, &size_position) == 0)
+        {
+            result = 0;
+        }
+    }
+    
+    free(catalog);
+    free(students);
+    free(index);
+    free(stream);
+    free(packed);
+    free(pool);
+    
+    return (result);
+}
+
+/*!
+ * \fn int save_prom_binary(const char* str_filename, Prom* prom)
+ * \brief Saves a complete cohort to a version 2 binary file
+ * \param str_filename Name of the destination binary file
+ * \param prom Pointer to the Prom structure to save
+ * \return 0 if success, -1 in case of error
+ */
+int save_prom_binary(const char* str_filename, Prom* prom)
+{
+    return (save_to_file(str_filename, prom, write_prom_binary, BIN_WRITE_BUFFER));
+}
+
+/*!
+ * \fn int save_prom_binary_compact(const char* str_filename, Prom* prom)
+ * \brief Saves a complete cohort to a compact version 2 binary file
+ * \param str_filename Name of the destination binary file
+ * \param prom Pointer to the Prom structure to save
+ * \return 0 if success, -1 in case of error
+ */
+int save_prom_binary_compact(const char* str_filename, Prom* prom)
+{
+    return (save_to_file(str_filename, prom, write_prom_binary_compact, BIN_WRITE_BUFFER));
+}
+
+/*!
+ * \fn int load_image_catalog(const PromImage* image, Prom* prom)
+ * \brief Fills the empty catalog of a promotion with the courses of an image
+ * \param image Pointer to the view of the file
+ * \param prom Pointer to the Prom structure
+ * \return 0 on success, -1 on duplicated name or allocation error
+ */
+int load_image_catalog(const PromImage* image, Prom* prom)
+{
+    const char* name;
+    int i;
+    
+    /* The ID of a course is its index in the file */
+    for (i = 0; i < image->int_nb_courses; i++)
+    {
+        name = get_image_string(image, image->record_catalog[i].int_name);
+        if (intern_course(&prom->catalog, name, strlen(name), image->record_catalog[i].float_coef) != i)
+        {
+            return (-1);
+        }
+    }
+    
+    return (0);
+}
+
+/*!
+ * \fn void read_image_courses(const PromImage* image, int int_student, Course* courses)
+ * \brief Fills the courses of one student from a checked image, grades in place
+ * \param image Pointer to the view of the file
+ * \param int_student Index of the student record
+ * \param courses Array receiving the courses of the student
+ */
+void read_image_courses(const PromImage* image, int int_student, Course* courses)
+{
+    const BinCourseRecord* course_record;
+    Course* course;
+    int nb_courses;
+    int slot;
+    int j;
+    
+    nb_courses = image->tab_student_offsets[int_student + 1] - image->tab_student_offsets[int_student];
+    for (j = 0; j < nb_courses; j++)
+    {
+        slot = image->tab_student_offsets[int_student] + j;
+        course_record = &image->record_courses[slot];
+        course = &courses[j];
+        course->int_course_id = course_record->int_course_id;
+        course->float_average = course_record->float_average;
+        borrow_grades(&course->grades, (float*)image->tab_grades + image->tab_course_offsets[slot],
+                      image->tab_course_offsets[slot + 1] - image->tab_course_offsets[slot]);
+        course->int_nb_grades = course->grades.int_nb_grades;
+    }
+}
+
+/*!
+ * \fn GradeStore* create_image_store(const PromImage* image)
+ * \brief Creates a columnar store borrowing the grades and the offset tables of an image
+ * \param image Pointer to the view of the file
+ * \return Pointer to the store, or NULL on allocation error
+ */
+GradeStore* create_image_store(const PromImage* image)
+{
+    GradeStore* store;
+    
+    store = (GradeStore*)malloc(sizeof(GradeStore));
+    if (store == NULL)
+    {
+        return (NULL);
+    }
+    store->tab_grades = (float*)image->tab_grades;
+    store->tab_course_offsets = (int*)image->tab_course_offsets;
+    store->tab_student_offsets = (int*)image->tab_student_offsets;
+    store->int_nb_students = image->int_nb_students;
+    store->int_nb_slots = image->int_nb_slots;
+    store->int_nb_grades = image->int_nb_grades;
+    store->int_borrowed = 1;
+    
+    return (store);
+}
+
+/*!
+ * \fn int load_prom_image(const PromImage* image, Prom* prom)
+ * \brief Fills an empty promotion from a checked version 2 image, in place
+ * \param image Pointer to the view of the file
+ * \param prom Pointer to an empty promotion created by create_arena_prom
+ * \return 0 on success, -1 on error
+ */
+int load_prom_image(const PromImage* image, Prom* prom)
+{
+    const BinStudentRecord* record;
+    GradeStore* store;
+    Student* student;
+    int i;
+    
+    /* Borrowed names must never reach free(): only an arena promotion can hold them */
+    if (prom->arena_memory == NULL || load_image_catalog(image, prom) != 0)
+    {
+        return (-1);
+    }
+    
+    /* The columnar store borrows the grades and the offset tables of the image */
+    store = create_image_store(image);
+    free(prom->student_students);
+    prom->student_students = (Student*)malloc((image->int_nb_students > 0 ? image->int_nb_students : 1) * sizeof(Student));
+    prom->int_max_students = (prom->student_students != NULL ? (image->int_nb_students > 0 ? image->int_nb_students : 1) : 0);
+    if (store == NULL || prom->student_students == NULL)
+    {
+        free(store);
+        return (-1);
+    }
+    prom->store_grades = store;
+    
+    /* Students: names and grades point into the image, only course arrays are allocated */
+    for (i = 0; i < image->int_nb_students; i++)
+    {
+        record = &image->record_students[i];
+        student = &prom->student_students[i];
+        student->int_id = record->int_id;
+        student->int_age = record->int_age;
+        student->float_average = record->float_average;
+        student->char_last_name = (char*)get_image_string(image, record->int_last_name);
+        student->char_first_name = (char*)get_image_string(image, record->int_first_name);
+        student->int_nb_courses = image->tab_student_offsets[i + 1] - image->tab_student_offsets[i];
+        student->course_courses = (Course*)arena_grow(prom->arena_memory, NULL, 0, student->int_nb_courses * sizeof(Course));
+        student->int_max_courses = (student->course_courses != NULL ? student->int_nb_courses : 0);
+        if (student->int_nb_courses > 0 && student->course_courses == NULL)
+        {
+            student->int_nb_courses = 0;
+            prom->int_nb_students = i + 1;
+            return (-1);
+        }
+        read_image_courses(image, i, student->course_courses);
+    }
+    prom->int_nb_students = image->int_nb_students;
+    
+    /* Index the students by identifier */
+    return (build_student_index(prom));
+}
+
+/*!
+ * \fn static int count_compact_courses(const PromImage* image, int* nb_slots)
+ * \brief Checks the course stream of a compact image and counts its course slots
+ * \param image Pointer to the view of the file
+ * \param nb_slots Pointer receiving the number of course slots
+ * \return 0 if the stream describes every student and exactly the packed grades, -1 otherwise
+ */
+static int count_compact_courses(const PromImage* image, int* nb_slots)
+{
+    const BinStudentRecord* record;
+    const uint8_t* cursor;
+    const uint8_t* end;
+    uint32_t nb_courses;
+    uint32_t course_id;
+    uint32_t nb_course_grades;
+    int64_t nb_grades;
+    int64_t nb_total;
+    uint32_t j;
+    int i;
+    
+    cursor = image->byte_course_stream;
+    end = cursor + image->size_course_stream;
+    nb_total = 0;
+    nb_grades = 0;
+    for (i = 0; i < image->int_nb_students; i++)
+    {
+        record = &image->record_students[i];
+        if (record->int_last_name >= image->size_strings || record->int_first_name >= image->size_strings
+            || get_varint(&cursor, end, &nb_courses) != 0)
+        {
+            return (-1);
+        }
+        for (j = 0; j < nb_courses; j++)
+        {
+            if (get_varint(&cursor, end, &course_id) != 0 || get_varint(&cursor, end, &nb_course_grades) != 0
+                || course_id >= (uint32_t)image->int_nb_courses)
+            {
+                return (-1);
+            }
+            nb_grades += nb_course_grades;
+        }
+        nb_total += nb_courses;
+        if (nb_total >= INT32_MAX || nb_grades > image->int_nb_grades)
+        {
+            return (-1);
+        }
+    }
+    if (cursor != end || nb_grades != image->int_nb_grades)
+    {
+        return (-1);
+    }
+    *nb_slots = (int)nb_total;
+    
+    return (0);
+}
+
+/*!
+ * \fn int load_prom_compact(const PromImage* image, Prom* prom)
+ * \brief Fills an empty promotion from a located compact image
+ * \param image Pointer to the view of the file
+ * \param prom Pointer to an empty promotion created by create_arena_prom
+ * \return 0 on success, -1 on invalid data or allocation error
+ */
+int load_prom_compact(const PromImage* image, Prom* prom)
+{
+    const BinStudentRecord* record;
+    const uint8_t* cursor;
+    const uint8_t* end;
+    GradeStore* store;
+    Student* student;
+    Course* course;
+    uint32_t value;
+    uint16_t fixed_16;
+    int nb_slots;
+    int slot;
+    int offset;
+    int i;
+    int j;
+    
+    /* The names are borrowed from the image, as in load_prom_image */
+    if (prom->arena_memory == NULL || load_image_catalog(image, prom) != 0 || count_compact_courses(image, &nb_slots) != 0)
+    {
+        return (-1);
+    }
+    
+    /* The grades are unpacked into a store owning its arrays */
+    store = create_grade_store(image->int_nb_students, nb_slots, image->int_nb_grades);
+    prom->store_grades = store;
+    free(prom->student_students);
+    prom->student_students = (Student*)malloc((image->int_nb_students > 0 ? image->int_nb_students : 1) * sizeof(Student));
+    prom->int_max_students = (prom->student_students != NULL ? (image->int_nb_students > 0 ? image->int_nb_students : 1) : 0);
+    if (store == NULL || prom->student_students == NULL)
+    {
+        return (-1);
+    }
+    if (image->int_grade_bytes == 1)
+    {
+        for (i = 0; i < image->int_nb_grades; i++)
+        {
+            store->tab_grades[i] = unpack_grade(image->byte_packed_grades[i]);
+        }
+    }
+    else
+    {
+        for (i = 0; i < image->int_nb_grades; i++)
+        {
+            memcpy(&fixed_16, image->byte_packed_grades + 2 * (size_t)i, sizeof(uint16_t));
+            store->tab_grades[i] = unpack_grade(fixed_16);
+        }
+    }
+    
+    /* Students: names point into the image, courses are decoded from the checked stream */
+    cursor = image->byte_course_stream;
+    end = cursor + image->size_course_stream;
+    slot = 0;
+    offset = 0;
+    for (i = 0; i < image->int_nb_students; i++)
+    {
+        record = &image->record_students[i];
+        student = &prom->student_students[i];
+        student->int_id = record->int_id;
+        student->int_age = record->int_age;
+        student->float_average = record->float_average;
+        student->char_last_name = (char*)get_image_string(image, record->int_last_name);
+        student->char_first_name = (char*)get_image_string(image, record->int_first_name);
+        student->int_nb_courses = 0;
+        student->int_max_courses = 0;
+        student->course_courses = NULL;
+        
+        /* count_compact_courses checked the stream: a failure here means it is inconsistent */
+        if (get_varint(&cursor, end, &value) != 0)
+        {
+            prom->int_nb_students = i + 1;
+            return (-1);
+        }
+        student->int_nb_courses = (int)value;
+        student->course_courses = (Course*)arena_grow(prom->arena_memory, NULL, 0, student->int_nb_courses * sizeof(Course));
+        student->int_max_courses = (student->course_courses != NULL ? student->int_nb_courses : 0);
+        store->tab_student_offsets[i] = slot;
+        if (student->int_nb_courses > 0 && student->course_courses == NULL)
+        {
+            student->int_nb_courses = 0;
+            prom->int_nb_students = i + 1;
+            return (-1);
+        }
+        
+        for (j = 0; j < student->int_nb_courses; j++)
+        {
+            course = &student->course_courses[j];
+            if (get_varint(&cursor, end, &value) != 0)
+            {
+                student->int_nb_courses = j;
+                prom->int_nb_students = i + 1;
+                return (-1);
+            }
+            course->int_course_id = (int)value;
+            course->float_average = 0.0f;
+            if (get_varint(&cursor, end, &value) != 0)
+            {
+                student->int_nb_courses = j;
+                prom->int_nb_students = i + 1;
+                return (-1);
+            }
+            borrow_grades(&course->grades, store->tab_grades + offset, (int)value);
+            course->int_nb_grades = course->grades.int_nb_grades;
+            store->tab_course_offsets[slot] = offset;
+            offset += course->grades.int_nb_grades;
+            slot++;
+        }
+    }
+    store->tab_student_offsets[image->int_nb_students] = slot;
+    store->tab_course_offsets[nb_slots] = offset;
+    prom->int_nb_students = image->int_nb_students;
+    
+    /* Index the students, then recompute the averages, which are not stored */
+    if (build_student_index(prom) != 0)
+    {
+        return (-1);
+    }
+    update_course_average(prom);
+    update_student_average(prom);
+    
+    return (0);
+}
+
+/*!
+ * \fn Prom load_prom_binary(const char* str_filename)
+ * \brief Restores a cohort from a binary file (version 2, packed, or version 1)
+ * \param str_filename Name of the source binary file
+ * \return Restored Prom structure, or empty structure in case of error
+ */
+Prom load_prom_binary(const char* str_filename)
+{
+    FILE* file;
+    PromImage image;
+    Prom prom;
+    uint32_t magic;
+    int result;
+    
+    /* Parameter verification */
+    if (str_filename == NULL)
+    {
+        return (create_prom(0));
+    }
+    
+    /* Open file in binary read mode */
+    file = fopen(str_filename, "rb");
+    if (file == NULL)
+    {
+        printf("Error: Cannot open binary file %s\n", str_filename);
+        return (create_prom(0));
+    }
+    
+    /* A version 1 file starts with its number of students, never equal to the magic number */
+    if (fread(&magic, sizeof(uint32_t), 1, file) != 1 || (magic != BIN_MAGIC && magic != PACK_MAGIC))
+    {
+        rewind(file);
+        return (load_prom_binary_v1(file, str_filename));
+    }
+    fclose(file);
+    
+    /* Block-compressed version 2 file */
+    if (magic == PACK_MAGIC)
+    {
+        return (load_prom_packed(str_filename));
+    }
+    
+    /* Version 2: map the file and use it in place, or decode it if it is compact */
+    prom = create_arena_prom(0);
+    if (map_prom_image(str_filename, &image) == 0)
+    {
+        result = load_prom_image(&image, &prom);
+    }
+    else if (map_compact_image(str_filename, &image) == 0)
+    {
+        result = load_prom_compact(&image, &prom);
+    }
+    else
+    {
+        printf("Error: Invalid binary file %s\n", str_filename);
+        destroy_prom(&prom);
+        return (create_prom(0));
+    }
+    if (result != 0)
+    {
+        printf("Error: Cannot load binary file %s\n", str_filename);
+        destroy_prom(&prom);
+        close_prom_image(&image);
+        return (create_prom(0));
+    }
+    
+    /* The promotion now owns the mapping */
+    prom.ptr_mapping = (void*)image.ptr_data;
+    prom.size_mapping = image.size_data;
+    
+    printf("Promotion loaded successfully from binary file: %s\n", str_filename);
+    return (prom);
+}
@@ -0,0 +1,559 @@
+/*!
+ * \file binaryFormat.c
+ * \author Akhatar Abdelhamid <abdelhamid.akhatar@etu.cyu.fr>
+ * \version 1.0
+ * \date November 2, 2025
+ * \brief Version 2 binary file view module
+ * 
+ * This file contains the implementation of the checked, in-place view
+ * of a version 2 binary file, either held in a buffer or mapped.
+ */
+
+#include "binaryFormat.h"
+#include <stdio.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+/*!
+ * \fn static const void* find_section(const void* data, size_t size, const BinSection* section, size_t size_record)
+ * \brief Checks that a section lies in the file and holds whole records
+ * \param data First byte of the file
+ * \param size Size of the file
+ * \param section Entry of the section table
+ * \param size_record Size of a record (1 for the string pool)
+ * \return Pointer to the first record of the section, or NULL if the section is invalid
+ */
+static const void* find_section(const void* data, size_t size, const BinSection* section, size_t size_record)
+{
+    if (section->size_offset > size || section->size_bytes > size - section->size_offset)
+    {
+        return (NULL);
+    }
+    if (section->size_offset % sizeof(uint64_t) != 0
+        || section->size_bytes != (uint64_t)section->int_count * size_record)
+    {
+        return (NULL);
+    }
+    
+    return ((const char*)data + section->size_offset);
+}
+
+/*!
+ * \fn static int check_offsets(const int32_t* offsets, int int_nb, int int_total)
+ * \brief Checks an offset table of a CSR layout
+ * \param offsets Table of int_nb + 1 offsets
+ * \param int_nb Number of ranges
+ * \param int_total Number of elements of all ranges
+ * \return 0 if the offsets start at 0, never decrease and end at int_total, -1 otherwise
+ */
+static int check_offsets(const int32_t* offsets, int int_nb, int int_total)
+{
+    int i;
+    
+    if (offsets[0] != 0 || offsets[int_nb] != int_total)
+    {
+        return (-1);
+    }
+    for (i = 0; i < int_nb; i++)
+    {
+        if (offsets[i + 1] < offsets[i])
+        {
+            return (-1);
+        }
+    }
+    
+    return (0);
+}
+
+/*!
+ * \fn static int check_string(const PromImage* image, uint32_t int_offset)
+ * \brief Checks a reference to the string pool
+ * \param image Pointer to the view
+ * \param int_offset Offset of the string
+ * \return 0 if the offset lies in the pool, -1 otherwise
+ */
+static int check_string(const PromImage* image, uint32_t int_offset)
+{
+    return (int_offset < image->size_strings ? 0 : -1);
+}
+
+/*!
+ * \fn static int locate_sections(const void* data, size_t size, PromImage* image, int int_compact)
+ * \brief Checks the header and the section table of a version 2 file and locates its sections
+ * \param data First byte of the file
+ * \param size Size of the file
+ * \param image Pointer to the view to fill
+ * \param int_compact 1 to accept compact files only, 0 to accept plain files only
+ * \return 0 on success, -1 if the header or the section table is invalid
+ */
+static int locate_sections(const void* data, size_t size, PromImage* image, int int_compact)
+{
+    const BinHeader* header;
+    const BinSection* sections;
+    const BinSection* found[BIN_SECTION_LAST + 1];
+    const void* records[BIN_SECTION_LAST + 1];
+    static const size_t size_records[BIN_SECTION_LAST + 1] = {
+        0, sizeof(BinCatalogRecord), sizeof(BinStudentRecord), sizeof(int32_t),
+        sizeof(BinCourseRecord), sizeof(int32_t), sizeof(float), 1, sizeof(BinIndexEntry), 1, 1
+    };
+    static const uint32_t plain_types[] = {
+        BIN_SECTION_CATALOG, BIN_SECTION_STUDENTS, BIN_SECTION_STUDENT_OFFSETS, BIN_SECTION_COURSES,
+        BIN_SECTION_COURSE_OFFSETS, BIN_SECTION_GRADES, BIN_SECTION_STRINGS
+    };
+    static const uint32_t compact_types[] = {
+        BIN_SECTION_CATALOG, BIN_SECTION_STUDENTS, BIN_SECTION_STRINGS,
+        BIN_SECTION_COURSE_STREAM, BIN_SECTION_PACKED_GRADES
+    };
+    const uint32_t* required;
+    uint32_t nb_required;
+    uint32_t type;
+    uint32_t i;
+    
+    memset(image, 0, sizeof(PromImage));
+    memset(found, 0, sizeof(found));
+    
+    /* Header and section table */
+    if (data == NULL || size < sizeof(BinHeader))
+    {
+        return (-1);
+    }
+    header = (const BinHeader*)data;
+    if (header->int_magic != BIN_MAGIC || header->int_version != BIN_VERSION
+        || header->size_file != size || header->int_nb_sections > BIN_MAX_SECTIONS
+        || size - sizeof(BinHeader) < header->int_nb_sections * sizeof(BinSection))
+    {
+        return (-1);
+    }
+    
+    /* Known flags only, the layout asked for, 2-byte grades in compact files only */
+    if ((header->int_flags & ~(BIN_FLAG_COMPACT | BIN_FLAG_GRADES_16)) != 0
+        || ((header->int_flags & BIN_FLAG_COMPACT) != 0) != (int_compact != 0)
+        || (!int_compact && header->int_flags != 0))
+    {
+        return (-1);
+    }
+    sections = (const BinSection*)(header + 1);
+    
+    /* Locate the known sections (a section appears once, unknown types are skipped) */
+    for (i = 0; i < header->int_nb_sections; i++)
+    {
+        type = sections[i].int_type;
+        if (type == 0 || type > BIN_SECTION_LAST)
+        {
+            continue;
+        }
+        if (found[type] != NULL)
+        {
+            return (-1);
+        }
+        found[type] = &sections[i];
+        records[type] = find_section(data, size, &sections[i], size_records[type]);
+        if (records[type] == NULL || sections[i].int_count > INT32_MAX)
+        {
+            return (-1);
+        }
+    }
+    required = (int_compact ? compact_types : plain_types);
+    nb_required = (int_compact ? sizeof(compact_types) : sizeof(plain_types)) / sizeof(uint32_t);
+    for (i = 0; i < nb_required; i++)
+    {
+        if (found[required[i]] == NULL)
+        {
+            return (-1);
+        }
+    }
+    
+    image->ptr_data = data;
+    image->size_data = size;
+    image->int_flags = header->int_flags;
+    image->int_nb_courses = (int)found[BIN_SECTION_CATALOG]->int_count;
+    image->int_nb_students = (int)found[BIN_SECTION_STUDENTS]->int_count;
+    image->size_strings = found[BIN_SECTION_STRINGS]->int_count;
+    image->record_catalog = (const BinCatalogRecord*)records[BIN_SECTION_CATALOG];
+    image->record_students = (const BinStudentRecord*)records[BIN_SECTION_STUDENTS];
+    image->char_strings = (const char*)records[BIN_SECTION_STRINGS];
+    
+    if (int_compact)
+    {
+        /* Courses and grades are decoded by the reader: only the size of a grade is known */
+        image->int_grade_bytes = ((header->int_flags & BIN_FLAG_GRADES_16) != 0 ? 2 : 1);
+        image->byte_course_stream = (const uint8_t*)records[BIN_SECTION_COURSE_STREAM];
+        image->size_course_stream = found[BIN_SECTION_COURSE_STREAM]->int_count;
+        image->byte_packed_grades = (const uint8_t*)records[BIN_SECTION_PACKED_GRADES];
+        if (found[BIN_SECTION_PACKED_GRADES]->int_count % image->int_grade_bytes != 0)
+        {
+            return (-1);
+        }
+        image->int_nb_grades = (int)(found[BIN_SECTION_PACKED_GRADES]->int_count / image->int_grade_bytes);
+    }
+    else
+    {
+        image->int_nb_slots = (int)found[BIN_SECTION_COURSES]->int_count;
+        image->int_nb_grades = (int)found[BIN_SECTION_GRADES]->int_count;
+        image->tab_student_offsets = (const int32_t*)records[BIN_SECTION_STUDENT_OFFSETS];
+        image->record_courses = (const BinCourseRecord*)records[BIN_SECTION_COURSES];
+        image->tab_course_offsets = (const int32_t*)records[BIN_SECTION_COURSE_OFFSETS];
+        image->tab_grades = (const float*)records[BIN_SECTION_GRADES];
+        
+        /* Counts of the offset tables */
+        if ((int64_t)found[BIN_SECTION_STUDENT_OFFSETS]->int_count != (int64_t)image->int_nb_students + 1
+            || (int64_t)found[BIN_SECTION_COURSE_OFFSETS]->int_count != (int64_t)image->int_nb_slots + 1)
+        {
+            return (-1);
+        }
+    }
+    
+    /* Count of the index, terminated string pool */
+    if (image->size_strings == 0 || image->char_strings[image->size_strings - 1] != '\0')
+    {
+        return (-1);
+    }
+    if (found[BIN_SECTION_STUDENT_INDEX] != NULL)
+    {
+        if ((int)found[BIN_SECTION_STUDENT_INDEX]->int_count != image->int_nb_students)
+        {
+            return (-1);
+        }
+        image->record_index = (const BinIndexEntry*)records[BIN_SECTION_STUDENT_INDEX];
+    }
+    
+    /* Catalog: small, checked at once */
+    for (i = 0; i < (uint32_t)image->int_nb_courses; i++)
+    {
+        if (check_string(image, image->record_catalog[i].int_name) != 0)
+        {
+            return (-1);
+        }
+    }
+    
+    return (0);
+}
+
+/*!
+ * \fn int locate_prom_image(const void* data, size_t size, PromImage* image)
+ * \brief Checks the header and the section table of a version 2 file and locates its sections
+ * \param data First byte of the file
+ * \param size Size of the file
+ * \param image Pointer to the view to fill
+ * \return 0 on success, -1 if the header or the section table is invalid
+ */
+int locate_prom_image(const void* data, size_t size, PromImage* image)
+{
+    return (locate_sections(data, size, image, 0));
+}
+
+/*!
+ * \fn int locate_compact_image(const void* data, size_t size, PromImage* image)
+ * \brief Checks the header and the section table of a compact file and locates its sections
+ * \param data First byte of the file
+ * \param size Size of the file
+ * \param image Pointer to the view to fill
+ * \return 0 on success, -1 if the file is not a valid compact file
+ */
+int locate_compact_image(const void* data, size_t size, PromImage* image)
+{
+    return (locate_sections(data, size, image, 1));
+}
+
+/*!
+ * \fn static int get_index_student(const PromImage* image, const BinIndexEntry* entry)
+ * \brief Converts the file offset of an index entry into a student record index
+ * \param image Pointer to the view
+ * \param entry Entry of the index
+ * \return Index of the student record, or -1 if the offset is not the one of a record
+ */
+static int get_index_student(const PromImage* image, const BinIndexEntry* entry)
+{
+    uint64_t size_first;
+    uint64_t size_delta;
+    
+    size_first = (uint64_t)((const char*)image->record_students - (const char*)image->ptr_data);
+    if (entry->size_offset < size_first)
+    {
+        return (-1);
+    }
+    size_delta = entry->size_offset - size_first;
+    if (size_delta % sizeof(BinStudentRecord) != 0
+        || size_delta / sizeof(BinStudentRecord) >= (uint64_t)image->int_nb_students)
+    {
+        return (-1);
+    }
+    
+    return ((int)(size_delta / sizeof(BinStudentRecord)));
+}
+
+/*!
+ * \fn int check_image_header(const PromImage* image, int int_student)
+ * \brief Checks the record of one student of a located image, not its courses
+ * \param image Pointer to the view
+ * \param int_student Index of the student record
+ * \return 0 if its names and its range of course slots lie in the file, -1 otherwise
+ */
+int check_image_header(const PromImage* image, int int_student)
+{
+    const BinStudentRecord* record;
+    int first;
+    int last;
+    
+    if (int_student < 0 || int_student >= image->int_nb_students)
+    {
+        return (-1);
+    }
+    record = &image->record_students[int_student];
+    if (check_string(image, record->int_last_name) != 0 || check_string(image, record->int_first_name) != 0)
+    {
+        return (-1);
+    }
+    
+    first = image->tab_student_offsets[int_student];
+    last = image->tab_student_offsets[int_student + 1];
+    if (first < 0 || last < first || last > image->int_nb_slots)
+    {
+        return (-1);
+    }
+    
+    return (0);
+}
+
+/*!
+ * \fn int check_image_student(const PromImage* image, int int_student)
+ * \brief Checks the records of one student of a located image
+ * \param image Pointer to the view
+ * \param int_student Index of the student record
+ * \return 0 if its names, course slots and grades lie in the file, -1 otherwise
+ */
+int check_image_student(const PromImage* image, int int_student)
+{
+    int slot;
+    
+    if (check_image_header(image, int_student) != 0)
+    {
+        return (-1);
+    }
+    
+    /* Grades of each course slot of the student */
+    for (slot = image->tab_student_offsets[int_student]; slot < image->tab_student_offsets[int_student + 1]; slot++)
+    {
+        if (image->record_courses[slot].int_course_id < 0
+            || image->record_courses[slot].int_course_id >= image->int_nb_courses
+            || image->tab_course_offsets[slot] < 0
+            || image->tab_course_offsets[slot + 1] < image->tab_course_offsets[slot]
+            || image->tab_course_offsets[slot + 1] > image->int_nb_grades)
+        {
+            return (-1);
+        }
+    }
+    
+    return (0);
+}
+
+/*!
+ * \fn int find_image_student(const PromImage* image, int int_id)
+ * \brief Looks a student up in the index of a located image (O(log n))
+ * \param image Pointer to the view
+ * \param int_id Identifier of the student
+ * \return Index of the student record, or -1 if not found
+ */
+int find_image_student(const PromImage* image, int int_id)
+{
+    int low;
+    int high;
+    int middle;
+    int student;
+    
+    if (image->record_index == NULL)
+    {
+        return (-1);
+    }
+    
+    /* Binary search on the identifiers */
+    low = 0;
+    high = image->int_nb_students - 1;
+    while (low <= high)
+    {
+        middle = low + (high - low) / 2;
+        if (image->record_index[middle].int_id < int_id)
+        {
+            low = middle + 1;
+        }
+        else if (image->record_index[middle].int_id > int_id)
+        {
+            high = middle - 1;
+        }
+        else
+        {
+            /* The entry must designate a record of this identifier */
+            student = get_index_student(image, &image->record_index[middle]);
+            if (student < 0 || image->record_students[student].int_id != int_id)
+            {
+                return (-1);
+            }
+            return (student);
+        }
+    }
+    
+    return (-1);
+}
+
+/*!
+ * \fn int open_prom_image(const void* data, size_t size, PromImage* image)
+ * \brief Checks a version 2 file held in memory and locates its sections
+ * \param data First byte of the file
+ * \param size Size of the file
+ * \param image Pointer to the view to fill
+ * \return 0 on success, -1 if the data is not a valid version 2 file
+ */
+int open_prom_image(const void* data, size_t size, PromImage* image)
+{
+    int i;
+    
+    if (locate_prom_image(data, size, image) != 0)
+    {
+        return (-1);
+    }
+    
+    /* Offset tables: start at 0, never decrease, end at the number of elements */
+    if (check_offsets(image->tab_student_offsets, image->int_nb_students, image->int_nb_slots) != 0
+        || check_offsets(image->tab_course_offsets, image->int_nb_slots, image->int_nb_grades) != 0)
+    {
+        memset(image, 0, sizeof(PromImage));
+        return (-1);
+    }
+    
+    /* Records of every student */
+    for (i = 0; i < image->int_nb_students; i++)
+    {
+        if (check_image_student(image, i) != 0)
+        {
+            memset(image, 0, sizeof(PromImage));
+            return (-1);
+        }
+    }
+    
+    /* Index: increasing identifiers, each designating its own record */
+    for (i = 0; image->record_index != NULL && i < image->int_nb_students; i++)
+    {
+        if ((i > 0 && image->record_index[i].int_id < image->record_index[i - 1].int_id)
+            || get_index_student(image, &image->record_index[i]) < 0
+            || image->record_students[get_index_student(image, &image->record_index[i])].int_id != image->record_index[i].int_id)
+        {
+            memset(image, 0, sizeof(PromImage));
+            return (-1);
+        }
+    }
+    
+    return (0);
+}
+
+/*!
+ * \fn static int map_file(const char* str_filename, PromImage* image, int (*check)(const void*, size_t, PromImage*))
+ * \brief Maps a version 2 file and checks it
+ * \param str_filename Name of the file
+ * \param image Pointer to the view to fill
+ * \param check Function checking the mapped file and filling the view
+ * \return 0 on success, -1 on error
+ */
+static int map_file(const char* str_filename, PromImage* image, int (*check)(const void*, size_t, PromImage*))
+{
+    int fd;
+    struct stat st;
+    void* data;
+    int result;
+    
+    memset(image, 0, sizeof(PromImage));
+    
+    /* Open the file and get its size */
+    fd = open(str_filename, O_RDONLY);
+    if (fd < 0)
+    {
+        return (-1);
+    }
+    if (fstat(fd, &st) != 0 || st.st_size < (off_t)sizeof(BinHeader))
+    {
+        close(fd);
+        return (-1);
+    }
+    
+    /* Private writable mapping: the promotion may modify it, never the file */
+    data = mmap(NULL, st.st_size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (data == MAP_FAILED)
+    {
+        return (-1);
+    }
+    
+    result = check(data, st.st_size, image);
+    if (result != 0)
+    {
+        munmap(data, st.st_size);
+        return (-1);
+    }
+    image->int_mapped = 1;
+    
+    return (0);
+}
+
+/*!
+ * \fn int map_prom_image(const char* str_filename, PromImage* image)
+ * \brief Maps a version 2 file and checks it
+ * \param str_filename Name of the file
+ * \param image Pointer to the view to fill
+ * \return 0 on success, -1 on error
+ */
+int map_prom_image(const char* str_filename, PromImage* image)
+{
+    return (map_file(str_filename, image, open_prom_image));
+}
+
+/*!
+ * \fn int map_prom_sections(const char* str_filename, PromImage* image)
+ * \brief Maps a version 2 file and only checks its sections
+ * \param str_filename Name of the file
+ * \param image Pointer to the view to fill
+ * \return 0 on success, -1 on error
+ */
+int map_prom_sections(const char* str_filename, PromImage* image)
+{
+    return (map_file(str_filename, image, locate_prom_image));
+}
+
+/*!
+ * \fn int map_compact_image(const char* str_filename, PromImage* image)
+ * \brief Maps a compact file and locates its sections
+ * \param str_filename Name of the file
+ * \param image Pointer to the view to fill
+ * \return 0 on success, -1 on error
+ */
+int map_compact_image(const char* str_filename, PromImage* image)
+{
+    return (map_file(str_filename, image, locate_compact_image));
+}
+
+/*!
+ * \fn void close_prom_image(PromImage* image)
+ * \brief Unmaps the file of a view opened by map_prom_image
+ * \param image Pointer to the view
+ */
+void close_prom_image(PromImage* image)
+{
+    if (image->int_mapped)
+    {
+        munmap((void*)image->ptr_data, image->size_data);
+    }
+    memset(image, 0, sizeof(PromImage));
+}
+
+/*!
+ * \fn const char* get_image_string(const PromImage* image, uint32_t int_offset)
+ * \brief Returns a string of the pool of a checked image
+ * \param image Pointer to the view
+ * \param int_offset Offset of the string in the pool
+ * \return Pointer to the NUL-terminated string
+ */
+const char* get_image_string(const PromImage* image, uint32_t int_offset)
+{
+    return (image->char_strings + int_offset);
+}
@@ -0,0 +1,255 @@
+/*!
+ * \file courseCatalog.c
+ * \author Akhatar Abdelhamid <abdelhamid.akhatar@etu.cyu.fr>
+ * \version 1.0
+ * \date November 2, 2025
+ * \brief Course catalog module
+ * 
+ * This file contains the implementation of the catalog of courses:
+ * a dense array of CourseInfo and a hash table (open addressing)
+ * from the course name to its ID.
+ */
+
+#include "courseCatalog.h"
+#include <stdlib.h>
+#include <string.h>
+
+/*!
+ * \fn static unsigned int hash_course_name(const char* char_name, size_t size_len)
+ * \brief Computes the FNV-1a hash of a course name
+ * \param char_name Name of the course
+ * \param size_len Length of the name
+ * \return Hash of the name
+ */
+static unsigned int hash_course_name(const char* char_name, size_t size_len)
+{
+    unsigned int h;
+    size_t i;
+    
+    h = 2166136261u;
+    for (i = 0; i < size_len; i++)
+    {
+        h ^= (unsigned char)char_name[i];
+        h *= 16777619u;
+    }
+    
+    return (h);
+}
+
+/*!
+ * \fn static int find_course_slot(const CourseCatalog* catalog, const char* char_name, size_t size_len)
+ * \brief Finds the slot holding a course name, or the empty slot where it belongs
+ * \param catalog Pointer to the CourseCatalog structure (with at least one slot)
+ * \param char_name Name of the course
+ * \param size_len Length of the name
+ * \return Slot number
+ */
+static int find_course_slot(const CourseCatalog* catalog, const char* char_name, size_t size_len)
+{
+    unsigned int mask;
+    unsigned int i;
+    const char* name;
+    
+    mask = (unsigned int)catalog->int_capacity - 1;
+    i = hash_course_name(char_name, size_len) & mask;
+    
+    /* Linear probing until the name or an empty slot */
+    while (catalog->tab_slots[i] >= 0)
+    {
+        name = catalog->info_courses[catalog->tab_slots[i]].char_course_name;
+        if (strncmp(name, char_name, size_len) == 0 && name[size_len] == '\0')
+        {
+            break;
+        }
+        i = (i + 1) & mask;
+    }
+    
+    return ((int)i);
+}
+
+/*!
+ * \fn static int grow_catalog(CourseCatalog* catalog)
+ * \brief Makes room for one more course in the array and the hash table
+ * \param catalog Pointer to the CourseCatalog structure
+ * \return 0 on success, -1 on allocation error
+ */
+static int grow_catalog(CourseCatalog* catalog)
+{
+    CourseInfo* new_courses;
+    int* new_slots;
+    int* old_slots;
+    int capacity;
+    const char* name;
+    int i;
+    
+    /* Grow the array of courses geometrically */
+    if (catalog->int_nb_courses == catalog->int_max_courses)
+    {
+        new_courses = (CourseInfo*)realloc(catalog->info_courses,
+            (catalog->int_max_courses * 2 + 8) * sizeof(CourseInfo));
+        if (new_courses == NULL)
+        {
+            return (-1);
+        }
+        catalog->info_courses = new_courses;
+        catalog->int_max_courses = catalog->int_max_courses * 2 + 8;
+    }
+    
+    /* Keep the hash table at most half full */
+    if (2 * (catalog->int_nb_courses + 1) <= catalog->int_capacity)
+    {
+        return (0);
+    }
+    capacity = (catalog->int_capacity > 0 ? catalog->int_capacity * 2 : 32);
+    new_slots = (int*)malloc(capacity * sizeof(int));
+    if (new_slots == NULL)
+    {
+        return (-1);
+    }
+    for (i = 0; i < capacity; i++)
+    {
+        new_slots[i] = -1;
+    }
+    
+    /* Rehash all courses in the new table */
+    old_slots = catalog->tab_slots;
+    catalog->tab_slots = new_slots;
+    catalog->int_capacity = capacity;
+    for (i = 0; i < catalog->int_nb_courses; i++)
+    {
+        name = catalog->info_courses[i].char_course_name;
+        catalog->tab_slots[find_course_slot(catalog, name, strlen(name))] = i;
+    }
+    free(old_slots);
+    
+    return (0);
+}
+
+/*!
+ * \fn CourseCatalog create_catalog(void)
+ * \brief Creates an empty course catalog
+ * \return Initialized CourseCatalog structure
+ */
+CourseCatalog create_catalog(void)
+{
+    CourseCatalog catalog;
+    
+    catalog.info_courses = NULL;
+    catalog.int_nb_courses = 0;
+    catalog.int_max_courses = 0;
+    catalog.tab_slots = NULL;
+    catalog.int_capacity = 0;
+    
+    return (catalog);
+}
+
+/*!
+ * \fn void destroy_catalog(CourseCatalog* catalog)
+ * \brief Frees the memory allocated for a course catalog
+ * \param catalog Pointer to the CourseCatalog structure to destroy
+ */
+void destroy_catalog(CourseCatalog* catalog)
+{
+    int i;
+    
+    /* Free the name of each course */
+    for (i = 0; i < catalog->int_nb_courses; i++)
+    {
+        free(catalog->info_courses[i].char_course_name);
+    }
+    
+    free(catalog->info_courses);
+    free(catalog->tab_slots);
+    *catalog = create_catalog();
+}
+
+/*!
+ * \fn int find_course_id(const CourseCatalog* catalog, const char* char_name, size_t size_len)
+ * \brief Finds the ID of a course from its name
+ * \param catalog Pointer to the CourseCatalog structure
+ * \param char_name Name of the course
+ * \param size_len Length of the name
+ * \return ID of the course, or -1 if the name is unknown
+ */
+int find_course_id(const CourseCatalog* catalog, const char* char_name, size_t size_len)
+{
+    if (catalog->int_capacity == 0)
+    {
+        return (-1);
+    }
+    
+    return (catalog->tab_slots[find_course_slot(catalog, char_name, size_len)]);
+}
+
+/*!
+ * \fn int intern_course(CourseCatalog* catalog, const char* char_name, size_t size_len, float float_coef)
+ * \brief Returns the ID of a course, adding it to the catalog if it is new
+ * \param catalog Pointer to the CourseCatalog structure
+ * \param char_name Name of the course
+ * \param size_len Length of the name
+ * \param float_coef Coefficient of the course
+ * \return ID of the course, or -1 on allocation error
+ */
+int intern_course(CourseCatalog* catalog, const char* char_name, size_t size_len, float float_coef)
+{
+    int id;
+    char* name;
+    
+    /* Already known course */
+    id = find_course_id(catalog, char_name, size_len);
+    if (id >= 0)
+    {
+        return (id);
+    }
+    
+    /* Copy the name once for the whole promotion */
+    if (grow_catalog(catalog) != 0)
+    {
+        return (-1);
+    }
+    name = (char*)malloc(size_len + 1);
+    if (name == NULL)
+    {
+        return (-1);
+    }
+    memcpy(name, char_name, size_len);
+    name[size_len] = '\0';
+    
+    /* Add the course with the next dense ID */
+    id = catalog->int_nb_courses;
+    catalog->info_courses[id].char_course_name = name;
+    catalog->info_courses[id].float_coef = float_coef;
+    catalog->tab_slots[find_course_slot(catalog, char_name, size_len)] = id;
+    catalog->int_nb_courses++;
+    
+    return (id);
+}
+
+/*!
+ * \fn Course* find_student_course(const Student* student, int int_course_id)
+ * \brief Finds the course of a student with a given catalog ID
+ * \param student Pointer to the student
+ * \param int_course_id ID of the course in the catalog
+ * \return Pointer to the student's course, or NULL if the student does not follow it
+ */
+Course* find_student_course(const Student* student, int int_course_id)
+{
+    int i;
+    
+    /* Usual layout: the course with ID i is at position i */
+    if (int_course_id >= 0 && int_course_id < student->int_nb_courses
+        && student->course_courses[int_course_id].int_course_id == int_course_id)
+    {
+        return (&student->course_courses[int_course_id]);
+    }
+    
+    for (i = 0; i < student->int_nb_courses; i++)
+    {
+        if (student->course_courses[i].int_course_id == int_course_id)
+        {
+            return (&student->course_courses[i]);
+        }
+    }
+    
+    return (NULL);
+}
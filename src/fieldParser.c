@@ -0,0 +1,234 @@
+/*!
+ * \file fieldParser.c
+ * \author Akhatar Abdelhamid <abdelhamid.akhatar@etu.cyu.fr>
+ * \version 1.0
+ * \date November 2, 2025
+ * \brief Field parser of the data file lines
+ * 
+ * This file contains the implementation of the ';'-separated field
+ * tokenizer and of the locale-independent integer and decimal parsers.
+ */
+
+#include "fieldParser.h"
+#include <limits.h>
+#include <string.h>
+
+/*! \brief Powers of ten up to 10^PARSE_MAX_DECIMALS, all exact floats */
+static const float tab_powers[PARSE_MAX_DECIMALS + 1] =
+{
+    1e0f, 1e1f, 1e2f, 1e3f, 1e4f, 1e5f, 1e6f, 1e7f, 1e8f, 1e9f, 1e10f
+};
+
+/*!
+ * \fn void start_fields(FieldReader* reader, const char* text, size_t len)
+ * \brief Places a field reader on the first field of a line
+ * \param reader Pointer to the FieldReader to initialize
+ * \param text First character of the line
+ * \param len Length of the line, without its newline
+ */
+void start_fields(FieldReader* reader, const char* text, size_t len)
+{
+    /* Lines ending with "\r\n" are read as the same lines ending with "\n" */
+    if (len > 0 && text[len - 1] == '\r')
+    {
+        len--;
+    }
+    reader->char_next = text;
+    reader->char_end = text + len;
+}
+
+/*!
+ * \fn int next_field(FieldReader* reader, const char** field, size_t* len)
+ * \brief Reads the next ';'-separated field of a line
+ * \param reader Pointer to the FieldReader
+ * \param field Pointer receiving the first character of the field
+ * \param len Pointer receiving the length of the field
+ * \return 1 if a field was read, 0 after the last field
+ */
+int next_field(FieldReader* reader, const char** field, size_t* len)
+{
+    const char* sep;
+    
+    if (reader->char_next == NULL)
+    {
+        return (0);
+    }
+    
+    /* The last field ends with the line */
+    sep = memchr(reader->char_next, ';', reader->char_end - reader->char_next);
+    *field = reader->char_next;
+    if (sep != NULL)
+    {
+        *len = sep - reader->char_next;
+        reader->char_next = sep + 1;
+    }
+    else
+    {
+        *len = reader->char_end - reader->char_next;
+        reader->char_next = NULL;
+    }
+    
+    return (1);
+}
+
+/*!
+ * \fn int has_more_fields(const FieldReader* reader)
+ * \brief Tells whether fields remain to be read
+ * \param reader Pointer to the FieldReader
+ * \return 1 if next_field would read a field, 0 otherwise
+ */
+int has_more_fields(const FieldReader* reader)
+{
+    return (reader->char_next != NULL);
+}
+
+/*!
+ * \fn int parse_int_field(const char* text, size_t len, int* value)
+ * \brief Converts a whole field to an int
+ * \param text First character of the field
+ * \param len Length of the field
+ * \param value Pointer receiving the integer
+ * \return PARSE_OK, or PARSE_BAD_INTEGER if the field is not an optionally signed decimal int
+ */
+int parse_int_field(const char* text, size_t len, int* value)
+{
+    long long number;
+    long long limit;
+    size_t i;
+    int negative;
+    
+    i = 0;
+    negative = 0;
+    if (len > 0 && (text[0] == '-' || text[0] == '+'))
+    {
+        negative = (text[0] == '-');
+        i = 1;
+    }
+    if (i == len)
+    {
+        return (PARSE_BAD_INTEGER);
+    }
+    
+    /* Accumulate the digits, stopping as soon as the value leaves the int range */
+    limit = (negative ? -(long long)INT_MIN : INT_MAX);
+    number = 0;
+    for (; i < len; i++)
+    {
+        if (text[i] < '0' || text[i] > '9')
+        {
+            return (PARSE_BAD_INTEGER);
+        }
+        number = number * 10 + (text[i] - '0');
+        if (number > limit)
+        {
+            return (PARSE_BAD_INTEGER);
+        }
+    }
+    
+    *value = (int)(negative ? -number : number);
+    
+    return (PARSE_OK);
+}
+
+/*!
+ * \fn int parse_decimal_field(const char* text, size_t len, float* value)
+ * \brief Converts a whole field "[sign]digits[.digits]" to the nearest float
+ * \param text First character of the field
+ * \param len Length of the field
+ * \param value Pointer receiving the number
+ * \return PARSE_OK, or PARSE_BAD_NUMBER if the field is not a decimal number or is too precise
+ */
+int parse_decimal_field(const char* text, size_t len, float* value)
+{
+    const char* dot;
+    size_t nb_integer;
+    size_t nb_decimals;
+    size_t i;
+    long digits;
+    int negative;
+    float number;
+    
+    negative = 0;
+    if (len > 0 && (text[0] == '-' || text[0] == '+'))
+    {
+        negative = (text[0] == '-');
+        text++;
+        len--;
+    }
+    
+    /* Integer part, then decimals without their trailing zeros */
+    dot = memchr(text, '.', len);
+    nb_integer = (dot != NULL ? (size_t)(dot - text) : len);
+    nb_decimals = (dot != NULL ? len - nb_integer - 1 : 0);
+    if (nb_integer + nb_decimals == 0)
+    {
+        return (PARSE_BAD_NUMBER);
+    }
+    for (i = nb_integer + 1; i < len; i++)
+    {
+        if (text[i] < '0' || text[i] > '9')
+        {
+            return (PARSE_BAD_NUMBER);
+        }
+    }
+    while (nb_decimals > 0 && text[nb_integer + nb_decimals] == '0')
+    {
+        nb_decimals--;
+    }
+    if (nb_decimals > PARSE_MAX_DECIMALS)
+    {
+        return (PARSE_BAD_NUMBER);
+    }
+    
+    /* All significant digits as one exact integer */
+    digits = 0;
+    for (i = 0; i < nb_integer + 1 + nb_decimals; i++)
+    {
+        if (i == nb_integer)
+        {
+            continue;
+        }
+        if (text[i] < '0' || text[i] > '9')
+        {
+            return (PARSE_BAD_NUMBER);
+        }
+        digits = digits * 10 + (text[i] - '0');
+        if (digits > PARSE_MAX_DIGITS_VALUE)
+        {
+            return (PARSE_BAD_NUMBER);
+        }
+    }
+    
+    /* One correctly rounded division of two exact floats */
+    number = (float)digits / tab_powers[nb_decimals];
+    *value = (negative ? -number : number);
+    
+    return (PARSE_OK);
+}
+
+/*!
+ * \fn const char* get_parse_error(int int_error)
+ * \brief Describes a parse error
+ * \param int_error PARSE_OK or one of the PARSE_ error codes
+ * \return Static description of the error
+ */
+const char* get_parse_error(int int_error)
+{
+    switch (int_error)
+    {
+        case PARSE_OK:
+            return ("no error");
+        case PARSE_MISSING_FIELD:
+            return ("missing field");
+        case PARSE_EXTRA_FIELD:
+            return ("too many fields");
+        case PARSE_BAD_INTEGER:
+            return ("invalid integer");
+        case PARSE_BAD_NUMBER:
+            return ("invalid number");
+        case PARSE_NO_MEMORY:
+            return ("out of memory");
+        default:
+            return ("unknown error");
+    }
+}
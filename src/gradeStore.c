@@ -0,0 +1,297 @@
+/*!
+ * \file gradeStore.c
+ * \author Akhatar Abdelhamid <abdelhamid.akhatar@etu.cyu.fr>
+ * \version 1.0
+ * \date November 2, 2025
+ * \brief Columnar grade store module
+ * 
+ * This file contains the implementation of the columnar storage of the
+ * grades of a promotion: one contiguous array of grades indexed by
+ * course and student offset tables.
+ */
+
+#include "gradeStore.h"
+#include "arena.h"
+#include "lazyLoad.h"
+#include "init.h"
+
+/*!
+ * \fn static void free_grade_store(GradeStore* store)
+ * \brief Frees the arrays and the structure of a grade store
+ * \param store Pointer to the GradeStore structure to free
+ */
+static void free_grade_store(GradeStore* store)
+{
+    /* Arrays borrowed from a mapped file are unmapped with the promotion */
+    if (!store->int_borrowed)
+    {
+        free(store->tab_grades);
+        free(store->tab_course_offsets);
+        free(store->tab_student_offsets);
+    }
+    free(store);
+}
+
+/*!
+ * \fn GradeStore* create_grade_store(int int_nb_students, int int_nb_slots, int int_nb_grades)
+ * \brief Allocates an empty columnar store owning its arrays
+ * \param int_nb_students Number of students
+ * \param int_nb_slots Number of course slots
+ * \param int_nb_grades Number of grades
+ * \return Pointer to the store, or NULL on allocation error
+ */
+GradeStore* create_grade_store(int int_nb_students, int int_nb_slots, int int_nb_grades)
+{
+    GradeStore* store;
+    
+    store = (GradeStore*)malloc(sizeof(GradeStore));
+    if (store == NULL)
+    {
+        return (NULL);
+    }
+    store->int_borrowed = 0;
+    store->tab_grades = (float*)malloc((int_nb_grades > 0 ? int_nb_grades : 1) * sizeof(float));
+    store->tab_course_offsets = (int*)malloc((int_nb_slots + 1) * sizeof(int));
+    store->tab_student_offsets = (int*)malloc((int_nb_students + 1) * sizeof(int));
+    if (store->tab_grades == NULL || store->tab_course_offsets == NULL || store->tab_student_offsets == NULL)
+    {
+        free_grade_store(store);
+        return (NULL);
+    }
+    store->int_nb_students = int_nb_students;
+    store->int_nb_slots = int_nb_slots;
+    store->int_nb_grades = int_nb_grades;
+    
+    return (store);
+}
+
+/*!
+ * \fn int build_grade_store(Prom* prom)
+ * \brief Moves all the grades of a promotion into a columnar store
+ * \param prom Pointer to the Prom structure
+ * \return 0 on success, -1 on allocation error
+ */
+int build_grade_store(Prom* prom)
+{
+    GradeStore* store;
+    Student* student;
+    Course* course;
+    int nb_slots;
+    int nb_grades;
+    int slot;
+    int offset;
+    int i;
+    int j;
+    
+    /* A lazy promotion gets the store of its file once all its courses are loaded */
+    if (materialize_prom(prom) != 0)
+    {
+        return (-1);
+    }
+    if (prom->store_grades != NULL)
+    {
+        return (0);
+    }
+    
+    /* Count the course slots and the grades */
+    nb_slots = 0;
+    nb_grades = 0;
+    for (i = 0; i < prom->int_nb_students; i++)
+    {
+        student = &prom->student_students[i];
+        nb_slots += student->int_nb_courses;
+        for (j = 0; j < student->int_nb_courses; j++)
+        {
+            nb_grades += student->course_courses[j].grades.int_nb_grades;
+        }
+    }
+    
+    /* Allocate the store */
+    store = create_grade_store(prom->int_nb_students, nb_slots, nb_grades);
+    if (store == NULL)
+    {
+        return (-1);
+    }
+    
+    /* Copy the grades student by student, course by course */
+    slot = 0;
+    offset = 0;
+    for (i = 0; i < prom->int_nb_students; i++)
+    {
+        student = &prom->student_students[i];
+        store->tab_student_offsets[i] = slot;
+        
+        for (j = 0; j < student->int_nb_courses; j++)
+        {
+            course = &student->course_courses[j];
+            store->tab_course_offsets[slot] = offset;
+            
+            if (course->grades.int_nb_grades > 0)
+            {
+                memcpy(store->tab_grades + offset, get_grades_data(&course->grades),
+                       course->grades.int_nb_grades * sizeof(float));
+            }
+            
+            /* The course now reads its grades from the store */
+            arena_grow(prom->arena_memory, course->grades.tab_grades, course->grades.int_max_grades * sizeof(float), 0);
+            borrow_grades(&course->grades, store->tab_grades + offset, course->grades.int_nb_grades);
+            
+            offset += course->grades.int_nb_grades;
+            slot++;
+        }
+    }
+    store->tab_student_offsets[prom->int_nb_students] = slot;
+    store->tab_course_offsets[nb_slots] = offset;
+    
+    prom->store_grades = store;
+    
+    return (0);
+}
+
+/*!
+ * \fn static void restore_store_pointers(Prom* prom, int int_position, int int_course)
+ * \brief Points the courses already copied out of the store back into it
+ * \param prom Pointer to the Prom structure
+ * \param int_position Position of the student whose copy failed
+ * \param int_course Position of the course whose copy failed
+ */
+static void restore_store_pointers(Prom* prom, int int_position, int int_course)
+{
+    GradeStore* store;
+    Grades* grades;
+    int nb_courses;
+    int i;
+    int j;
+    
+    store = prom->store_grades;
+    for (i = 0; i <= int_position; i++)
+    {
+        nb_courses = (i < int_position ? prom->student_students[i].int_nb_courses : int_course);
+        for (j = 0; j < nb_courses; j++)
+        {
+            grades = &prom->student_students[i].course_courses[j].grades;
+            if (grades->int_nb_grades > 0)
+            {
+                arena_grow(prom->arena_memory, grades->tab_grades, grades->int_max_grades * sizeof(float), 0);
+                borrow_grades(grades, store->tab_grades + store->tab_course_offsets[get_store_slot(store, i, j)], grades->int_nb_grades);
+            }
+        }
+    }
+}
+
+/*!
+ * \fn int release_grade_store(Prom* prom)
+ * \brief Gives each course its own grades array again and frees the store
+ * \param prom Pointer to the Prom structure
+ * \return 0 on success, -1 on allocation error
+ */
+int release_grade_store(Prom* prom)
+{
+    GradeStore* store;
+    Student* student;
+    Grades* grades;
+    float* borrowed;
+    int nb_grades;
+    int i;
+    int j;
+    
+    /* The courses of a lazy promotion are all loaded first, their grades in a store */
+    if (materialize_prom(prom) != 0)
+    {
+        return (-1);
+    }
+    store = prom->store_grades;
+    if (store == NULL)
+    {
+        return (0);
+    }
+    
+    for (i = 0; i < prom->int_nb_students; i++)
+    {
+        student = &prom->student_students[i];
+        for (j = 0; j < student->int_nb_courses; j++)
+        {
+            grades = &student->course_courses[j].grades;
+            if (grades->int_nb_grades == 0)
+            {
+                continue;
+            }
+            
+            /* Copy the grades out of the store (inline for a small course) */
+            borrowed = grades->tab_grades;
+            nb_grades = grades->int_nb_grades;
+            borrow_grades(grades, NULL, 0);
+            if (reserve_grades_in(prom->arena_memory, grades, nb_grades) != 0)
+            {
+                borrow_grades(grades, borrowed, nb_grades);
+                restore_store_pointers(prom, i, j);
+                return (-1);
+            }
+            memcpy(get_grades_data(grades), borrowed, nb_grades * sizeof(float));
+            grades->int_nb_grades = nb_grades;
+        }
+    }
+    
+    free_grade_store(store);
+    prom->store_grades = NULL;
+    
+    return (0);
+}
+
+/*!
+ * \fn void destroy_grade_store(Prom* prom)
+ * \brief Frees the store and empties the grades of all courses
+ * \param prom Pointer to the Prom structure
+ */
+void destroy_grade_store(Prom* prom)
+{
+    Student* student;
+    int i;
+    int j;
+    
+    if (prom->store_grades == NULL)
+    {
+        return;
+    }
+    
+    /* Forget the grades arrays pointing into the store */
+    for (i = 0; i < prom->int_nb_students; i++)
+    {
+        student = &prom->student_students[i];
+        for (j = 0; j < student->int_nb_courses; j++)
+        {
+            borrow_grades(&student->course_courses[j].grades, NULL, 0);
+        }
+    }
+    
+    free_grade_store(prom->store_grades);
+    prom->store_grades = NULL;
+}
+
+/*!
+ * \fn int get_store_slot(const GradeStore* store, int int_position, int int_course)
+ * \brief Returns the course slot of a course of a student
+ * \param store Pointer to the GradeStore structure
+ * \param int_position Position of the student in the promotion
+ * \param int_course Position of the course in the student's course array
+ * \return Course slot in the store
+ */
+int get_store_slot(const GradeStore* store, int int_position, int int_course)
+{
+    return (store->tab_student_offsets[int_position] + int_course);
+}
+
+/*!
+ * \fn const float* get_store_grades(const GradeStore* store, int int_slot, int* int_nb_grades)
+ * \brief Returns the contiguous grades of a course slot
+ * \param store Pointer to the GradeStore structure
+ * \param int_slot Course slot in the store
+ * \param int_nb_grades Pointer receiving the number of grades
+ * \return Pointer to the first grade of the slot
+ */
+const float* get_store_grades(const GradeStore* store, int int_slot, int* int_nb_grades)
+{
+    *int_nb_grades = store->tab_course_offsets[int_slot + 1] - store->tab_course_offsets[int_slot];
+    
+    return (store->tab_grades + store->tab_course_offsets[int_slot]);
+}
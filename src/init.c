@@ -7,10 +7,18 @@
  * 
  * This file contains the implementation of creation (constructors) 
  * and destruction (destructors) functions for the Grades, Course, Student and Prom structures.
+ * The _in variants allocate in the arena of a promotion (or on the heap for a NULL arena).
  */
 
 #include "init.h"
+#include "studentIndex.h"
+#include "courseCatalog.h"
+#include "gradeStore.h"
+#include "arena.h"
+#include "sorting.h"
+#include "lazyLoad.h"
 #include <string.h>
+#include <sys/mman.h>
 
 /*!
  * \fn Grades create_grades(int int_nb_grades)
@@ -19,24 +27,49 @@
  * \return Initialized Grades structure with grades set to 0.0
  */
 Grades create_grades(int int_nb_grades) 
+{
+    return (create_grades_in(NULL, int_nb_grades));
+}
+
+/*!
+ * \fn Grades create_grades_in(Arena* arena, int int_nb_grades)
+ * \brief Creates a Grades structure whose array is allocated in an arena
+ * \param arena Pointer to the arena (NULL: heap)
+ * \param int_nb_grades Number of grades to allocate
+ * \return Initialized Grades structure with grades set to 0.0
+ */
+Grades create_grades_in(Arena* arena, int int_nb_grades) 
 {
     Grades grades;
+    float* data;
     int i;
     
     /* Initialize the number of grades */
     grades.int_nb_grades = int_nb_grades;
     
-    /* Dynamic allocation of the grades array */
-    grades.tab_grades = (float*)malloc(int_nb_grades * sizeof(float));
+    /* A small set of grades stays inline */
+    grades.tab_grades = NULL;
+    grades.int_max_grades = GRADES_INLINE_CAPACITY;
     
-    /* Check if allocation was successful */
-    if (grades.tab_grades != NULL) 
+    /* Dynamic allocation of the grades array (growable) beyond that */
+    if (int_nb_grades > GRADES_INLINE_CAPACITY)
     {
-        /* Initialize all grades to 0.0 */
-        for (i = 0; i < int_nb_grades; i++) 
+        grades.tab_grades = (float*)arena_grow(arena, NULL, 0, int_nb_grades * sizeof(float));
+        
+        /* Check if allocation was successful */
+        if (grades.tab_grades == NULL)
         {
-            grades.tab_grades[i] = 0.0f;
+            grades.int_nb_grades = 0;
+            return (grades);
         }
+        grades.int_max_grades = int_nb_grades;
+    }
+    
+    /* Initialize all grades to 0.0 */
+    data = get_grades_data(&grades);
+    for (i = 0; i < grades.int_nb_grades; i++) 
+    {
+        data[i] = 0.0f;
     }
     
     return (grades);
@@ -44,25 +77,34 @@ Grades create_grades(int int_nb_grades)
 
 
 /*!
- * \fn Course create_course(const char* char_course_name, float float_coef, int int_nb_grades)
+ * \fn Course create_course(int int_course_id, int int_nb_grades)
  * \brief Creates a Course structure with dynamic allocation
- * \param char_course_name Name of the course
- * \param float_coef Coefficient of the course
+ * \param int_course_id ID of the course in the catalog of the promotion
  * \param int_nb_grades Number of grades to allocate
  * \return Initialized Course structure
  */
-Course create_course(const char* char_course_name, float float_coef, int int_nb_grades) 
+Course create_course(int int_course_id, int int_nb_grades) 
+{
+    return (create_course_in(NULL, int_course_id, int_nb_grades));
+}
+
+/*!
+ * \fn Course create_course_in(Arena* arena, int int_course_id, int int_nb_grades)
+ * \brief Creates a Course structure whose grades are allocated in an arena
+ * \param arena Pointer to the arena (NULL: heap)
+ * \param int_course_id ID of the course in the catalog of the promotion
+ * \param int_nb_grades Number of grades to allocate
+ * \return Initialized Course structure
+ */
+Course create_course_in(Arena* arena, int int_course_id, int int_nb_grades) 
 {
     Course course;
     
-    /* Duplicate the course name (dynamic allocation + copy) */
-    course.char_course_name = strdup(char_course_name);
-    
-    /* Initialize the coefficient */
-    course.float_coef = float_coef;
+    /* Refer to the course of the catalog (name and coefficient) */
+    course.int_course_id = int_course_id;
     
     /* Create the associated Grades structure */
-    course.grades = create_grades(int_nb_grades);
+    course.grades = create_grades_in(arena, int_nb_grades);
     
     /* Initialize the average to 0 */
     course.float_average = 0.0f;
@@ -81,6 +123,22 @@ Course create_course(const char* char_course_name, float float_coef, int int_nb_
  * \return Initialized Student structure
  */
 Student create_student(int int_id, const char* char_last_name, const char* char_first_name, int int_age, int int_nb_courses) 
+{
+    return (create_student_in(NULL, int_id, char_last_name, char_first_name, int_age, int_nb_courses));
+}
+
+/*!
+ * \fn Student create_student_in(Arena* arena, int int_id, const char* char_last_name, const char* char_first_name, int int_age, int int_nb_courses)
+ * \brief Creates a Student structure whose names and courses are allocated in an arena
+ * \param arena Pointer to the arena (NULL: heap)
+ * \param int_id Unique identifier of the student
+ * \param char_last_name Last name of the student
+ * \param char_first_name First name of the student
+ * \param int_age Age of the student
+ * \param int_nb_courses Number of courses to allocate
+ * \return Initialized Student structure
+ */
+Student create_student_in(Arena* arena, int int_id, const char* char_last_name, const char* char_first_name, int int_age, int int_nb_courses) 
 {
     Student student;
     
@@ -88,10 +146,10 @@ Student create_student(int int_id, const char* char_last_name, const char* char_
     student.int_id = int_id;
     
     /* Duplicate the last name (dynamic allocation + copy) */
-    student.char_last_name = strdup(char_last_name);
+    student.char_last_name = arena_strdup(arena, char_last_name);
     
     /* Duplicate the first name (dynamic allocation + copy) */
-    student.char_first_name = strdup(char_first_name);
+    student.char_first_name = arena_strdup(arena, char_first_name);
     
     /* Initialize the age */
     student.int_age = int_age;
@@ -99,8 +157,9 @@ Student create_student(int int_id, const char* char_last_name, const char* char_
     /* Initialize the number of courses */
     student.int_nb_courses = int_nb_courses;
     
-    /* Dynamic allocation of the courses array */
-    student.course_courses = (Course*)malloc(int_nb_courses * sizeof(Course));
+    /* Dynamic allocation of the courses array (growable) */
+    student.course_courses = (Course*)arena_grow(arena, NULL, 0, int_nb_courses * sizeof(Course));
+    student.int_max_courses = (student.course_courses != NULL ? int_nb_courses : 0);
     
     /* Initialize the overall average to 0 */
     student.float_average = 0.0f;
@@ -123,6 +182,49 @@ Prom create_prom(int int_nb_students)
     
     /* Dynamic allocation of the students array */
     prom.student_students = (Student*)malloc(int_nb_students * sizeof(Student));
+    prom.int_max_students = (prom.student_students != NULL ? int_nb_students : 0);
+    
+    /* The index is built once the students are loaded */
+    prom.index.slot_slots = NULL;
+    prom.index.int_capacity = 0;
+    prom.index.int_nb_entries = 0;
+    prom.int_nb_unknown_ids = 0;
+    
+    /* No course until the MATIERES section is loaded */
+    prom.catalog = create_catalog();
+    
+    /* Grades are stored per course until a columnar store is built */
+    prom.store_grades = NULL;
+    
+    /* Names, courses and grades are allocated one by one */
+    prom.arena_memory = NULL;
+    
+    /* Students are ranked by sort_students_by_average and build_course_ranking */
+    prom.tab_ranking = NULL;
+    prom.ranking_courses = NULL;
+    
+    /* No binary file is mapped */
+    prom.ptr_mapping = NULL;
+    prom.size_mapping = 0;
+    
+    /* All courses are loaded with their students */
+    prom.lazy_pages = NULL;
+    
+    return (prom);
+}
+
+/*!
+ * \fn Prom create_arena_prom(int int_nb_students)
+ * \brief Creates a Prom structure whose names, courses and grades will be allocated in an arena
+ * \param int_nb_students Number of students to allocate
+ * \return Initialized Prom structure (without arena if it cannot be allocated)
+ */
+Prom create_arena_prom(int int_nb_students) 
+{
+    Prom prom;
+    
+    prom = create_prom(int_nb_students);
+    prom.arena_memory = create_arena(0);
     
     return (prom);
 }
@@ -134,19 +236,31 @@ Prom create_prom(int int_nb_students)
  * \param grades Pointer to the Grades structure to destroy
  */
 void destroy_grades(Grades* grades) 
+{
+    destroy_grades_in(NULL, grades);
+}
+
+/*!
+ * \fn void destroy_grades_in(Arena* arena, Grades* grades)
+ * \brief Gives back to an arena the memory of a Grades structure
+ * \param arena Pointer to the arena the grades were created in (NULL: heap)
+ * \param grades Pointer to the Grades structure to destroy
+ */
+void destroy_grades_in(Arena* arena, Grades* grades) 
 {
     /* Check if the grades array exists */
     if (grades->tab_grades != NULL) 
     {
         /* Free the array memory */
-        free(grades->tab_grades);
+        arena_grow(arena, grades->tab_grades, grades->int_max_grades * sizeof(float), 0);
         
         /* Set pointer to NULL to avoid double free */
         grades->tab_grades = NULL;
     }
     
-    /* Reset the number of grades */
+    /* Reset the number of grades (back to the inline array) */
     grades->int_nb_grades = 0;
+    grades->int_max_grades = GRADES_INLINE_CAPACITY;
 }
 
 /*!
@@ -156,21 +270,22 @@ void destroy_grades(Grades* grades)
  */
 void destroy_course(Course* course) 
 {
-    /* Check if the course name exists */
-    if (course->char_course_name != NULL) 
-    {
-        /* Free the name memory */
-        free(course->char_course_name);
-        
-        /* Set pointer to NULL to avoid double free */
-        course->char_course_name = NULL;
-    }
-    
+    destroy_course_in(NULL, course);
+}
+
+/*!
+ * \fn void destroy_course_in(Arena* arena, Course* course)
+ * \brief Gives back to an arena the memory of a Course structure
+ * \param arena Pointer to the arena the course was created in (NULL: heap)
+ * \param course Pointer to the Course structure to destroy
+ */
+void destroy_course_in(Arena* arena, Course* course) 
+{
     /* Destroy the associated Grades structure */
-    destroy_grades(&course->grades);
+    destroy_grades_in(arena, &course->grades);
     
-    /* Reset the coefficient */
-    course->float_coef = 0.0f;
+    /* Reset the catalog ID */
+    course->int_course_id = -1;
     
     /* Reset the average */
     course->float_average = 0.0f;
@@ -183,20 +298,31 @@ void destroy_course(Course* course)
  * \param student Pointer to the Student structure to destroy
  */
 void destroy_student(Student* student) 
+{
+    destroy_student_in(NULL, student);
+}
+
+/*!
+ * \fn void destroy_student_in(Arena* arena, Student* student)
+ * \brief Gives back to an arena the memory of a Student structure
+ * \param arena Pointer to the arena the student was created in (NULL: heap)
+ * \param student Pointer to the Student structure to destroy
+ */
+void destroy_student_in(Arena* arena, Student* student) 
 {
     int i;
     
     /* Check and free the last name */
     if (student->char_last_name != NULL) 
     {
-        free(student->char_last_name);
+        arena_free(arena, student->char_last_name, strlen(student->char_last_name) + 1);
         student->char_last_name = NULL;
     }
     
     /* Check and free the first name */
     if (student->char_first_name != NULL) 
     {
-        free(student->char_first_name);
+        arena_free(arena, student->char_first_name, strlen(student->char_first_name) + 1);
         student->char_first_name = NULL;
     }
     
@@ -206,11 +332,11 @@ void destroy_student(Student* student)
         /* Destroy each course in the array */
         for (i = 0; i < student->int_nb_courses; i++) 
         {
-            destroy_course(&student->course_courses[i]);
+            destroy_course_in(arena, &student->course_courses[i]);
         }
         
         /* Free the courses array */
-        free(student->course_courses);
+        arena_grow(arena, student->course_courses, student->int_max_courses * sizeof(Course), 0);
         
         /* Set pointer to NULL to avoid double free */
         student->course_courses = NULL;
@@ -220,6 +346,7 @@ void destroy_student(Student* student)
     student->int_id = 0;
     student->int_age = 0;
     student->int_nb_courses = 0;
+    student->int_max_courses = 0;
     student->float_average = 0.0f;
 }
 
@@ -232,11 +359,17 @@ void destroy_prom(Prom* prom)
 {
     int i;
     
+    /* Free the columnar grade store (the courses do not own their grades) */
+    destroy_grade_store(prom);
+    
+    /* Free the courses paged in by lazy loading and unmap their file */
+    destroy_lazy_pages(prom);
+    
     /* Check if the students array exists */
     if (prom->student_students != NULL) 
     {
-        /* Destroy each student in the array */
-        for (i = 0; i < prom->int_nb_students; i++) 
+        /* Destroy each student in the array (the arena releases them all at once) */
+        for (i = 0; prom->arena_memory == NULL && i < prom->int_nb_students; i++) 
         {
             destroy_student(&prom->student_students[i]);
         }
@@ -248,7 +381,367 @@ void destroy_prom(Prom* prom)
         prom->student_students = NULL;
     }
     
+    /* Free the index and the rankings of the students */
+    destroy_student_index(&prom->index);
+    clear_student_ranking(prom);
+    clear_course_ranking(prom);
+    
+    /* Free the catalog of courses */
+    destroy_catalog(&prom->catalog);
+    
+    /* Free all the names, courses and grades of the arena */
+    destroy_arena(prom->arena_memory);
+    prom->arena_memory = NULL;
+    
+    /* Unmap the binary file the names and grades were read from */
+    if (prom->ptr_mapping != NULL)
+    {
+        munmap(prom->ptr_mapping, prom->size_mapping);
+        prom->ptr_mapping = NULL;
+        prom->size_mapping = 0;
+    }
+    
     /* Reset the number of students */
     prom->int_nb_students = 0;
+    prom->int_max_students = 0;
+    prom->int_nb_unknown_ids = 0;
+}
+
+
+/*!
+ * \fn static int get_grown_capacity(int int_max, int int_needed)
+ * \brief Computes the capacity of a growable array holding at least a number of elements
+ * \param int_max Current capacity of the array
+ * \param int_needed Number of elements the array must hold
+ * \return Capacity doubled from the current one (GROW_MIN_CAPACITY at least)
+ */
+static int get_grown_capacity(int int_max, int int_needed)
+{
+    int capacity;
+    
+    capacity = (int_max > 0 ? int_max : GROW_MIN_CAPACITY);
+    while (capacity < int_needed)
+    {
+        capacity *= 2;
+    }
+    
+    return (capacity);
+}
+
+/*!
+ * \fn float* get_grades_data(const Grades* grades)
+ * \brief Returns the array holding the grades of a Grades structure
+ * \param grades Pointer to the Grades structure
+ * \return tab_grades, or the inline array when the grades are stored inline
+ */
+float* get_grades_data(const Grades* grades)
+{
+    return (grades->tab_grades != NULL ? grades->tab_grades : (float*)grades->tab_inline);
+}
+
+/*!
+ * \fn void borrow_grades(Grades* grades, float* tab_grades, int int_nb_grades)
+ * \brief Makes a Grades structure read its grades from an array it does not own
+ * \param grades Pointer to the Grades structure (its own array already released)
+ * \param tab_grades Grades in a columnar store or a mapped file
+ * \param int_nb_grades Number of grades
+ */
+void borrow_grades(Grades* grades, float* tab_grades, int int_nb_grades)
+{
+    grades->int_nb_grades = int_nb_grades;
+    grades->tab_grades = (int_nb_grades > 0 ? tab_grades : NULL);
+    grades->int_max_grades = (int_nb_grades > 0 ? int_nb_grades : GRADES_INLINE_CAPACITY);
+}
+
+/*!
+ * \fn int reserve_grades_in(Arena* arena, Grades* grades, int int_capacity)
+ * \brief Makes room in a grades array for a number of grades
+ * \param arena Pointer to the arena the grades were created in (NULL: heap)
+ * \param grades Pointer to the Grades structure
+ * \param int_capacity Number of grades the array must hold
+ * \return 0 on success, -1 on allocation error (the array is unchanged)
+ */
+int reserve_grades_in(Arena* arena, Grades* grades, int int_capacity)
+{
+    float* new_grades;
+    
+    /* The inline array is always there */
+    if (grades->tab_grades == NULL && grades->int_max_grades < GRADES_INLINE_CAPACITY)
+    {
+        grades->int_max_grades = GRADES_INLINE_CAPACITY;
+    }
+    if (int_capacity <= grades->int_max_grades)
+    {
+        return (0);
+    }
+    
+    /* Spill the inline grades to an allocated array */
+    if (grades->tab_grades == NULL)
+    {
+        new_grades = (float*)arena_grow(arena, NULL, 0, int_capacity * sizeof(float));
+        if (new_grades != NULL && grades->int_nb_grades > 0)
+        {
+            memcpy(new_grades, grades->tab_inline, grades->int_nb_grades * sizeof(float));
+        }
+    }
+    else
+    {
+        new_grades = (float*)arena_grow(arena, grades->tab_grades, grades->int_max_grades * sizeof(float), int_capacity * sizeof(float));
+    }
+    if (new_grades == NULL)
+    {
+        return (-1);
+    }
+    grades->tab_grades = new_grades;
+    grades->int_max_grades = int_capacity;
+    
+    return (0);
+}
+
+/*!
+ * \fn void shrink_grades_in(Arena* arena, Grades* grades)
+ * \brief Gives back the unused end of a grades array
+ * \param arena Pointer to the arena the grades were created in (NULL: heap)
+ * \param grades Pointer to the Grades structure
+ * 
+ * Grades that fit move back inline. Otherwise an arena does not take back
+ * the end of an array: only heap arrays shrink.
+ */
+void shrink_grades_in(Arena* arena, Grades* grades)
+{
+    float* new_grades;
+    
+    if (grades->tab_grades == NULL)
+    {
+        return;
+    }
+    
+    if (grades->int_nb_grades <= GRADES_INLINE_CAPACITY)
+    {
+        if (grades->int_nb_grades > 0)
+        {
+            memcpy(grades->tab_inline, grades->tab_grades, grades->int_nb_grades * sizeof(float));
+        }
+        arena_grow(arena, grades->tab_grades, grades->int_max_grades * sizeof(float), 0);
+        grades->tab_grades = NULL;
+        grades->int_max_grades = GRADES_INLINE_CAPACITY;
+        return;
+    }
+    if (arena != NULL || grades->int_nb_grades == grades->int_max_grades)
+    {
+        return;
+    }
+    
+    /* Keep the larger array if realloc fails */
+    new_grades = (float*)realloc(grades->tab_grades, grades->int_nb_grades * sizeof(float));
+    if (new_grades != NULL)
+    {
+        grades->tab_grades = new_grades;
+        grades->int_max_grades = grades->int_nb_grades;
+    }
+}
+
+/*!
+ * \fn int push_grade_in(Arena* arena, Grades* grades, float float_grade)
+ * \brief Appends a grade to a grades array, doubling its capacity when full
+ * \param arena Pointer to the arena the grades were created in (NULL: heap)
+ * \param grades Pointer to the Grades structure
+ * \param float_grade Grade to add
+ * \return 0 on success, -1 on allocation error
+ */
+int push_grade_in(Arena* arena, Grades* grades, float float_grade)
+{
+    if (grades->int_nb_grades == grades->int_max_grades
+        && reserve_grades_in(arena, grades, get_grown_capacity(grades->int_max_grades, grades->int_nb_grades + 1)) != 0)
+    {
+        return (-1);
+    }
+    
+    get_grades_data(grades)[grades->int_nb_grades] = float_grade;
+    grades->int_nb_grades++;
+    
+    return (0);
+}
+
+/*!
+ * \fn int reserve_student_courses_in(Arena* arena, Student* student, int int_capacity)
+ * \brief Makes room in the courses array of a student for a number of courses
+ * \param arena Pointer to the arena the student was created in (NULL: heap)
+ * \param student Pointer to the Student structure
+ * \param int_capacity Number of courses the array must hold
+ * \return 0 on success, -1 on allocation error (the array is unchanged)
+ */
+int reserve_student_courses_in(Arena* arena, Student* student, int int_capacity)
+{
+    Course* new_courses;
+    
+    if (int_capacity <= student->int_max_courses)
+    {
+        return (0);
+    }
+    
+    new_courses = (Course*)arena_grow(arena, student->course_courses, student->int_max_courses * sizeof(Course), int_capacity * sizeof(Course));
+    if (new_courses == NULL)
+    {
+        return (-1);
+    }
+    student->course_courses = new_courses;
+    student->int_max_courses = int_capacity;
+    
+    return (0);
+}
+
+/*!
+ * \fn void shrink_student_courses_in(Arena* arena, Student* student)
+ * \brief Gives back the unused end of the courses array of a student and of their grades arrays
+ * \param arena Pointer to the arena the student was created in (NULL: heap)
+ * \param student Pointer to the Student structure
+ */
+void shrink_student_courses_in(Arena* arena, Student* student)
+{
+    Course* new_courses;
+    int i;
+    
+    for (i = 0; i < student->int_nb_courses; i++)
+    {
+        shrink_grades_in(arena, &student->course_courses[i].grades);
+    }
+    
+    if (arena != NULL || student->int_nb_courses == student->int_max_courses)
+    {
+        return;
+    }
+    
+    if (student->int_nb_courses == 0)
+    {
+        free(student->course_courses);
+        student->course_courses = NULL;
+        student->int_max_courses = 0;
+        return;
+    }
+    
+    /* Keep the larger array if realloc fails */
+    new_courses = (Course*)realloc(student->course_courses, student->int_nb_courses * sizeof(Course));
+    if (new_courses != NULL)
+    {
+        student->course_courses = new_courses;
+        student->int_max_courses = student->int_nb_courses;
+    }
+}
+
+/*!
+ * \fn int push_student_course_in(Arena* arena, Student* student, Course course)
+ * \brief Appends a course to the courses array of a student, doubling its capacity when full
+ * \param arena Pointer to the arena the student was created in (NULL: heap)
+ * \param student Pointer to the Student structure
+ * \param course Course to add (the student takes its grades)
+ * \return 0 on success, -1 on allocation error
+ */
+int push_student_course_in(Arena* arena, Student* student, Course course)
+{
+    if (student->int_nb_courses == student->int_max_courses
+        && reserve_student_courses_in(arena, student, get_grown_capacity(student->int_max_courses, student->int_nb_courses + 1)) != 0)
+    {
+        return (-1);
+    }
+    
+    student->course_courses[student->int_nb_courses] = course;
+    student->int_nb_courses++;
+    
+    return (0);
+}
+
+/*!
+ * \fn int reserve_prom_students(Prom* prom, int int_capacity)
+ * \brief Makes room in the students array of a cohort for a number of students
+ * \param prom Pointer to the Prom structure
+ * \param int_capacity Number of students the array must hold
+ * \return 0 on success, -1 on allocation error (the array is unchanged)
+ */
+int reserve_prom_students(Prom* prom, int int_capacity)
+{
+    Student* new_students;
+    
+    if (int_capacity <= prom->int_max_students)
+    {
+        return (0);
+    }
+    
+    new_students = (Student*)realloc(prom->student_students, int_capacity * sizeof(Student));
+    if (new_students == NULL)
+    {
+        return (-1);
+    }
+    prom->student_students = new_students;
+    prom->int_max_students = int_capacity;
+    
+    return (0);
+}
+
+/*!
+ * \fn void shrink_prom_students(Prom* prom)
+ * \brief Gives back the unused end of the students array of a cohort
+ * \param prom Pointer to the Prom structure
+ * 
+ * The array is never freed here: destroy_prom expects it even for an empty cohort.
+ */
+void shrink_prom_students(Prom* prom)
+{
+    Student* new_students;
+    
+    if (prom->int_nb_students == 0 || prom->int_nb_students == prom->int_max_students)
+    {
+        return;
+    }
+    
+    /* Keep the larger array if realloc fails */
+    new_students = (Student*)realloc(prom->student_students, prom->int_nb_students * sizeof(Student));
+    if (new_students != NULL)
+    {
+        prom->student_students = new_students;
+        prom->int_max_students = prom->int_nb_students;
+    }
 }
 
+/*!
+ * \fn int push_prom_student(Prom* prom, Student student)
+ * \brief Appends a student to the students array of a cohort, doubling its capacity when full
+ * \param prom Pointer to the Prom structure
+ * \param student Student to add (the cohort takes its names and courses)
+ * \return 0 on success, -1 on allocation error
+ * 
+ * The index and the rankings are not updated.
+ */
+int push_prom_student(Prom* prom, Student student)
+{
+    if (prom->int_nb_students == prom->int_max_students
+        && reserve_prom_students(prom, get_grown_capacity(prom->int_max_students, prom->int_nb_students + 1)) != 0)
+    {
+        return (-1);
+    }
+    
+    prom->student_students[prom->int_nb_students] = student;
+    prom->int_nb_students++;
+    
+    return (0);
+}
+
+/*!
+ * \fn void shrink_prom_to_fit(Prom* prom)
+ * \brief Gives back the unused end of all the arrays of a cohort once it is loaded
+ * \param prom Pointer to the Prom structure
+ * 
+ * The arrays of an arena keep their size class; the columnar store, the
+ * mapped grades and the lazily loaded courses are not owned by the students
+ * and are left untouched.
+ */
+void shrink_prom_to_fit(Prom* prom)
+{
+    int i;
+    
+    shrink_prom_students(prom);
+    for (i = 0; prom->store_grades == NULL && prom->ptr_mapping == NULL && prom->lazy_pages == NULL && i < prom->int_nb_students; i++)
+    {
+        shrink_student_courses_in(prom->arena_memory, &prom->student_students[i]);
+    }
+}
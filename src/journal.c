@@ -0,0 +1,577 @@
+/*!
+ * \file journal.c
+ * \author Akhatar Abdelhamid <abdelhamid.akhatar@etu.cyu.fr>
+ * \version 1.0
+ * \date November 2, 2025
+ * \brief Journal of grade changes of a binary file
+ * 
+ * This file contains the implementation of the journal described in
+ * journal.h: changes are applied to the promotion at once and buffered,
+ * each commit appends them in a single write.
+ */
+
+#include "journal.h"
+#include "binary.h"
+#include "init.h"
+#include "studentIndex.h"
+#include "courseCatalog.h"
+#include "gradeStore.h"
+#include "lazyLoad.h"
+#include "arena.h"
+#include "update.h"
+#include <stdlib.h>
+#include <string.h>
+#include <stddef.h>
+#include <unistd.h>
+#include <sys/stat.h>
+
+/*! \brief Number of records read at once during a replay */
+#define JOURNAL_READ_RECORDS 4096
+
+/*!
+ * \fn static char* concat_name(const char* str_name, const char* str_suffix)
+ * \brief Allocates the name of a file followed by a suffix
+ * \param str_name Name of the file
+ * \param str_suffix Suffix to append
+ * \return The new name, to free, or NULL on allocation error
+ */
+static char* concat_name(const char* str_name, const char* str_suffix)
+{
+    char* result;
+    size_t size_name;
+    size_t size_suffix;
+    
+    size_name = strlen(str_name);
+    size_suffix = strlen(str_suffix);
+    result = (char*)malloc(size_name + size_suffix + 1);
+    if (result != NULL)
+    {
+        memcpy(result, str_name, size_name);
+        memcpy(result + size_name, str_suffix, size_suffix + 1);
+    }
+    
+    return (result);
+}
+
+/*!
+ * \fn static uint32_t hash_record(const JournalRecord* record)
+ * \brief Hashes the fields of a record before its check (FNV-1a)
+ * \param record Pointer to the record
+ * \return Hash of the record
+ */
+static uint32_t hash_record(const JournalRecord* record)
+{
+    const unsigned char* bytes;
+    uint32_t hash;
+    size_t i;
+    
+    bytes = (const unsigned char*)record;
+    hash = 2166136261u;
+    for (i = 0; i < offsetof(JournalRecord, int_check); i++)
+    {
+        hash = (hash ^ bytes[i]) * 16777619u;
+    }
+    
+    return (hash);
+}
+
+/*!
+ * \fn static int stat_snapshot(const char* str_snapshot, JournalHeader* header)
+ * \brief Fills the header of a journal matching the current snapshot
+ * \param str_snapshot Name of the snapshot
+ * \param header Pointer to the header to fill
+ * \return 0 on success, -1 if the snapshot does not exist
+ */
+static int stat_snapshot(const char* str_snapshot, JournalHeader* header)
+{
+    struct stat st;
+    
+    if (stat(str_snapshot, &st) != 0)
+    {
+        return (-1);
+    }
+    memset(header, 0, sizeof(JournalHeader));
+    header->int_magic = JOURNAL_MAGIC;
+    header->int_version = JOURNAL_VERSION;
+    header->size_snapshot = st.st_size;
+    header->int_inode = st.st_ino;
+    header->int_mtime_sec = st.st_mtim.tv_sec;
+    header->int_mtime_nsec = st.st_mtim.tv_nsec;
+    
+    return (0);
+}
+
+/*!
+ * \fn static int apply_record(Prom* prom, const JournalRecord* record)
+ * \brief Applies a grade change to a promotion
+ * \param prom Pointer to the Prom structure
+ * \param record Pointer to the change
+ * \return 0 on success, -1 if the student, the course or the grade does not exist or on allocation error
+ */
+static int apply_record(Prom* prom, const JournalRecord* record)
+{
+    Student* student;
+    Course* course;
+    int n;
+    
+    /* Grades are written to the courses: a lazy promotion must load all of them */
+    if (materialize_prom(prom) != 0)
+    {
+        return (-1);
+    }
+    student = find_student_by_id(prom, record->int_student_id);
+    course = (student != NULL ? find_student_course(student, record->int_course_id) : NULL);
+    if (course == NULL)
+    {
+        return (-1);
+    }
+    n = course->grades.int_nb_grades;
+    
+    /* A replaced grade is written in place, even in the columnar store */
+    if (record->int_kind == JOURNAL_SET_GRADE)
+    {
+        if (record->int_index < 0 || record->int_index >= n)
+        {
+            return (-1);
+        }
+        get_grades_data(&course->grades)[record->int_index] = record->float_grade;
+        return (0);
+    }
+    
+    /* An added grade moves the others: the columnar store cannot follow */
+    if (release_grade_store(prom) != 0)
+    {
+        return (-1);
+    }
+    return (push_grade_in(prom->arena_memory, &course->grades, record->float_grade));
+}
+
+/*!
+ * \fn static int record_change(Journal* journal, Prom* prom, uint32_t int_kind, int int_student_id, int int_course_id, int int_index, float float_grade)
+ * \brief Applies a grade change to a promotion and adds it to the pending records
+ * \param journal Pointer to the opened journal
+ * \param prom Pointer to the Prom structure
+ * \param int_kind JOURNAL_ADD_GRADE or JOURNAL_SET_GRADE
+ * \param int_student_id Identifier of the student
+ * \param int_course_id ID of the course in the catalog
+ * \param int_index Index of the replaced grade, -1 for an added grade
+ * \param float_grade Grade
+ * \return 0 on success, -1 if the change cannot be applied or on allocation error
+ */
+static int record_change(Journal* journal, Prom* prom, uint32_t int_kind, int int_student_id, int int_course_id,
+                         int int_index, float float_grade)
+{
+    JournalRecord record;
+    JournalRecord* new_pending;
+    int new_max;
+    
+    if (journal->file == NULL)
+    {
+        return (-1);
+    }
+    
+    /* Room for the record first, so that an applied change is always recorded */
+    if (journal->int_nb_pending == journal->int_max_pending)
+    {
+        new_max = (journal->int_max_pending > 0 ? journal->int_max_pending * 2 : 64);
+        new_pending = (JournalRecord*)realloc(journal->record_pending, new_max * sizeof(JournalRecord));
+        if (new_pending == NULL)
+        {
+            return (-1);
+        }
+        journal->record_pending = new_pending;
+        journal->int_max_pending = new_max;
+    }
+    
+    memset(&record, 0, sizeof(JournalRecord));
+    record.int_kind = int_kind;
+    record.int_student_id = int_student_id;
+    record.int_course_id = int_course_id;
+    record.int_index = int_index;
+    record.float_grade = float_grade;
+    record.int_check = hash_record(&record);
+    if (apply_record(prom, &record) != 0)
+    {
+        return (-1);
+    }
+    journal->record_pending[journal->int_nb_pending++] = record;
+    
+    return (0);
+}
+
+/*!
+ * \fn static int sync_file(FILE* file)
+ * \brief Flushes a file and waits until it is on disk
+ * \param file Pointer to the file
+ * \return 0 on success, -1 in case of error
+ */
+static int sync_file(FILE* file)
+{
+    if (fflush(file) != 0 || fsync(fileno(file)) != 0)
+    {
+        return (-1);
+    }
+    
+    return (0);
+}
+
+/*!
+ * \fn static int reset_journal(Journal* journal)
+ * \brief Replaces the journal by an empty one matching the current snapshot
+ * \param journal Pointer to the Journal structure
+ * \return 0 on success, -1 in case of error
+ */
+static int reset_journal(Journal* journal)
+{
+    JournalHeader header;
+    
+    if (journal->file != NULL)
+    {
+        fclose(journal->file);
+        journal->file = NULL;
+    }
+    if (stat_snapshot(journal->str_snapshot, &header) != 0)
+    {
+        return (-1);
+    }
+    
+    journal->file = fopen(journal->str_journal, "wb");
+    if (journal->file == NULL)
+    {
+        return (-1);
+    }
+    if (fwrite(&header, sizeof(JournalHeader), 1, journal->file) != 1 || sync_file(journal->file) != 0)
+    {
+        fclose(journal->file);
+        journal->file = NULL;
+        return (-1);
+    }
+    journal->size_journal = sizeof(JournalHeader);
+    journal->int_nb_pending = 0;
+    
+    return (0);
+}
+
+/*!
+ * \fn static int init_journal(Journal* journal, const char* str_snapshot)
+ * \brief Initializes a closed journal of a snapshot
+ * \param journal Pointer to the Journal structure
+ * \param str_snapshot Name of the snapshot
+ * \return 0 on success, -1 on allocation error
+ */
+static int init_journal(Journal* journal, const char* str_snapshot)
+{
+    memset(journal, 0, sizeof(Journal));
+    journal->size_threshold = JOURNAL_DEFAULT_THRESHOLD;
+    journal->str_snapshot = concat_name(str_snapshot, "");
+    journal->str_journal = concat_name(str_snapshot, ".journal");
+    if (journal->str_snapshot == NULL || journal->str_journal == NULL)
+    {
+        close_journal(journal);
+        return (-1);
+    }
+    
+    return (0);
+}
+
+/*!
+ * \fn static int save_snapshot(const char* str_snapshot, Prom* prom)
+ * \brief Saves a promotion to a temporary file, then renames it over the snapshot
+ * \param str_snapshot Name of the snapshot
+ * \param prom Pointer to the Prom structure
+ * \return 0 on success, -1 in case of error
+ * 
+ * The old snapshot may still be mapped by the promotion: save_prom_binary
+ * replaces it, never truncates it.
+ */
+static int save_snapshot(const char* str_snapshot, Prom* prom)
+{
+    return (save_prom_binary(str_snapshot, prom));
+}
+
+/*!
+ * \fn static int replay_journal(const char* str_journal, const JournalHeader* expected, Prom* prom, uint64_t* size_valid)
+ * \brief Applies the records of a journal matching the snapshot
+ * \param str_journal Name of the journal
+ * \param expected Pointer to the header matching the snapshot
+ * \param prom Pointer to the Prom structure loaded from the snapshot
+ * \param size_valid Pointer receiving the size of the header and the valid records, 0 if the journal does not match
+ * \return Number of records applied
+ */
+static int replay_journal(const char* str_journal, const JournalHeader* expected, Prom* prom, uint64_t* size_valid)
+{
+    JournalHeader header;
+    JournalRecord* records;
+    FILE* file;
+    size_t nb_read;
+    size_t i;
+    int nb_applied;
+    int nb_ignored;
+    int valid;
+    
+    *size_valid = 0;
+    file = fopen(str_journal, "rb");
+    if (file == NULL)
+    {
+        return (0);
+    }
+    if (fread(&header, sizeof(JournalHeader), 1, file) != 1 || memcmp(&header, expected, sizeof(JournalHeader)) != 0)
+    {
+        fclose(file);
+        return (0);
+    }
+    records = (JournalRecord*)malloc(JOURNAL_READ_RECORDS * sizeof(JournalRecord));
+    if (records == NULL)
+    {
+        fclose(file);
+        return (0);
+    }
+    *size_valid = sizeof(JournalHeader);
+    
+    /* Replay up to the first record cut or damaged by a crash */
+    nb_applied = 0;
+    nb_ignored = 0;
+    valid = 1;
+    while (valid && (nb_read = fread(records, sizeof(JournalRecord), JOURNAL_READ_RECORDS, file)) > 0)
+    {
+        for (i = 0; valid && i < nb_read; i++)
+        {
+            if (records[i].int_check != hash_record(&records[i])
+                || (records[i].int_kind != JOURNAL_ADD_GRADE && records[i].int_kind != JOURNAL_SET_GRADE))
+            {
+                valid = 0;
+                continue;
+            }
+            if (apply_record(prom, &records[i]) == 0)
+            {
+                nb_applied++;
+            }
+            else
+            {
+                nb_ignored++;
+            }
+            *size_valid += sizeof(JournalRecord);
+        }
+    }
+    
+    if (nb_ignored > 0)
+    {
+        printf("Warning: %d journal record(s) ignored in %s\n", nb_ignored, str_journal);
+    }
+    free(records);
+    fclose(file);
+    
+    return (nb_applied);
+}
+
+/*!
+ * \fn int create_journal(const char* str_snapshot, Prom* prom, Journal* journal)
+ * \brief Saves a promotion as a new snapshot with an empty journal
+ * \param str_snapshot Name of the snapshot
+ * \param prom Pointer to the Prom structure to save
+ * \param journal Pointer to the Journal structure to open
+ * \return 0 on success, -1 in case of error
+ */
+int create_journal(const char* str_snapshot, Prom* prom, Journal* journal)
+{
+    /* Parameter verification */
+    if (str_snapshot == NULL || prom == NULL || journal == NULL)
+    {
+        return (-1);
+    }
+    
+    if (init_journal(journal, str_snapshot) != 0)
+    {
+        return (-1);
+    }
+    if (save_snapshot(str_snapshot, prom) != 0 || reset_journal(journal) != 0)
+    {
+        close_journal(journal);
+        return (-1);
+    }
+    
+    return (0);
+}
+
+/*!
+ * \fn Prom load_prom_journaled(const char* str_snapshot, Journal* journal)
+ * \brief Restores a promotion from a snapshot and replays its journal
+ * \param str_snapshot Name of the snapshot
+ * \param journal Pointer to the Journal structure to open, NULL to only load
+ * \return Restored Prom structure, or empty structure in case of error
+ */
+Prom load_prom_journaled(const char* str_snapshot, Journal* journal)
+{
+    JournalHeader expected;
+    Prom prom;
+    char* str_journal;
+    uint64_t size_valid;
+    
+    /* Parameter verification */
+    if (str_snapshot == NULL || stat_snapshot(str_snapshot, &expected) != 0)
+    {
+        return (create_prom(0));
+    }
+    
+    prom = load_prom_binary(str_snapshot);
+    str_journal = concat_name(str_snapshot, ".journal");
+    if (str_journal == NULL)
+    {
+        destroy_prom(&prom);
+        return (create_prom(0));
+    }
+    
+    /* The grades changed since the snapshot: its averages are out of date */
+    if (replay_journal(str_journal, &expected, &prom, &size_valid) > 0)
+    {
+        update_course_average(&prom);
+        update_student_average(&prom);
+    }
+    free(str_journal);
+    if (journal == NULL)
+    {
+        return (prom);
+    }
+    
+    /* Append after the last valid record, or start an empty journal */
+    if (init_journal(journal, str_snapshot) != 0)
+    {
+        return (prom);
+    }
+    if (size_valid > 0)
+    {
+        journal->file = fopen(journal->str_journal, "r+b");
+        if (journal->file != NULL
+            && (ftruncate(fileno(journal->file), size_valid) != 0 || fseek(journal->file, size_valid, SEEK_SET) != 0))
+        {
+            fclose(journal->file);
+            journal->file = NULL;
+        }
+        journal->size_journal = size_valid;
+    }
+    if (journal->file == NULL && reset_journal(journal) != 0)
+    {
+        printf("Error: Cannot open journal %s\n", journal->str_journal);
+    }
+    
+    return (prom);
+}
+
+/*!
+ * \fn int journal_add_grade(Journal* journal, Prom* prom, int int_student_id, int int_course_id, float float_grade)
+ * \brief Appends a grade to the course of a student and records it
+ * \param journal Pointer to the opened journal
+ * \param prom Pointer to the Prom structure
+ * \param int_student_id Identifier of the student
+ * \param int_course_id ID of the course in the catalog
+ * \param float_grade Grade to add
+ * \return 0 on success, -1 in case of error
+ */
+int journal_add_grade(Journal* journal, Prom* prom, int int_student_id, int int_course_id, float float_grade)
+{
+    return (record_change(journal, prom, JOURNAL_ADD_GRADE, int_student_id, int_course_id, -1, float_grade));
+}
+
+/*!
+ * \fn int journal_set_grade(Journal* journal, Prom* prom, int int_student_id, int int_course_id, int int_index, float float_grade)
+ * \brief Replaces a grade of the course of a student and records it
+ * \param journal Pointer to the opened journal
+ * \param prom Pointer to the Prom structure
+ * \param int_student_id Identifier of the student
+ * \param int_course_id ID of the course in the catalog
+ * \param int_index Index of the grade in the course
+ * \param float_grade New grade
+ * \return 0 on success, -1 in case of error
+ */
+int journal_set_grade(Journal* journal, Prom* prom, int int_student_id, int int_course_id, int int_index, float float_grade)
+{
+    if (int_index < 0)
+    {
+        return (-1);
+    }
+    
+    return (record_change(journal, prom, JOURNAL_SET_GRADE, int_student_id, int_course_id, int_index, float_grade));
+}
+
+/*!
+ * \fn int commit_journal(Journal* journal, Prom* prom)
+ * \brief Writes the pending records in one write and syncs the journal
+ * \param journal Pointer to the opened journal
+ * \param prom Pointer to the Prom structure the records were applied to
+ * \return 0 on success, -1 in case of error
+ */
+int commit_journal(Journal* journal, Prom* prom)
+{
+    size_t nb_pending;
+    
+    if (journal->file == NULL)
+    {
+        return (-1);
+    }
+    
+    nb_pending = journal->int_nb_pending;
+    if (nb_pending > 0)
+    {
+        /* On error, cut what was written so that the next commit appends after a valid record */
+        if (fwrite(journal->record_pending, sizeof(JournalRecord), nb_pending, journal->file) != nb_pending
+            || sync_file(journal->file) != 0)
+        {
+            clearerr(journal->file);
+            if (ftruncate(fileno(journal->file), journal->size_journal) != 0)
+            {
+                printf("Error: Cannot restore journal %s\n", journal->str_journal);
+            }
+            fseek(journal->file, journal->size_journal, SEEK_SET);
+            return (-1);
+        }
+        journal->size_journal += nb_pending * sizeof(JournalRecord);
+        journal->int_nb_pending = 0;
+    }
+    
+    if (journal->size_threshold > 0 && journal->size_journal > journal->size_threshold)
+    {
+        return (compact_journal(journal, prom));
+    }
+    
+    return (0);
+}
+
+/*!
+ * \fn int compact_journal(Journal* journal, Prom* prom)
+ * \brief Folds the journal into a new snapshot of the promotion and empties it
+ * \param journal Pointer to the opened journal
+ * \param prom Pointer to the Prom structure the records were applied to
+ * \return 0 on success, -1 in case of error
+ */
+int compact_journal(Journal* journal, Prom* prom)
+{
+    if (journal->str_snapshot == NULL)
+    {
+        return (-1);
+    }
+    
+    /* Until the new journal is written, the old one no longer matches the snapshot and is ignored */
+    if (save_snapshot(journal->str_snapshot, prom) != 0)
+    {
+        return (-1);
+    }
+    
+    return (reset_journal(journal));
+}
+
+/*!
+ * \fn void close_journal(Journal* journal)
+ * \brief Closes a journal, dropping the records not committed
+ * \param journal Pointer to the Journal structure
+ */
+void close_journal(Journal* journal)
+{
+    if (journal->file != NULL)
+    {
+        fclose(journal->file);
+    }
+    free(journal->str_snapshot);
+    free(journal->str_journal);
+    free(journal->record_pending);
+    memset(journal, 0, sizeof(Journal));
+}
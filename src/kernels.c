@@ -0,0 +1,324 @@
+/*!
+ * \file kernels.c
+ * \author Akhatar Abdelhamid <abdelhamid.akhatar@etu.cyu.fr>
+ * \version 1.0
+ * \date November 2, 2025
+ * \brief Vectorized average kernels
+ * 
+ * This file contains the scalar, SSE2 and AVX2 versions of the sum and
+ * dot product kernels, and their selection at run time.
+ */
+
+#include "kernels.h"
+#include <stdatomic.h>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define KERNELS_X86 1
+#include <immintrin.h>
+#endif
+
+/*! \brief Selected level, -1 until the first call (read by the pool workers) */
+static atomic_int int_kernel_level = -1;
+
+/*!
+ * \fn static float sum_floats_scalar(const float* tab_values, int int_nb_values)
+ * \brief Scalar sum, from left to right
+ */
+static float sum_floats_scalar(const float* tab_values, int int_nb_values)
+{
+    float sum;
+    int i;
+    
+    sum = 0.0f;
+    for (i = 0; i < int_nb_values; i++)
+    {
+        sum += tab_values[i];
+    }
+    
+    return (sum);
+}
+
+/*!
+ * \fn static float dot_floats_scalar(const float* tab_a, const float* tab_b, int int_nb_values)
+ * \brief Scalar dot product, from left to right
+ */
+static float dot_floats_scalar(const float* tab_a, const float* tab_b, int int_nb_values)
+{
+    float sum;
+    int i;
+    
+    sum = 0.0f;
+    for (i = 0; i < int_nb_values; i++)
+    {
+        sum += tab_a[i] * tab_b[i];
+    }
+    
+    return (sum);
+}
+
+#ifdef KERNELS_X86
+
+/*!
+ * \fn static float horizontal_sum_sse2(__m128 v)
+ * \brief Adds the 4 lanes of an SSE register
+ */
+__attribute__((target("sse2")))
+static float horizontal_sum_sse2(__m128 v)
+{
+    __m128 high;
+    
+    high = _mm_movehl_ps(v, v);
+    v = _mm_add_ps(v, high);
+    high = _mm_shuffle_ps(v, v, 0x1);
+    v = _mm_add_ss(v, high);
+    
+    return (_mm_cvtss_f32(v));
+}
+
+/*!
+ * \fn static float sum_floats_sse2(const float* tab_values, int int_nb_values)
+ * \brief SSE2 sum, 4 partial sums
+ */
+__attribute__((target("sse2")))
+static float sum_floats_sse2(const float* tab_values, int int_nb_values)
+{
+    __m128 acc;
+    float sum;
+    int i;
+    
+    acc = _mm_setzero_ps();
+    for (i = 0; i + 4 <= int_nb_values; i += 4)
+    {
+        acc = _mm_add_ps(acc, _mm_loadu_ps(tab_values + i));
+    }
+    
+    /* Remaining values */
+    sum = horizontal_sum_sse2(acc);
+    for (; i < int_nb_values; i++)
+    {
+        sum += tab_values[i];
+    }
+    
+    return (sum);
+}
+
+/*!
+ * \fn static float dot_floats_sse2(const float* tab_a, const float* tab_b, int int_nb_values)
+ * \brief SSE2 dot product, 4 partial sums
+ */
+__attribute__((target("sse2")))
+static float dot_floats_sse2(const float* tab_a, const float* tab_b, int int_nb_values)
+{
+    __m128 acc;
+    float sum;
+    int i;
+    
+    acc = _mm_setzero_ps();
+    for (i = 0; i + 4 <= int_nb_values; i += 4)
+    {
+        acc = _mm_add_ps(acc, _mm_mul_ps(_mm_loadu_ps(tab_a + i), _mm_loadu_ps(tab_b + i)));
+    }
+    
+    /* Remaining values */
+    sum = horizontal_sum_sse2(acc);
+    for (; i < int_nb_values; i++)
+    {
+        sum += tab_a[i] * tab_b[i];
+    }
+    
+    return (sum);
+}
+
+/*!
+ * \fn static float horizontal_sum_avx2(__m256 v)
+ * \brief Adds the 8 lanes of an AVX register
+ */
+__attribute__((target("avx2")))
+static float horizontal_sum_avx2(__m256 v)
+{
+    __m128 low;
+    __m128 high;
+    
+    low = _mm256_castps256_ps128(v);
+    high = _mm256_extractf128_ps(v, 1);
+    low = _mm_add_ps(low, high);
+    high = _mm_movehl_ps(low, low);
+    low = _mm_add_ps(low, high);
+    high = _mm_shuffle_ps(low, low, 0x1);
+    low = _mm_add_ss(low, high);
+    
+    return (_mm_cvtss_f32(low));
+}
+
+/*!
+ * \fn static float sum_floats_avx2(const float* tab_values, int int_nb_values)
+ * \brief AVX2 sum, 8 partial sums
+ */
+__attribute__((target("avx2")))
+static float sum_floats_avx2(const float* tab_values, int int_nb_values)
+{
+    __m256 acc;
+    float sum;
+    int i;
+    
+    acc = _mm256_setzero_ps();
+    for (i = 0; i + 8 <= int_nb_values; i += 8)
+    {
+        acc = _mm256_add_ps(acc, _mm256_loadu_ps(tab_values + i));
+    }
+    
+    /* Remaining values */
+    sum = horizontal_sum_avx2(acc);
+    for (; i < int_nb_values; i++)
+    {
+        sum += tab_values[i];
+    }
+    
+    return (sum);
+}
+
+/*!
+ * \fn static float dot_floats_avx2(const float* tab_a, const float* tab_b, int int_nb_values)
+ * \brief AVX2 dot product, 8 partial sums (no FMA, so that products are rounded as in the scalar loop)
+ */
+__attribute__((target("avx2")))
+static float dot_floats_avx2(const float* tab_a, const float* tab_b, int int_nb_values)
+{
+    __m256 acc;
+    float sum;
+    int i;
+    
+    acc = _mm256_setzero_ps();
+    for (i = 0; i + 8 <= int_nb_values; i += 8)
+    {
+        acc = _mm256_add_ps(acc, _mm256_mul_ps(_mm256_loadu_ps(tab_a + i), _mm256_loadu_ps(tab_b + i)));
+    }
+    
+    /* Remaining values */
+    sum = horizontal_sum_avx2(acc);
+    for (; i < int_nb_values; i++)
+    {
+        sum += tab_a[i] * tab_b[i];
+    }
+    
+    return (sum);
+}
+
+#endif
+
+/*!
+ * \fn static int get_supported_level(void)
+ * \brief Returns the best level supported by the processor
+ * \return KERNEL_SCALAR, KERNEL_SSE2 or KERNEL_AVX2
+ */
+static int get_supported_level(void)
+{
+#ifdef KERNELS_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2"))
+    {
+        return (KERNEL_AVX2);
+    }
+    if (__builtin_cpu_supports("sse2"))
+    {
+        return (KERNEL_SSE2);
+    }
+#endif
+    return (KERNEL_SCALAR);
+}
+
+/*!
+ * \fn int set_kernel_level(int int_level)
+ * \brief Selects the instruction set used by the kernels
+ * \param int_level Requested level
+ * \return Selected level
+ */
+int set_kernel_level(int int_level)
+{
+    int supported;
+    
+    supported = get_supported_level();
+    if (int_level > supported)
+    {
+        int_level = supported;
+    }
+    if (int_level < KERNEL_SCALAR)
+    {
+        int_level = KERNEL_SCALAR;
+    }
+    atomic_store(&int_kernel_level, int_level);
+    
+    return (int_level);
+}
+
+/*!
+ * \fn int get_kernel_level(void)
+ * \brief Returns the instruction set used by the kernels
+ * \return KERNEL_SCALAR, KERNEL_SSE2 or KERNEL_AVX2
+ */
+int get_kernel_level(void)
+{
+    int level;
+    int expected;
+    
+    /* Workers may race on the first call: they all compute the same level */
+    level = atomic_load(&int_kernel_level);
+    if (level < 0)
+    {
+        expected = -1;
+        level = get_supported_level();
+        if (!atomic_compare_exchange_strong(&int_kernel_level, &expected, level))
+        {
+            level = expected;
+        }
+    }
+    
+    return (level);
+}
+
+/*!
+ * \fn float sum_floats(const float* tab_values, int int_nb_values)
+ * \brief Computes the sum of an array of floats
+ * \param tab_values Array of values
+ * \param int_nb_values Number of values
+ * \return Sum of the values
+ */
+float sum_floats(const float* tab_values, int int_nb_values)
+{
+#ifdef KERNELS_X86
+    switch (int_nb_values < KERNEL_MIN_VECTOR ? KERNEL_SCALAR : get_kernel_level())
+    {
+        case KERNEL_AVX2:
+            return (sum_floats_avx2(tab_values, int_nb_values));
+        case KERNEL_SSE2:
+            return (sum_floats_sse2(tab_values, int_nb_values));
+        default:
+            break;
+    }
+#endif
+    return (sum_floats_scalar(tab_values, int_nb_values));
+}
+
+/*!
+ * \fn float dot_floats(const float* tab_a, const float* tab_b, int int_nb_values)
+ * \brief Computes the dot product of two arrays of floats
+ * \param tab_a First array
+ * \param tab_b Second array
+ * \param int_nb_values Number of values in each array
+ * \return Sum of the products tab_a[i] * tab_b[i]
+ */
+float dot_floats(const float* tab_a, const float* tab_b, int int_nb_values)
+{
+#ifdef KERNELS_X86
+    switch (int_nb_values < KERNEL_MIN_VECTOR ? KERNEL_SCALAR : get_kernel_level())
+    {
+        case KERNEL_AVX2:
+            return (dot_floats_avx2(tab_a, tab_b, int_nb_values));
+        case KERNEL_SSE2:
+            return (dot_floats_sse2(tab_a, tab_b, int_nb_values));
+        default:
+            break;
+    }
+#endif
+    return (dot_floats_scalar(tab_a, tab_b, int_nb_values));
+}
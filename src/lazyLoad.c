@@ -0,0 +1,392 @@
+/*!
+ * \file lazyLoad.c
+ * \author Akhatar Abdelhamid <abdelhamid.akhatar@etu.cyu.fr>
+ * \version 1.0
+ * \date November 2, 2025
+ * \brief Lazy loading module of binary files
+ * 
+ * This file contains the implementation of the lazy loading of a
+ * version 2 binary file: the student headers are read from the mapping
+ * at load time, the course arrays are built on first use and freed
+ * again by a clock sweep when they exceed the memory budget.
+ */
+
+#include "lazyLoad.h"
+#include "binary.h"
+#include "init.h"
+#include "studentIndex.h"
+#include "arena.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <unistd.h>
+#include <sys/mman.h>
+
+/*!
+ * \fn static size_t get_student_cost(const PromImage* image, int int_position)
+ * \brief Returns the bytes used by the courses and grades of a resident student
+ * \param image Pointer to the view of the file
+ * \param int_position Position of the student
+ * \return Size of the course array plus the size of the grades
+ */
+static size_t get_student_cost(const PromImage* image, int int_position)
+{
+    int first;
+    int last;
+    
+    first = image->tab_student_offsets[int_position];
+    last = image->tab_student_offsets[int_position + 1];
+    
+    return ((size_t)(last - first) * sizeof(Course)
+            + (size_t)(image->tab_course_offsets[last] - image->tab_course_offsets[first]) * sizeof(float));
+}
+
+/*!
+ * \fn static void release_grade_pages(const PromImage* image, int int_position)
+ * \brief Gives the pages holding the grades of a student back to the system
+ * \param image Pointer to the view of the file
+ * \param int_position Position of the student
+ * 
+ * The mapping is private and never written in lazy mode, so the pages
+ * are only dropped: they are read again from the file on next access,
+ * which also makes it harmless to drop pages shared with other students.
+ */
+static void release_grade_pages(const PromImage* image, int int_position)
+{
+    uintptr_t begin;
+    uintptr_t end;
+    uintptr_t page;
+    
+    begin = (uintptr_t)(image->tab_grades + image->tab_course_offsets[image->tab_student_offsets[int_position]]);
+    end = (uintptr_t)(image->tab_grades + image->tab_course_offsets[image->tab_student_offsets[int_position + 1]]);
+    if (end <= begin)
+    {
+        return;
+    }
+    
+    /* Widen the range to whole pages */
+    page = (uintptr_t)sysconf(_SC_PAGESIZE);
+    begin -= begin % page;
+    end += (page - end % page) % page;
+    madvise((void*)begin, end - begin, MADV_DONTNEED);
+}
+
+/*!
+ * \fn static void evict_students(LazyPages* lazy, Student* students, int int_keep)
+ * \brief Evicts resident students, oldest unused first, until the budget is met
+ * \param lazy Paging state
+ * \param students Student array of the promotion
+ * \param int_keep Position of a student that must stay resident, -1 for none
+ */
+static void evict_students(LazyPages* lazy, Student* students, int int_keep)
+{
+    int nb_students;
+    int nb_steps;
+    int position;
+    
+    nb_students = lazy->image.int_nb_students;
+    
+    /* Each resident student is met at most twice: once to clear its reference bit, once to evict it */
+    nb_steps = 2 * lazy->int_nb_resident;
+    while (lazy->size_budget > 0 && lazy->size_resident > lazy->size_budget && nb_steps > 0)
+    {
+        position = lazy->tab_queue[lazy->int_queue_head];
+        lazy->int_queue_head = (lazy->int_queue_head + 1) % nb_students;
+        lazy->int_nb_resident--;
+        nb_steps--;
+    
+        /* Second chance: back to the end of the queue */
+        if (position == int_keep || lazy->tab_referenced[position])
+        {
+            lazy->tab_referenced[position] = 0;
+            lazy->tab_queue[(lazy->int_queue_head + lazy->int_nb_resident) % nb_students] = position;
+            lazy->int_nb_resident++;
+            continue;
+        }
+    
+        lazy->size_resident -= get_student_cost(&lazy->image, position);
+        free(students[position].course_courses);
+        students[position].course_courses = NULL;
+        students[position].int_max_courses = 0;
+        release_grade_pages(&lazy->image, position);
+    }
+}
+
+/*!
+ * \fn static int load_student_headers(Prom* prom, const PromImage* image)
+ * \brief Fills an empty promotion with the catalog and the student headers of an image
+ * \param prom Pointer to an empty promotion created by create_arena_prom
+ * \param image Pointer to the located view of the file
+ * \return 0 on success, -1 on invalid record or allocation error
+ */
+static int load_student_headers(Prom* prom, const PromImage* image)
+{
+    const BinStudentRecord* record;
+    Student* student;
+    int i;
+    
+    /* The names are borrowed from the image, as in load_prom_image */
+    if (prom->arena_memory == NULL || load_image_catalog(image, prom) != 0)
+    {
+        return (-1);
+    }
+    
+    free(prom->student_students);
+    prom->student_students = (Student*)malloc((image->int_nb_students > 0 ? image->int_nb_students : 1) * sizeof(Student));
+    prom->int_max_students = 0;
+    if (prom->student_students == NULL)
+    {
+        return (-1);
+    }
+    prom->int_max_students = (image->int_nb_students > 0 ? image->int_nb_students : 1);
+    
+    /* Students: names point into the image, courses are paged in on demand */
+    for (i = 0; i < image->int_nb_students; i++)
+    {
+        if (check_image_header(image, i) != 0)
+        {
+            return (-1);
+        }
+        record = &image->record_students[i];
+        student = &prom->student_students[i];
+        student->int_id = record->int_id;
+        student->int_age = record->int_age;
+        student->float_average = record->float_average;
+        student->char_last_name = (char*)get_image_string(image, record->int_last_name);
+        student->char_first_name = (char*)get_image_string(image, record->int_first_name);
+        student->int_nb_courses = image->tab_student_offsets[i + 1] - image->tab_student_offsets[i];
+        student->course_courses = NULL;
+        student->int_max_courses = 0;
+        prom->int_nb_students = i + 1;
+    }
+    
+    /* Index the students by identifier */
+    return (build_student_index(prom));
+}
+
+/*!
+ * \fn Prom load_prom_binary_lazy(const char* str_filename, size_t size_budget)
+ * \brief Restores the student headers of a version 2 binary file, courses on demand
+ * \param str_filename Name of the source binary file
+ * \param size_budget Bytes of courses and grades kept in memory, 0 for no limit
+ * \return Restored Prom structure, or empty structure on error
+ */
+Prom load_prom_binary_lazy(const char* str_filename, size_t size_budget)
+{
+    LazyPages* lazy;
+    Prom prom;
+    int nb_students;
+    
+    /* Parameter verification */
+    if (str_filename == NULL)
+    {
+        return (create_prom(0));
+    }
+    
+    lazy = (LazyPages*)calloc(1, sizeof(LazyPages));
+    if (lazy == NULL)
+    {
+        return (create_prom(0));
+    }
+    
+    /* Only the sections are checked now, the records of a student when they are read */
+    if (map_prom_sections(str_filename, &lazy->image) != 0)
+    {
+        free(lazy);
+        return (load_prom_binary(str_filename));
+    }
+    madvise((void*)lazy->image.ptr_data, lazy->image.size_data, MADV_RANDOM);
+    
+    /* The promotion owns the paging state, and through it the mapping, from now on */
+    nb_students = lazy->image.int_nb_students;
+    lazy->size_budget = size_budget;
+    lazy->tab_referenced = (unsigned char*)calloc(nb_students > 0 ? nb_students : 1, sizeof(unsigned char));
+    lazy->tab_queue = (int*)malloc((nb_students > 0 ? nb_students : 1) * sizeof(int));
+    prom = create_arena_prom(0);
+    prom.lazy_pages = lazy;
+    if (lazy->tab_referenced == NULL || lazy->tab_queue == NULL || load_student_headers(&prom, &lazy->image) != 0)
+    {
+        printf("Error: Cannot load binary file %s\n", str_filename);
+        destroy_prom(&prom);
+        return (create_prom(0));
+    }
+    
+    printf("Promotion loaded successfully from binary file: %s\n", str_filename);
+    return (prom);
+}
+
+/*!
+ * \fn int page_student_courses(const Prom* prom, int int_position)
+ * \brief Makes the courses of a student resident before they are read
+ * \param prom Pointer to the Prom structure
+ * \param int_position Position of the student in the student array
+ * \return 0 if course_courses can be read, -1 on error
+ */
+int page_student_courses(const Prom* prom, int int_position)
+{
+    LazyPages* lazy;
+    Student* student;
+    Course* courses;
+    
+    lazy = prom->lazy_pages;
+    if (lazy == NULL)
+    {
+        return (0);
+    }
+    
+    /* Already resident (or nothing to read): only remember the use */
+    student = &prom->student_students[int_position];
+    lazy->tab_referenced[int_position] = 1;
+    if (student->course_courses != NULL || student->int_nb_courses == 0)
+    {
+        return (0);
+    }
+    
+    /* Check and read the records of the student */
+    if (check_image_student(&lazy->image, int_position) != 0)
+    {
+        return (-1);
+    }
+    courses = (Course*)malloc(student->int_nb_courses * sizeof(Course));
+    if (courses == NULL)
+    {
+        return (-1);
+    }
+    read_image_courses(&lazy->image, int_position, courses);
+    student->course_courses = courses;
+    student->int_max_courses = student->int_nb_courses;
+    
+    /* Queue it as the newest resident student, then make room if needed */
+    lazy->tab_queue[(lazy->int_queue_head + lazy->int_nb_resident) % lazy->image.int_nb_students] = int_position;
+    lazy->int_nb_resident++;
+    lazy->size_resident += get_student_cost(&lazy->image, int_position);
+    evict_students(lazy, prom->student_students, int_position);
+    
+    return (0);
+}
+
+/*!
+ * \fn int materialize_prom(Prom* prom)
+ * \brief Loads all the courses of a lazy promotion and ends lazy loading
+ * \param prom Pointer to the Prom structure
+ * \return 0 on success, -1 on error
+ */
+int materialize_prom(Prom* prom)
+{
+    LazyPages* lazy;
+    GradeStore* store;
+    Course** courses;
+    Student* student;
+    int i;
+    
+    lazy = prom->lazy_pages;
+    if (lazy == NULL)
+    {
+        return (0);
+    }
+    
+    /* Allocate every course array in the arena before changing anything */
+    store = create_image_store(&lazy->image);
+    courses = (Course**)malloc((prom->int_nb_students > 0 ? prom->int_nb_students : 1) * sizeof(Course*));
+    if (store == NULL || courses == NULL)
+    {
+        free(store);
+        free(courses);
+        return (-1);
+    }
+    for (i = 0; i < prom->int_nb_students; i++)
+    {
+        student = &prom->student_students[i];
+        courses[i] = (Course*)arena_grow(prom->arena_memory, NULL, 0, student->int_nb_courses * sizeof(Course));
+        if (student->int_nb_courses > 0 && (courses[i] == NULL || check_image_student(&lazy->image, i) != 0))
+        {
+            free(store);
+            free(courses);
+            return (-1);
+        }
+    }
+    
+    /* Read all the courses, replacing the resident copies */
+    for (i = 0; i < prom->int_nb_students; i++)
+    {
+        student = &prom->student_students[i];
+        if (student->int_nb_courses > 0)
+        {
+            read_image_courses(&lazy->image, i, courses[i]);
+        }
+        free(student->course_courses);
+        student->course_courses = courses[i];
+        student->int_max_courses = (courses[i] != NULL ? student->int_nb_courses : 0);
+    }
+    free(courses);
+    prom->store_grades = store;
+    
+    /* The promotion now owns the mapping, as after load_prom_binary */
+    madvise((void*)lazy->image.ptr_data, lazy->image.size_data, MADV_NORMAL);
+    prom->ptr_mapping = (void*)lazy->image.ptr_data;
+    prom->size_mapping = lazy->image.size_data;
+    free(lazy->tab_referenced);
+    free(lazy->tab_queue);
+    free(lazy);
+    prom->lazy_pages = NULL;
+    
+    return (0);
+}
+
+/*!
+ * \fn void set_lazy_budget(Prom* prom, size_t size_budget)
+ * \brief Changes the memory budget of a lazy promotion
+ * \param prom Pointer to the Prom structure
+ * \param size_budget Bytes of courses and grades kept in memory, 0 for no limit
+ */
+void set_lazy_budget(Prom* prom, size_t size_budget)
+{
+    if (prom->lazy_pages != NULL)
+    {
+        prom->lazy_pages->size_budget = size_budget;
+        evict_students(prom->lazy_pages, prom->student_students, -1);
+    }
+}
+
+/*!
+ * \fn size_t get_lazy_resident_size(const Prom* prom)
+ * \brief Returns the bytes of courses and grades currently paged in
+ * \param prom Pointer to the Prom structure
+ * \return Resident bytes
+ */
+size_t get_lazy_resident_size(const Prom* prom)
+{
+    return (prom->lazy_pages != NULL ? prom->lazy_pages->size_resident : 0);
+}
+
+/*!
+ * \fn void destroy_lazy_pages(Prom* prom)
+ * \brief Frees the resident courses and the paging state, and unmaps the file
+ * \param prom Pointer to the Prom structure
+ */
+void destroy_lazy_pages(Prom* prom)
+{
+    LazyPages* lazy;
+    int i;
+    
+    lazy = prom->lazy_pages;
+    if (lazy == NULL)
+    {
+        return;
+    }
+    
+    /* Resident course arrays are allocated one by one, outside the arena */
+    for (i = 0; prom->student_students != NULL && i < prom->int_nb_students; i++)
+    {
+        free(prom->student_students[i].course_courses);
+        prom->student_students[i].course_courses = NULL;
+        prom->student_students[i].int_max_courses = 0;
+    }
+    
+    close_prom_image(&lazy->image);
+    free(lazy->tab_referenced);
+    free(lazy->tab_queue);
+    free(lazy);
+    prom->lazy_pages = NULL;
+}
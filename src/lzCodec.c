@@ -0,0 +1,305 @@
+/*!
+ * \file lzCodec.c
+ * \author Akhatar Abdelhamid <abdelhamid.akhatar@etu.cyu.fr>
+ * \version 1.0
+ * \date November 2, 2025
+ * \brief LZ compression module
+ * 
+ * This file contains the implementation of the LZ codec described in
+ * lzCodec.h.
+ */
+
+#include "lzCodec.h"
+#include <string.h>
+
+/*!
+ * \fn static uint32_t read_u32(const uint8_t* ptr)
+ * \brief Reads 4 bytes at any alignment
+ * \param ptr First byte
+ * \return The 4 bytes as a number
+ */
+static uint32_t read_u32(const uint8_t* ptr)
+{
+    uint32_t value;
+    
+    memcpy(&value, ptr, sizeof(uint32_t));
+    
+    return (value);
+}
+
+/*!
+ * \fn static uint32_t hash_sequence(uint32_t int_sequence)
+ * \brief Hashes a 4-byte sequence into the table of the compressor
+ * \param int_sequence The 4 bytes
+ * \return Index in the table
+ */
+static uint32_t hash_sequence(uint32_t int_sequence)
+{
+    return ((int_sequence * 2654435761u) >> (32 - LZ_HASH_BITS));
+}
+
+/*!
+ * \fn static size_t put_length(uint8_t* dst, size_t size_pos, size_t size_dst, size_t size_len)
+ * \brief Writes the continuation of a length of 15 or more
+ * \param dst Destination
+ * \param size_pos Position in the destination
+ * \param size_dst Size of the destination
+ * \param size_len Length minus 15
+ * \return New position, or size_dst + 1 if the destination is full
+ */
+static size_t put_length(uint8_t* dst, size_t size_pos, size_t size_dst, size_t size_len)
+{
+    while (size_len >= 255)
+    {
+        if (size_pos >= size_dst)
+        {
+            return (size_dst + 1);
+        }
+        dst[size_pos++] = 255;
+        size_len -= 255;
+    }
+    if (size_pos >= size_dst)
+    {
+        return (size_dst + 1);
+    }
+    dst[size_pos++] = (uint8_t)size_len;
+    
+    return (size_pos);
+}
+
+/*!
+ * \fn static size_t put_sequence(uint8_t* dst, size_t size_pos, size_t size_dst, const uint8_t* literals, size_t size_literals, size_t size_offset, size_t size_match)
+ * \brief Writes a sequence: token, literals, then the match if any
+ * \param dst Destination
+ * \param size_pos Position in the destination
+ * \param size_dst Size of the destination
+ * \param literals First literal
+ * \param size_literals Number of literals
+ * \param size_offset Distance of the match, 0 for the last sequence
+ * \param size_match Length of the match
+ * \return New position, or size_dst + 1 if the destination is full
+ */
+static size_t put_sequence(uint8_t* dst, size_t size_pos, size_t size_dst, const uint8_t* literals,
+                           size_t size_literals, size_t size_offset, size_t size_match)
+{
+    size_t size_code;
+    uint8_t token;
+    
+    size_code = (size_offset > 0 ? size_match - LZ_MIN_MATCH : 0);
+    token = (uint8_t)(((size_literals < 15 ? size_literals : 15) << 4) | (size_code < 15 ? size_code : 15));
+    if (size_pos >= size_dst)
+    {
+        return (size_dst + 1);
+    }
+    dst[size_pos++] = token;
+    
+    /* Literals */
+    if (size_literals >= 15)
+    {
+        size_pos = put_length(dst, size_pos, size_dst, size_literals - 15);
+    }
+    if (size_pos > size_dst || size_dst - size_pos < size_literals)
+    {
+        return (size_dst + 1);
+    }
+    memcpy(dst + size_pos, literals, size_literals);
+    size_pos += size_literals;
+    
+    /* Match */
+    if (size_offset > 0)
+    {
+        if (size_dst - size_pos < 2)
+        {
+            return (size_dst + 1);
+        }
+        dst[size_pos++] = (uint8_t)(size_offset & 0xFF);
+        dst[size_pos++] = (uint8_t)(size_offset >> 8);
+        if (size_code >= 15)
+        {
+            size_pos = put_length(dst, size_pos, size_dst, size_code - 15);
+        }
+    }
+    
+    return (size_pos);
+}
+
+/*!
+ * \fn static int get_length(const uint8_t* src, size_t* size_pos, size_t size_src, size_t* size_len)
+ * \brief Reads the continuation of a length of 15 or more
+ * \param src Compressed block
+ * \param size_pos Pointer to the position in the block, updated
+ * \param size_src Size of the block
+ * \param size_len Pointer to the length, increased
+ * \return 0 on success, -1 if the block ends first
+ */
+static int get_length(const uint8_t* src, size_t* size_pos, size_t size_src, size_t* size_len)
+{
+    uint8_t byte;
+    
+    do
+    {
+        if (*size_pos >= size_src)
+        {
+            return (-1);
+        }
+        byte = src[(*size_pos)++];
+        *size_len += byte;
+    } while (byte == 255);
+    
+    return (0);
+}
+
+/*!
+ * \fn size_t get_lz_bound(size_t size_src)
+ * \brief Returns the largest size of a compressed block
+ * \param size_src Size of the data to compress
+ * \return Size of a destination always large enough
+ */
+size_t get_lz_bound(size_t size_src)
+{
+    /* One token and one length byte per 255 literals in the worst case */
+    return (size_src + size_src / 255 + 16);
+}
+
+/*!
+ * \fn size_t lz_compress(const uint8_t* src, size_t size_src, uint8_t* dst, size_t size_dst)
+ * \brief Compresses a block
+ * \param src Data to compress
+ * \param size_src Size of the data
+ * \param dst Destination of the compressed block
+ * \param size_dst Size of the destination
+ * \return Size of the compressed block, or 0 if it does not fit
+ */
+size_t lz_compress(const uint8_t* src, size_t size_src, uint8_t* dst, size_t size_dst)
+{
+    uint32_t table[1 << LZ_HASH_BITS];
+    uint32_t sequence;
+    uint32_t hash;
+    size_t size_candidate;
+    size_t size_anchor;
+    size_t size_match;
+    size_t size_pos;
+    size_t i;
+    
+    /* Positions are stored plus one: 0 is an empty entry */
+    memset(table, 0, sizeof(table));
+    size_anchor = 0;
+    size_pos = 0;
+    i = 0;
+    while (size_src >= LZ_MIN_MATCH && i <= size_src - LZ_MIN_MATCH)
+    {
+        sequence = read_u32(src + i);
+        hash = hash_sequence(sequence);
+        size_candidate = table[hash];
+        table[hash] = (uint32_t)(i + 1);
+        
+        if (size_candidate == 0 || i - (size_candidate - 1) > LZ_MAX_OFFSET
+            || read_u32(src + size_candidate - 1) != sequence)
+        {
+            i++;
+            continue;
+        }
+        size_candidate--;
+        
+        /* Extend the match as far as possible, overlapping the current position if needed */
+        size_match = LZ_MIN_MATCH;
+        while (i + size_match < size_src && src[size_candidate + size_match] == src[i + size_match])
+        {
+            size_match++;
+        }
+        size_pos = put_sequence(dst, size_pos, size_dst, src + size_anchor, i - size_anchor,
+                                i - size_candidate, size_match);
+        if (size_pos > size_dst)
+        {
+            return (0);
+        }
+        i += size_match;
+        size_anchor = i;
+    }
+    
+    /* Last sequence: the remaining literals */
+    size_pos = put_sequence(dst, size_pos, size_dst, src + size_anchor, size_src - size_anchor, 0, 0);
+    
+    return (size_pos > size_dst ? 0 : size_pos);
+}
+
+/*!
+ * \fn int lz_decompress(const uint8_t* src, size_t size_src, uint8_t* dst, size_t size_dst)
+ * \brief Decompresses a block
+ * \param src Compressed block
+ * \param size_src Size of the compressed block
+ * \param dst Destination of the data
+ * \param size_dst Exact size of the data
+ * \return 0 on success, -1 on invalid block
+ */
+int lz_decompress(const uint8_t* src, size_t size_src, uint8_t* dst, size_t size_dst)
+{
+    size_t size_in;
+    size_t size_out;
+    size_t size_literals;
+    size_t size_match;
+    size_t size_offset;
+    size_t k;
+    uint8_t token;
+    
+    size_in = 0;
+    size_out = 0;
+    while (size_in < size_src)
+    {
+        token = src[size_in++];
+        
+        /* Literals */
+        size_literals = token >> 4;
+        if (size_literals == 15 && get_length(src, &size_in, size_src, &size_literals) != 0)
+        {
+            return (-1);
+        }
+        if (size_literals > size_src - size_in || size_literals > size_dst - size_out)
+        {
+            return (-1);
+        }
+        memcpy(dst + size_out, src + size_in, size_literals);
+        size_in += size_literals;
+        size_out += size_literals;
+        
+        /* The last sequence has no match */
+        if (size_in == size_src)
+        {
+            break;
+        }
+        
+        /* Match */
+        if (size_src - size_in < 2)
+        {
+            return (-1);
+        }
+        size_offset = (size_t)src[size_in] | ((size_t)src[size_in + 1] << 8);
+        size_in += 2;
+        size_match = (token & 0x0F);
+        if (size_match == 15 && get_length(src, &size_in, size_src, &size_match) != 0)
+        {
+            return (-1);
+        }
+        size_match += LZ_MIN_MATCH;
+        if (size_offset == 0 || size_offset > size_out || size_match > size_dst - size_out)
+        {
+            return (-1);
+        }
+        
+        /* A match may overlap the bytes it produces: copy forward, byte by byte in that case */
+        if (size_offset >= size_match)
+        {
+            memcpy(dst + size_out, dst + size_out - size_offset, size_match);
+        }
+        else
+        {
+            for (k = 0; k < size_match; k++)
+            {
+                dst[size_out + k] = dst[size_out + k - size_offset];
+            }
+        }
+        size_out += size_match;
+    }
+    
+    return (size_out == size_dst ? 0 : -1);
+}
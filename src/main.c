@@ -16,10 +16,93 @@
 #include "binary.h"
 #include "show.h"
 #include "sorting.h"
+#include "gradeStore.h"
+#include "threadPool.h"
+#include "lazyLoad.h"
+#include "packedFile.h"
+#include "asyncSave.h"
+#include "journal.h"
+#include "fieldParser.h"
+#include "courseCatalog.h"
+#include "studentIndex.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 
+/*!
+ * \fn static int add_journaled_grade(const char* str_snapshot, const char* str_id, const char* str_course, const char* str_grade)
+ * \brief Adds a grade to a binary file by appending it to its journal
+ * \param str_snapshot Name of the binary file
+ * \param str_id Identifier of the student, as text
+ * \param str_course Name of the course
+ * \param str_grade Grade to add, as text
+ * \return 0 if success, 1 on error
+ * 
+ * The previous journal of the file is replayed first, so that the new
+ * record follows the last committed one.
+ */
+static int add_journaled_grade(const char* str_snapshot, const char* str_id, const char* str_course, const char* str_grade)
+{
+    Journal journal;
+    Prom prom;
+    int int_student_id;
+    int int_position;
+    int int_course_id;
+    float float_grade;
+    int result;
+    
+    if (parse_int_field(str_id, strlen(str_id), &int_student_id) != PARSE_OK
+        || parse_decimal_field(str_grade, strlen(str_grade), &float_grade) != PARSE_OK)
+    {
+        printf("Error: Invalid student ID %s or grade %s\n", str_id, str_grade);
+        return (1);
+    }
+    
+    /* The journal stays zeroed if the snapshot cannot be read */
+    memset(&journal, 0, sizeof(Journal));
+    prom = load_prom_journaled(str_snapshot, &journal);
+    if (prom.int_nb_students == 0 || journal.file == NULL)
+    {
+        printf("Error: Cannot open %s and its journal\n", str_snapshot);
+        close_journal(&journal);
+        destroy_prom(&prom);
+        return (1);
+    }
+    
+    result = 1;
+    int_position = find_student_position(&prom, int_student_id);
+    int_course_id = find_course_id(&prom.catalog, str_course, strlen(str_course));
+    if (int_position < 0)
+    {
+        printf("Error: Unknown student %d\n", int_student_id);
+    }
+    else if (int_course_id < 0)
+    {
+        printf("Error: Unknown course %s\n", str_course);
+    }
+    else if (find_student_course(&prom.student_students[int_position], int_course_id) == NULL)
+    {
+        printf("Error: Student %d does not follow %s\n", int_student_id, str_course);
+    }
+    else if (journal_add_grade(&journal, &prom, int_student_id, int_course_id, float_grade) != 0)
+    {
+        printf("Error: Cannot add the grade (not enough memory)\n");
+    }
+    else if (commit_journal(&journal, &prom) != 0)
+    {
+        printf("Error: Cannot write the journal of %s\n", str_snapshot);
+    }
+    else
+    {
+        printf("Added grade %.2f in %s to student %d\n", float_grade, str_course, int_student_id);
+        result = 0;
+    }
+    
+    close_journal(&journal);
+    destroy_prom(&prom);
+    return (result);
+}
+
 /*!
  * \fn int main(int argc, char** argv)
  * \brief Main function of the program
@@ -28,47 +111,87 @@
  * \return 0 if success, 1 on error
  * 
  * This function:
- * - Opens the data file
- * - Loads students, courses and grades
+ * - Maps the data file and loads students, courses and grades, parsing the grades
+ *   and computing the averages on all cores
  * - Displays complete information
  * - Sorts students by average and by course
- * - Saves the promotion to a binary file
- * - Frees all allocated memory
+ * - Saves the promotion to a binary file on a background thread, freeing
+ *   the memory meanwhile, then loads the file back lazily
+ * 
+ * With "--convert <data file> <binary file>", it only converts the data
+ * file to a version 1 binary file, with a bounded memory use.
+ * With "--pack <data file> <packed file>", it only saves the data file
+ * as a packed compact binary file. With "--add-grade <binary file>
+ * <student ID> <course> <grade>", it only adds a grade to the binary file
+ * through its journal.
  */
 int main(int argc, char** argv) 
 {
     const char* filename = "data.txt";
-    FILE* file;
     Prom prom;
-    
-    /* Opening the data file for reading */
-    file = fopen(filename, "r");
-    if (file == NULL) 
+    int top_positions[3];
+    int nb_top;
+    ThreadPool* pool;
+    AsyncSave* save;
+
+    /* Conversion mode: the grades are never all in memory */
+    if (argc == 4 && strcmp(argv[1], "--convert") == 0)
     {
-        printf("Error: Cannot open file %s\n", filename);
-        return (1);
+        if (convert_text_to_binary(argv[2], argv[3], 0) != 0)
+        {
+            printf("Error: Cannot convert %s to %s\n", argv[2], argv[3]);
+            return (1);
+        }
+        printf("Converted %s to %s\n", argv[2], argv[3]);
+        return (0);
     }
 
-    /* Initializing the Prom structure */
-    printf("Initializing promotion...\n");
-    prom = create_prom(0);
+    /* Packing mode: the data file is saved as a compressed binary file */
+    if (argc == 4 && strcmp(argv[1], "--pack") == 0)
+    {
+        prom = create_arena_prom(0);
+        if (load_prom_mapped(argv[2], &prom) != 0 || save_prom_binary_packed(argv[3], &prom, 1) != 0)
+        {
+            printf("Error: Cannot pack %s to %s\n", argv[2], argv[3]);
+            destroy_prom(&prom);
+            return (1);
+        }
+        printf("Packed %s to %s\n", argv[2], argv[3]);
+        destroy_prom(&prom);
+        return (0);
+    }
 
-    /* Loading all students from the file */
-    printf("Loading students...\n");
-    get_all_students(file, &prom);
-    
-    /* Loading all courses for each student */
-    printf("Loading courses...\n");
-    get_all_courses(file, &prom);
+    /* Journal mode: the binary file itself is only rewritten by a compaction */
+    if (argc == 6 && strcmp(argv[1], "--add-grade") == 0)
+    {
+        return (add_journaled_grade(argv[2], argv[3], argv[4], argv[5]));
+    }
+
+    /* Initializing the Prom structure, its memory owned by an arena */
+    printf("Initializing promotion...\n");
+    prom = create_arena_prom(0);
 
-    /* Loading all grades and calculating averages */
-    printf("Loading grades and calculating averages...\n");
-    get_all_grades(file, &prom);
+    /* Threads shared by the load and the averages (serial if the pool cannot be created) */
+    pool = create_thread_pool(0);
 
-    /* Closing the file */
-    fclose(file);
+    /* Loading students, courses and grades, then calculating averages on the same threads */
+    printf("Loading students, courses and grades...\n");
+    if (load_prom_mapped_parallel(filename, &prom, pool) != 0)
+    {
+        printf("Error: Cannot load file %s\n", filename);
+        destroy_thread_pool(pool);
+        destroy_prom(&prom);
+        return (1);
+    }
+    destroy_thread_pool(pool);
     
-    /* Sorting students by descending average */
+    /* Moving all grades into one contiguous columnar store (the averages are unchanged) */
+    if (build_grade_store(&prom) != 0)
+    {
+        printf("Warning: Cannot build the columnar grade store\n");
+    }
+    
+    /* Ranking students by descending average (the array stays in place) */
     printf("Sorting students by average...\n");
     sort_students_by_average(&prom);
 
@@ -78,31 +201,43 @@ int main(int argc, char** argv)
 
     /* Displaying the top 10 students */    
     printf("\n\nDisplaying top 10 students by average...\n");
-    show_best(prom.student_students, 10);
+    show_best(&prom, 10);
 
-    /* Sorting and displaying top 3 students in "Mathematics" */
+    /* Ranking the courses once, then displaying top 3 students in "Mathematics" */
     printf("\n\nSorting and displaying top 3 students in Mathematics...\n");
-    sort_students_from_course(&prom, "Mathematiques");
+    nb_top = sort_students_from_course(&prom, "Mathematiques", 3, top_positions);
+    if (nb_top < 0)
+    {
+        printf("Error: Cannot rank the students in Mathematiques\n");
+    }
+    else
+    {
+        show_best_in_course(&prom, "Mathematiques", top_positions, nb_top);
+    }
 
-    /* Saving the promotion to the binary file */
+    /* Saving the promotion to the binary file: only its snapshot in memory is taken here */
     printf("\n\nSaving promotion to binary file...\n");
-    if (save_prom_binary("promotion.bin", &prom) != 0)
+    save = start_save_prom_binary("promotion.bin", &prom, 0);
+
+    /* Freeing all allocated memory while the snapshot goes to disk */
+    printf("Freeing memory...\n");
+    destroy_prom(&prom);
+
+    /* The file is loaded back below: the save must be over */
+    if (save == NULL || wait_async_save(save) != 0)
     {
         printf("Error: Failed to save promotion to binary file.\n");
     } else {
         printf("Promotion saved successfully to binary file: promotion.bin\n");
     }
 
-    /* Freeing all allocated memory */
-    printf("Freeing memory...\n");
-    destroy_prom(&prom);
-
-    /* Loading the promotion back from the binary file for verification */
+    /* Loading the promotion back for verification: only the student headers are read */
     printf("Loading promotion from binary file for verification...\n");
-    prom = load_prom_binary("promotion.bin");
+    prom = load_prom_binary_lazy("promotion.bin", LAZY_DEFAULT_BUDGET);
 
     /* Displaying the loaded promotion */
     printf("Displaying some of the promotion information...\n");
-    show_best(prom.student_students, 3);
+    show_best(&prom, 3);
+    destroy_prom(&prom);
     return (0);
 }
\ No newline at end of file
@@ -0,0 +1,458 @@
+/*!
+ * \file packedFile.c
+ * \author Akhatar Abdelhamid <abdelhamid.akhatar@etu.cyu.fr>
+ * \version 1.0
+ * \date November 2, 2025
+ * \brief Block-compressed binary files
+ * 
+ * This file contains the implementation of the packed container of
+ * version 2 files: the blocks are compressed and decompressed on a
+ * thread pool, each thread with its own part of the blocks.
+ */
+
+#include "packedFile.h"
+#include "binary.h"
+#include "binaryFormat.h"
+#include "init.h"
+#include "lzCodec.h"
+#include "threadPool.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdatomic.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+/*!
+ * \struct PackContext
+ * \brief Blocks shared by the threads compressing or decompressing them
+ */
+typedef struct
+{
+    uint8_t* byte_raw;        /*!< Version 2 file */
+    size_t size_raw;          /*!< Size of the version 2 file */
+    size_t size_block;        /*!< Size of a block */
+    const uint8_t* byte_packed; /*!< Compressed data: the whole packed file on load, one slot per block on save */
+    uint8_t* byte_slots;      /*!< Output of the compressor, get_lz_bound(size_block) bytes per block */
+    size_t size_slot;         /*!< Size of a slot of byte_slots */
+    PackBlock* table;         /*!< Block table */
+    atomic_int int_error;     /*!< Set to 1 if a block cannot be decompressed */
+} PackContext;
+
+/*!
+ * \fn static void compress_blocks_task(void* context, int int_begin, int int_end)
+ * \brief Compresses a range of blocks into their slots and fills their sizes
+ * \param context Pointer to the PackContext
+ * \param int_begin First block
+ * \param int_end Block after the last one
+ */
+static void compress_blocks_task(void* context, int int_begin, int int_end)
+{
+    PackContext* pack;
+    uint8_t* slot;
+    size_t size_first;
+    size_t size_raw;
+    size_t size_packed;
+    int i;
+    
+    pack = (PackContext*)context;
+    for (i = int_begin; i < int_end; i++)
+    {
+        size_first = (size_t)i * pack->size_block;
+        size_raw = pack->size_raw - size_first;
+        if (size_raw > pack->size_block)
+        {
+            size_raw = pack->size_block;
+        }
+        slot = pack->byte_slots + (size_t)i * pack->size_slot;
+        
+        /* A block that does not get smaller is stored as is */
+        size_packed = lz_compress(pack->byte_raw + size_first, size_raw, slot, pack->size_slot);
+        if (size_packed == 0 || size_packed >= size_raw)
+        {
+            memcpy(slot, pack->byte_raw + size_first, size_raw);
+            size_packed = size_raw;
+        }
+        pack->table[i].size_packed = (uint32_t)size_packed;
+        pack->table[i].size_raw = (uint32_t)size_raw;
+    }
+}
+
+/*!
+ * \fn static void decompress_blocks_task(void* context, int int_begin, int int_end)
+ * \brief Decompresses a range of blocks of a checked table
+ * \param context Pointer to the PackContext
+ * \param int_begin First block
+ * \param int_end Block after the last one
+ */
+static void decompress_blocks_task(void* context, int int_begin, int int_end)
+{
+    PackContext* pack;
+    const PackBlock* block;
+    uint8_t* dst;
+    int i;
+    
+    pack = (PackContext*)context;
+    for (i = int_begin; i < int_end; i++)
+    {
+        block = &pack->table[i];
+        dst = pack->byte_raw + (size_t)i * pack->size_block;
+        if (block->size_packed == block->size_raw)
+        {
+            memcpy(dst, pack->byte_packed + block->size_offset, block->size_raw);
+        }
+        else if (lz_decompress(pack->byte_packed + block->size_offset, block->size_packed, dst, block->size_raw) != 0)
+        {
+            atomic_store(&pack->int_error, 1);
+        }
+    }
+}
+
+/*!
+ * \fn static void run_blocks(int int_nb_blocks, ThreadTask task, PackContext* pack)
+ * \brief Runs a task over all the blocks, on all the cores if there are several blocks
+ * \param int_nb_blocks Number of blocks
+ * \param task Function processing a range of blocks
+ * \param pack Pointer to the PackContext
+ */
+static void run_blocks(int int_nb_blocks, ThreadTask task, PackContext* pack)
+{
+    ThreadPool* pool;
+    
+    pool = (int_nb_blocks > 1 ? create_thread_pool(0) : NULL);
+    if (pool == NULL)
+    {
+        task(pack, 0, int_nb_blocks);
+        return;
+    }
+    run_thread_pool(pool, int_nb_blocks, 1, task, pack);
+    destroy_thread_pool(pool);
+}
+
+/*!
+ * \fn static int write_packed(FILE* file, const PackHeader* header, PackContext* pack)
+ * \brief Writes the header, the block table and the compressed blocks
+ * \param file Destination file
+ * \param header Pointer to the header
+ * \param pack Pointer to the PackContext holding the compressed blocks
+ * \return 0 if success, -1 in case of error
+ */
+static int write_packed(FILE* file, const PackHeader* header, PackContext* pack)
+{
+    uint64_t size_position;
+    uint32_t i;
+    
+    /* The blocks follow the table, in order */
+    size_position = sizeof(PackHeader) + (uint64_t)header->int_nb_blocks * sizeof(PackBlock);
+    for (i = 0; i < header->int_nb_blocks; i++)
+    {
+        pack->table[i].size_offset = size_position;
+        size_position += pack->table[i].size_packed;
+    }
+    
+    if (fwrite(header, sizeof(PackHeader), 1, file) != 1)
+    {
+        return (-1);
+    }
+    if (header->int_nb_blocks > 0
+        && fwrite(pack->table, sizeof(PackBlock), header->int_nb_blocks, file) != header->int_nb_blocks)
+    {
+        return (-1);
+    }
+    for (i = 0; i < header->int_nb_blocks; i++)
+    {
+        if (fwrite(pack->byte_slots + (size_t)i * pack->size_slot, 1, pack->table[i].size_packed, file)
+            != pack->table[i].size_packed)
+        {
+            return (-1);
+        }
+    }
+    
+    return (0);
+}
+
+/*!
+ * \fn int save_prom_binary_packed(const char* str_filename, Prom* prom, int int_compact)
+ * \brief Saves a complete cohort to a packed binary file
+ * \param str_filename Name of the destination binary file
+ * \param prom Pointer to the Prom structure to save
+ * \param int_compact 1 to pack a compact version 2 file, 0 for a plain one
+ * \return 0 if success, -1 in case of error
+ */
+int save_prom_binary_packed(const char* str_filename, Prom* prom, int int_compact)
+{
+    PackHeader header;
+    PackContext pack;
+    FILE* memory;
+    FILE* file;
+    char* str_temporary;
+    char* raw;
+    size_t size_raw;
+    int result;
+    
+    /* Parameter verification */
+    if (str_filename == NULL || prom == NULL)
+    {
+        return (-1);
+    }
+    
+    /* Write the version 2 file in memory */
+    raw = NULL;
+    size_raw = 0;
+    memory = open_memstream(&raw, &size_raw);
+    if (memory == NULL)
+    {
+        return (-1);
+    }
+    result = (int_compact ? write_prom_binary_compact(memory, prom) : write_prom_binary(memory, prom));
+    if (fclose(memory) != 0 || result != 0)
+    {
+        free(raw);
+        return (-1);
+    }
+    
+    memset(&header, 0, sizeof(PackHeader));
+    header.int_magic = PACK_MAGIC;
+    header.int_version = PACK_VERSION;
+    header.size_block = PACK_DEFAULT_BLOCK;
+    header.int_nb_blocks = (uint32_t)((size_raw + PACK_DEFAULT_BLOCK - 1) / PACK_DEFAULT_BLOCK);
+    header.size_raw = size_raw;
+    
+    /* Compress the blocks, each into its own slot */
+    memset(&pack, 0, sizeof(PackContext));
+    pack.byte_raw = (uint8_t*)raw;
+    pack.size_raw = size_raw;
+    pack.size_block = PACK_DEFAULT_BLOCK;
+    pack.size_slot = get_lz_bound(PACK_DEFAULT_BLOCK);
+    pack.byte_slots = malloc(header.int_nb_blocks * pack.size_slot + 1);
+    pack.table = calloc(header.int_nb_blocks + 1, sizeof(PackBlock));
+    if (pack.byte_slots == NULL || pack.table == NULL)
+    {
+        free(pack.byte_slots);
+        free(pack.table);
+        free(raw);
+        return (-1);
+    }
+    run_blocks((int)header.int_nb_blocks, compress_blocks_task, &pack);
+    
+    /* Write the container, replacing the old file: the promotion may be mapped from it */
+    file = open_replacement(str_filename, &str_temporary);
+    if (file == NULL)
+    {
+        result = -1;
+    }
+    else
+    {
+        result = close_replacement(file, str_temporary, str_filename, write_packed(file, &header, &pack));
+    }
+    
+    free(pack.byte_slots);
+    free(pack.table);
+    free(raw);
+    
+    return (result);
+}
+
+/*!
+ * \fn static int check_packed(const uint8_t* data, size_t size, PackHeader* header)
+ * \brief Checks the header and the block table of a mapped packed file
+ * \param data First byte of the file
+ * \param size Size of the file
+ * \param header Pointer to the header to fill
+ * \return 0 if every block lies in the file and the blocks cover size_raw exactly, -1 otherwise
+ */
+static int check_packed(const uint8_t* data, size_t size, PackHeader* header)
+{
+    const PackBlock* table;
+    uint64_t size_expected;
+    uint64_t size_table;
+    uint32_t i;
+    
+    if (size < sizeof(PackHeader))
+    {
+        return (-1);
+    }
+    memcpy(header, data, sizeof(PackHeader));
+    if (header->int_magic != PACK_MAGIC || header->int_version != PACK_VERSION
+        || header->size_block == 0 || header->size_block > PACK_MAX_BLOCK
+        || header->size_raw < sizeof(BinHeader))
+    {
+        return (-1);
+    }
+    if ((uint64_t)header->int_nb_blocks != (header->size_raw + header->size_block - 1) / header->size_block
+        || header->int_nb_blocks > (uint32_t)INT32_MAX)
+    {
+        return (-1);
+    }
+    size_table = sizeof(PackHeader) + (uint64_t)header->int_nb_blocks * sizeof(PackBlock);
+    if (size_table > size)
+    {
+        return (-1);
+    }
+    
+    /* Every block but the last one has size_block bytes once decompressed */
+    table = (const PackBlock*)(data + sizeof(PackHeader));
+    for (i = 0; i < header->int_nb_blocks; i++)
+    {
+        size_expected = header->size_raw - (uint64_t)i * header->size_block;
+        if (size_expected > header->size_block)
+        {
+            size_expected = header->size_block;
+        }
+        if (table[i].size_raw != size_expected || table[i].size_packed > table[i].size_raw
+            || table[i].size_offset < size_table || table[i].size_offset > size
+            || table[i].size_packed > size - table[i].size_offset)
+        {
+            return (-1);
+        }
+    }
+    
+    return (0);
+}
+
+/*!
+ * \fn static void* map_packed_file(const char* str_filename, size_t* size)
+ * \brief Maps a whole file read-only
+ * \param str_filename Name of the file
+ * \param size Pointer receiving the size of the file
+ * \return First byte of the mapping, or NULL on error
+ */
+static void* map_packed_file(const char* str_filename, size_t* size)
+{
+    struct stat st;
+    void* data;
+    int fd;
+    
+    fd = open(str_filename, O_RDONLY);
+    if (fd < 0)
+    {
+        return (NULL);
+    }
+    if (fstat(fd, &st) != 0 || st.st_size < (off_t)sizeof(PackHeader))
+    {
+        close(fd);
+        return (NULL);
+    }
+    data = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (data == MAP_FAILED)
+    {
+        return (NULL);
+    }
+    *size = st.st_size;
+    
+    return (data);
+}
+
+/*!
+ * \fn static void* unpack_file(const char* str_filename, size_t* size_raw)
+ * \brief Decompresses a packed file into an anonymous mapping
+ * \param str_filename Name of the file
+ * \param size_raw Pointer receiving the size of the version 2 file
+ * \return First byte of the version 2 file (to unmap), or NULL on error
+ */
+static void* unpack_file(const char* str_filename, size_t* size_raw)
+{
+    PackHeader header;
+    PackContext pack;
+    uint8_t* data;
+    void* raw;
+    size_t size;
+    
+    data = map_packed_file(str_filename, &size);
+    if (data == NULL)
+    {
+        return (NULL);
+    }
+    if (check_packed(data, size, &header) != 0)
+    {
+        munmap(data, size);
+        return (NULL);
+    }
+    
+    /* Page-aligned, as a mapped version 2 file, and freed by destroy_prom */
+    raw = mmap(NULL, header.size_raw, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (raw == MAP_FAILED)
+    {
+        munmap(data, size);
+        return (NULL);
+    }
+    
+    memset(&pack, 0, sizeof(PackContext));
+    pack.byte_raw = raw;
+    pack.size_raw = header.size_raw;
+    pack.size_block = header.size_block;
+    pack.byte_packed = data;
+    pack.table = (PackBlock*)(data + sizeof(PackHeader));
+    atomic_init(&pack.int_error, 0);
+    run_blocks((int)header.int_nb_blocks, decompress_blocks_task, &pack);
+    munmap(data, size);
+    
+    if (atomic_load(&pack.int_error) != 0)
+    {
+        munmap(raw, header.size_raw);
+        return (NULL);
+    }
+    *size_raw = header.size_raw;
+    
+    return (raw);
+}
+
+/*!
+ * \fn Prom load_prom_packed(const char* str_filename)
+ * \brief Restores a cohort from a packed binary file
+ * \param str_filename Name of the source binary file
+ * \return Restored Prom structure, or empty structure in case of error
+ */
+Prom load_prom_packed(const char* str_filename)
+{
+    PromImage image;
+    Prom prom;
+    void* raw;
+    size_t size_raw;
+    int result;
+    
+    /* Parameter verification */
+    if (str_filename == NULL)
+    {
+        return (create_prom(0));
+    }
+    
+    raw = unpack_file(str_filename, &size_raw);
+    if (raw == NULL)
+    {
+        printf("Error: Invalid binary file %s\n", str_filename);
+        return (create_prom(0));
+    }
+    
+    /* The decompressed file is used as a mapped version 2 file */
+    prom = create_arena_prom(0);
+    if (open_prom_image(raw, size_raw, &image) == 0)
+    {
+        result = load_prom_image(&image, &prom);
+    }
+    else if (locate_compact_image(raw, size_raw, &image) == 0)
+    {
+        result = load_prom_compact(&image, &prom);
+    }
+    else
+    {
+        result = -1;
+    }
+    if (result != 0)
+    {
+        printf("Error: Cannot load binary file %s\n", str_filename);
+        destroy_prom(&prom);
+        munmap(raw, size_raw);
+        return (create_prom(0));
+    }
+    
+    /* The promotion now owns the mapping */
+    prom.ptr_mapping = raw;
+    prom.size_mapping = size_raw;
+    
+    printf("Promotion loaded successfully from binary file: %s\n", str_filename);
+    return (prom);
+}
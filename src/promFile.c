@@ -0,0 +1,130 @@
+/*!
+ * \file promFile.c
+ * \author Akhatar Abdelhamid <abdelhamid.akhatar@etu.cyu.fr>
+ * \version 1.0
+ * \date November 2, 2025
+ * \brief Point query module of binary files
+ * 
+ * This file contains the implementation of the point queries: a binary
+ * search in the mapped student index, then a copy of the records of the
+ * student found.
+ */
+
+#include "promFile.h"
+#include "courseCatalog.h"
+
+/*!
+ * \fn int open_prom_file(const char* str_filename, PromFile* file)
+ * \brief Opens a version 2 binary file for point queries
+ * \param str_filename Name of the file
+ * \param file Pointer to the PromFile structure to fill
+ * \return 0 on success, -1 on error
+ */
+int open_prom_file(const char* str_filename, PromFile* file)
+{
+    const char* name;
+    int i;
+    
+    file->catalog = create_catalog();
+    
+    /* Map the file, checking its sections only */
+    if (map_prom_sections(str_filename, &file->image) != 0)
+    {
+        return (-1);
+    }
+    if (file->image.record_index == NULL)
+    {
+        close_prom_image(&file->image);
+        return (-1);
+    }
+    
+    /* Catalog: the ID of a course is its index in the file */
+    for (i = 0; i < file->image.int_nb_courses; i++)
+    {
+        name = get_image_string(&file->image, file->image.record_catalog[i].int_name);
+        if (intern_course(&file->catalog, name, strlen(name), file->image.record_catalog[i].float_coef) != i)
+        {
+            close_prom_file(file);
+            return (-1);
+        }
+    }
+    
+    return (0);
+}
+
+/*!
+ * \fn void close_prom_file(PromFile* file)
+ * \brief Closes a binary file opened for point queries
+ * \param file Pointer to the PromFile structure
+ */
+void close_prom_file(PromFile* file)
+{
+    close_prom_image(&file->image);
+    destroy_catalog(&file->catalog);
+}
+
+/*!
+ * \fn int read_prom_file_student(const PromFile* file, int int_id, Student* student)
+ * \brief Reads one student of the file by identifier
+ * \param file Pointer to the opened file
+ * \param int_id Identifier of the student
+ * \param student Pointer to the Student structure to fill
+ * \return 0 on success, -1 on error
+ */
+int read_prom_file_student(const PromFile* file, int int_id, Student* student)
+{
+    const PromImage* image;
+    const BinStudentRecord* record;
+    const BinCourseRecord* course_record;
+    Course* course;
+    int position;
+    int slot;
+    int nb_grades;
+    int j;
+    
+    image = &file->image;
+    
+    /* Binary search in the index, then check the records of this student only */
+    position = find_image_student(image, int_id);
+    if (position < 0 || check_image_student(image, position) != 0)
+    {
+        return (-1);
+    }
+    record = &image->record_students[position];
+    
+    /* Copy the student, its courses and its grades */
+    *student = create_student(record->int_id, get_image_string(image, record->int_last_name),
+                              get_image_string(image, record->int_first_name), record->int_age,
+                              image->tab_student_offsets[position + 1] - image->tab_student_offsets[position]);
+    student->float_average = record->float_average;
+    if (student->char_last_name == NULL || student->char_first_name == NULL
+        || (student->int_nb_courses > 0 && student->course_courses == NULL))
+    {
+        student->int_nb_courses = 0;
+        destroy_student(student);
+        return (-1);
+    }
+    
+    for (j = 0; j < student->int_nb_courses; j++)
+    {
+        slot = image->tab_student_offsets[position] + j;
+        course_record = &image->record_courses[slot];
+        nb_grades = image->tab_course_offsets[slot + 1] - image->tab_course_offsets[slot];
+        
+        course = &student->course_courses[j];
+        *course = create_course(course_record->int_course_id, nb_grades);
+        course->float_average = course_record->float_average;
+        if (nb_grades > 0)
+        {
+            if (course->grades.int_nb_grades != nb_grades)
+            {
+                student->int_nb_courses = j + 1;
+                destroy_student(student);
+                return (-1);
+            }
+            memcpy(get_grades_data(&course->grades), image->tab_grades + image->tab_course_offsets[slot], nb_grades * sizeof(float));
+        }
+    }
+    
+    return (0);
+}
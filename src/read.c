@@ -16,141 +16,380 @@
 #include "structures.h"
 #include "init.h"
 #include "update.h"
+#include "courseCatalog.h"
+#include "arena.h"
 
 /*!
- * \fn char* read_line(FILE* file)
- * \brief Reads a complete line from a file with dynamic allocation
+ * \fn int create_line_reader(LineReader* reader, FILE* file)
+ * \brief Initializes a line reader on an open file
+ * \param reader Pointer to the LineReader to initialize
  * \param file Pointer to the file to read
- * \return String containing the read line (to be freed by the caller)
+ * \return 0 on success, -1 if the block buffer cannot be allocated
  */
-char* read_line(FILE* file) 
+int create_line_reader(LineReader* reader, FILE* file)
 {
-    size_t size;
-    size_t len;
-    char *buffer;
-    int c;
-    char *new_buffer;
+    reader->file = file;
+    reader->size_start = 0;
+    reader->size_end = 0;
+    reader->int_eof = 0;
+    reader->int_nb_lines = 0;
     
-    size = 128;
-    len = 0;
+    /* One extra byte keeps room for the terminator of the last line */
+    reader->size_capacity = LINE_READER_BLOCK_SIZE + 1;
+    reader->char_buffer = malloc(reader->size_capacity);
+    if (reader->char_buffer == NULL)
+    {
+        reader->size_capacity = 0;
+        return (-1);
+    }
+    
+    return (0);
+}
+
+/*!
+ * \fn void destroy_line_reader(LineReader* reader)
+ * \brief Frees the block buffer of a line reader
+ * \param reader Pointer to the LineReader to destroy
+ */
+void destroy_line_reader(LineReader* reader)
+{
+    free(reader->char_buffer);
+    reader->char_buffer = NULL;
+    reader->size_capacity = 0;
+    reader->size_start = 0;
+    reader->size_end = 0;
+}
+
+/*!
+ * \fn static int fill_line_reader(LineReader* reader)
+ * \brief Reads the next block of the file after the unread bytes
+ * \param reader Pointer to the LineReader
+ * \return 1 if bytes were added to the buffer, 0 otherwise
+ */
+static int fill_line_reader(LineReader* reader)
+{
+    size_t remaining;
+    size_t nb_read;
+    size_t new_capacity;
+    char* new_buffer;
+    
+    /* Move the incomplete line at the beginning of the buffer */
+    remaining = reader->size_end - reader->size_start;
+    if (reader->size_start > 0)
+    {
+        memmove(reader->char_buffer, reader->char_buffer + reader->size_start, remaining);
+        reader->size_start = 0;
+        reader->size_end = remaining;
+    }
+    
+    /* Grow the buffer only if a single line fills it entirely */
+    if (reader->size_end + 1 >= reader->size_capacity)
+    {
+        new_capacity = reader->size_capacity * 2;
+        new_buffer = realloc(reader->char_buffer, new_capacity);
+        if (new_buffer == NULL)
+        {
+            return (0);
+        }
+        reader->char_buffer = new_buffer;
+        reader->size_capacity = new_capacity;
+    }
     
-    /* Initial buffer allocation */
-    buffer = malloc(size);
-    if (!buffer) 
+    /* Read as much as possible, keeping one byte for the terminator */
+    nb_read = fread(reader->char_buffer + reader->size_end, 1,
+                    reader->size_capacity - 1 - reader->size_end, reader->file);
+    if (nb_read == 0)
     {
-        return (NULL);
+        reader->int_eof = 1;
+        return (0);
     }
+    reader->size_end += nb_read;
+    
+    return (1);
+}
 
-    /* Read character by character until end of line */
-    while ((c = fgetc(file)) != EOF && c != '\n') 
+/*!
+ * \fn int read_next_line(LineReader* reader, Line* line)
+ * \brief Reads the next line of the file without allocating it
+ * \param reader Pointer to the LineReader
+ * \param line Pointer to the Line view to fill
+ * \return 1 if a line was read, 0 at end of file or on error
+ */
+int read_next_line(LineReader* reader, Line* line)
+{
+    char* start;
+    char* newline;
+    
+    if (reader->char_buffer == NULL)
+    {
+        return (0);
+    }
+    
+    while (1)
     {
-        buffer[len++] = (char)c;
+        start = reader->char_buffer + reader->size_start;
         
-        /* Reallocation if buffer is too small */
-        if (len >= size) 
+        /* Search the end of the line in the bytes already buffered */
+        newline = memchr(start, '\n', reader->size_end - reader->size_start);
+        if (newline != NULL)
         {
-            size *= 2;
-            new_buffer = realloc(buffer, size);
-            if (!new_buffer) 
-            {
-                free(buffer);
-                return (NULL);
-            }
-            buffer = new_buffer;
+            *newline = '\0';
+            line->char_text = start;
+            line->size_len = (size_t)(newline - start);
+            reader->size_start += line->size_len + 1;
+            reader->int_nb_lines++;
+            return (1);
+        }
+        
+        /* No complete line buffered: read the next block */
+        if (reader->int_eof || !fill_line_reader(reader))
+        {
+            break;
         }
     }
     
-    /* If no character was read and EOF reached */
-    if (len == 0 && c == EOF) 
+    /* End of file: hand out the last line if it has no newline */
+    if (reader->size_start < reader->size_end)
     {
-        free(buffer);
-        return (NULL);
+        start = reader->char_buffer + reader->size_start;
+        start[reader->size_end - reader->size_start] = '\0';
+        line->char_text = start;
+        line->size_len = reader->size_end - reader->size_start;
+        reader->size_start = reader->size_end;
+        reader->int_nb_lines++;
+        return (1);
     }
     
-    /* Add string terminator */
-    buffer[len] = '\0';
-    
-    return (buffer);
+    return (0);
 }
 
 
 /*!
- * \fn char* get_to_type(FILE* file, char* type)
+ * \fn int get_to_type(LineReader* reader, const char* type, Line* line)
  * \brief Positions in the file at the specified section
- * \param file Pointer to the file
+ * \param reader Pointer to the LineReader
  * \param type Name of the section to search for (e.g., "ETUDIANTS", "MATIERES", "NOTES")
- * \return First data line after the found section
+ * \param line Pointer to the Line view receiving the first data line
+ * \return 1 if the section and a first data line were found, 0 otherwise
  */
-char* get_to_type(FILE* file, char* type)
+int get_to_type(LineReader* reader, const char* type, Line* line)
 {
-    char* line;
     int found;
     
-    line = NULL;
     found = 0;
 
     /* Search for the section in the file */
-    while ((line = read_line(file)) != NULL) 
+    while (read_next_line(reader, line)) 
     {
         /* Comparison with the searched type */
-        if (strcmp(line, type) == 0) 
+        if (strcmp(line->char_text, type) == 0) 
         {
             found = 1;
-            free(line);
             
             /* Skip the header line (e.g., "numero;prenom;nom;age") */
-            line = read_line(file);
+            read_next_line(reader, line);
             break;
         }
-        free(line);
     }
     
     /* Display if the section was not found */
     if (!found) 
     {
         printf("%s not found in file\n", type);
+        return (0);
     }
     
     /* Read the first data line */
-    line = read_line(file);
+    return (read_next_line(reader, line));
+}
+
+/*!
+ * \fn int parse_student_view(Arena* arena, const char* text, size_t len, Student* student)
+ * \brief Parses a line view "id;firstname;lastname;age" into a Student structure without courses
+ * \param arena Pointer to the arena receiving the names (NULL: heap)
+ * \param text First character of the line
+ * \param len Length of the line
+ * \param student Pointer to the Student structure to fill, only on success
+ * \return PARSE_OK, the PARSE_ error code of the line, or PARSE_NO_MEMORY (-1) if a name cannot be copied
+ */
+int parse_student_view(Arena* arena, const char* text, size_t len, Student* student)
+{
+    FieldReader fields;
+    const char* field[4];
+    size_t size_field[4];
+    char* first_name;
+    char* last_name;
+    int id;
+    int age;
+    int error;
+    int i;
     
-    return (line);
+    /* Split the line into its four fields */
+    start_fields(&fields, text, len);
+    for (i = 0; i < 4; i++)
+    {
+        if (!next_field(&fields, &field[i], &size_field[i]))
+        {
+            return (PARSE_MISSING_FIELD);
+        }
+    }
+    if (has_more_fields(&fields))
+    {
+        return (PARSE_EXTRA_FIELD);
+    }
+    
+    /* Identifier and age */
+    error = parse_int_field(field[0], size_field[0], &id);
+    if (error == PARSE_OK)
+    {
+        error = parse_int_field(field[3], size_field[3], &age);
+    }
+    if (error != PARSE_OK)
+    {
+        return (error);
+    }
+    
+    /* Names copied straight from the line, whatever their length */
+    first_name = arena_strndup(arena, field[1], size_field[1]);
+    last_name = arena_strndup(arena, field[2], size_field[2]);
+    if (first_name == NULL || last_name == NULL)
+    {
+        arena_free(arena, first_name, size_field[1] + 1);
+        arena_free(arena, last_name, size_field[2] + 1);
+        return (PARSE_NO_MEMORY);
+    }
+    student->int_id = id;
+    student->char_first_name = first_name;
+    student->char_last_name = last_name;
+    student->int_age = age;
+    student->int_nb_courses = 0;
+    student->int_max_courses = 0;
+    student->course_courses = NULL;
+    student->float_average = 0.0f;
+    
+    return (PARSE_OK);
 }
 
 /*!
- * \fn Course parse_course_line(const char* line)
- * \brief Parses a file line to create a Course structure
- * \param line Line in format "name;coefficient"
- * \return Initialized Course structure
+ * \fn int parse_course_view(const char* text, size_t len, CourseCatalog* catalog, int* int_course_id)
+ * \brief Parses a line view "name;coefficient" and adds the course to a catalog
+ * \param text First character of the line
+ * \param len Length of the line
+ * \param catalog Pointer to the catalog receiving the course
+ * \param int_course_id Pointer receiving the ID of the course, -1 on allocation error
+ * \return PARSE_OK, the PARSE_ error code of the line, or PARSE_NO_MEMORY (-1) if the course cannot be added
  */
-Course parse_course_line(const char* line) 
+int parse_course_view(const char* text, size_t len, CourseCatalog* catalog, int* int_course_id)
 {
-    char name[128];
+    FieldReader fields;
+    const char* name;
+    const char* coef_text;
+    size_t name_len;
+    size_t coef_len;
     float coef;
+    int error;
     
     /* Extract name and coefficient from the line */
-    sscanf(line, "%[^;];%f", name, &coef);
+    start_fields(&fields, text, len);
+    if (!next_field(&fields, &name, &name_len) || !next_field(&fields, &coef_text, &coef_len))
+    {
+        return (PARSE_MISSING_FIELD);
+    }
+    if (has_more_fields(&fields))
+    {
+        return (PARSE_EXTRA_FIELD);
+    }
+    error = parse_decimal_field(coef_text, coef_len, &coef);
+    if (error != PARSE_OK)
+    {
+        return (error);
+    }
+    
+    /* Add the course to the catalog */
+    *int_course_id = intern_course(catalog, name, name_len, coef);
+    if (*int_course_id < 0)
+    {
+        return (PARSE_NO_MEMORY);
+    }
     
-    /* Create and return the Course structure */
-    return (create_course(name, coef, 0));
+    return (PARSE_OK);
+}
+
+/*!
+ * \fn int parse_grade_view(const char* text, size_t len, int* int_student_id, const char** course_name, size_t* size_course_len, float* float_grade)
+ * \brief Splits a line view "id;course;grade" into its fields
+ * \param text First character of the line
+ * \param len Length of the line
+ * \param int_student_id Pointer receiving the student identifier
+ * \param course_name Pointer receiving the first character of the course name
+ * \param size_course_len Pointer receiving the length of the course name
+ * \param float_grade Pointer receiving the grade
+ * \return PARSE_OK or the PARSE_ error code of the line
+ */
+int parse_grade_view(const char* text, size_t len, int* int_student_id, const char** course_name,
+                     size_t* size_course_len, float* float_grade)
+{
+    FieldReader fields;
+    const char* id_text;
+    const char* grade_text;
+    size_t id_len;
+    size_t grade_len;
+    int error;
+    
+    /* Extract student ID, course name and grade */
+    start_fields(&fields, text, len);
+    if (!next_field(&fields, &id_text, &id_len) || !next_field(&fields, course_name, size_course_len)
+        || !next_field(&fields, &grade_text, &grade_len))
+    {
+        return (PARSE_MISSING_FIELD);
+    }
+    if (has_more_fields(&fields))
+    {
+        return (PARSE_EXTRA_FIELD);
+    }
+    error = parse_int_field(id_text, id_len, int_student_id);
+    if (error == PARSE_OK)
+    {
+        error = parse_decimal_field(grade_text, grade_len, float_grade);
+    }
+    
+    return (error);
+}
+
+/*!
+ * \fn int parse_course_line(const char* line, CourseCatalog* catalog)
+ * \brief Parses a file line and adds the course to a catalog
+ * \param line Line in format "name;coefficient"
+ * \param catalog Pointer to the catalog receiving the course
+ * \return ID of the course in the catalog, or -1 on error
+ */
+int parse_course_line(const char* line, CourseCatalog* catalog) 
+{
+    int id;
+    
+    if (parse_course_view(line, strlen(line), catalog, &id) != PARSE_OK)
+    {
+        return (-1);
+    }
+    
+    return (id);
 }
 
 /*!
  * \fn Student parse_student_line(const char* line)
  * \brief Parses a file line to create a Student structure
  * \param line Line in format "id;firstname;lastname;age"
- * \return Initialized Student structure
+ * \return Initialized Student structure, with identifier 0 and no names if the line is invalid
  */
 Student parse_student_line(const char* line) 
 {
-    int id;
-    int age;
-    char first_name[128];
-    char last_name[128];
+    Student student;
     
     /* Extract data from the line */
-    sscanf(line, "%d;%127[^;];%127[^;];%d", &id, first_name, last_name, &age);
+    if (parse_student_view(NULL, line, strlen(line), &student) != PARSE_OK)
+    {
+        memset(&student, 0, sizeof(Student));
+    }
     
-    /* Create and return the Student structure */
-    return (create_student(id, last_name, first_name, age, 0));
+    return (student);
 }
@@ -11,175 +11,1894 @@
 
 #include "saveData.h"
 #include "update.h"
+#include "studentIndex.h"
+#include "courseCatalog.h"
+#include "gradeStore.h"
+#include "arena.h"
+#include "sorting.h"
+#include "lazyLoad.h"
+#include "binary.h"
+#include "init.h"
+#include "spscQueue.h"
+#include <stdint.h>
+#include <pthread.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+/*! \brief Number of spilled grades read back at once by the converter */
+#define CONVERT_READ_RECORDS 1024
 
 /*!
- * \fn Prom get_all_students(FILE* file)
- * \brief Reads all students from the file
- * \param file Pointer to the data file
- * \return Prom structure containing all students
+ * \struct SpilledGrade
+ * \brief Grade of the NOTES section spilled to a bucket file by the converter
+ */
+typedef struct
+{
+    int32_t int_position;     /*!< Position of the student in the ETUDIANTS section */
+    int32_t int_course_id;    /*!< ID of the course in the catalog */
+    float float_grade;        /*!< Grade */
+} SpilledGrade;
+
+/*!
+ * \fn static int add_student_line(Prom* prom, const char* text, size_t len)
+ * \brief Parses a line "id;firstname;lastname;age" and appends the student
+ * \param prom Pointer to the cohort to fill
+ * \param text Line view
+ * \param len Length of the line
+ * \return PARSE_OK, the PARSE_ error code of the line, or PARSE_NO_MEMORY if the student cannot be stored
  */
-void get_all_students(FILE* file, Prom* prom) 
+static int add_student_line(Prom* prom, const char* text, size_t len)
 {
-    char* line;
     Student student;
+    int error;
+    
+    /* Create the student from the fields of the line */
+    error = parse_student_view(prom->arena_memory, text, len, &student);
+    if (error != PARSE_OK)
+    {
+        return (error);
+    }
+    
+    /* Add the student to the array, doubling it when full (the ranking misses it) */
+    clear_student_ranking(prom);
+    clear_course_ranking(prom);
+    if (push_prom_student(prom, student) != 0)
+    {
+        destroy_student_in(prom->arena_memory, &student);
+        return (PARSE_NO_MEMORY);
+    }
+    
+    return (PARSE_OK);
+}
+
+/*!
+ * \fn static int add_course_to_catalog(CourseCatalog* catalog, const char* text, size_t len, int* int_course_id)
+ * \brief Parses a line "name;coefficient" and adds the course to a catalog
+ * \param catalog Pointer to the catalog receiving the course
+ * \param text Line view
+ * \param len Length of the line
+ * \param int_course_id Pointer receiving the ID of the new course, -1 if the name is repeated
+ * \return PARSE_OK or the PARSE_ error code of the line
+ */
+static int add_course_to_catalog(CourseCatalog* catalog, const char* text, size_t len, int* int_course_id)
+{
+    int nb_courses;
+    int error;
+    
+    /* Add the course once to the catalog (a repeated name is ignored) */
+    nb_courses = catalog->int_nb_courses;
+    error = parse_course_view(text, len, catalog, int_course_id);
+    if (error == PARSE_OK && catalog->int_nb_courses == nb_courses)
+    {
+        *int_course_id = -1;
+    }
+    
+    return (error);
+}
+
+/*!
+ * \fn static int add_course_line(Prom* prom, const char* text, size_t len)
+ * \brief Parses a line "name;coefficient", adds the course to the catalog and assigns it to each student
+ * \param prom Pointer to the cohort containing the students
+ * \param text Line view
+ * \param len Length of the line
+ * \return PARSE_OK or the PARSE_ error code of the line
+ */
+static int add_course_line(Prom* prom, const char* text, size_t len)
+{
+    int id;
+    int error;
+    int i;
+    Course new_course;
+    
+    error = add_course_to_catalog(&prom->catalog, text, len, &id);
+    if (error != PARSE_OK || id < 0)
+    {
+        return (error);
+    }
+    
+    /* Assign the course to each student */
+    for (i = 0; i < prom->int_nb_students; i++)
+    {
+        /* Create a new course referring to the catalog */
+        new_course = create_course_in(prom->arena_memory, id, 0);
+        
+        /* Add the course to the student's array, doubling it when full */
+        push_student_course_in(prom->arena_memory, &prom->student_students[i], new_course);
+    }
+    
+    return (PARSE_OK);
+}
+
+/*!
+ * \fn static void append_grade(Arena* arena, Course* course, float grade)
+ * \brief Appends a grade to the grades array of a course
+ * \param arena Pointer to the arena of the grades (NULL: heap)
+ * \param course Pointer to the course
+ * \param grade Grade to add
+ */
+static void append_grade(Arena* arena, Course* course, float grade)
+{
+    /* Add the grade to the array, doubling it when full (a grade that cannot be stored is lost) */
+    push_grade_in(arena, &course->grades, grade);
+}
+
+/*!
+ * \fn static int add_grade_line(Prom* prom, const char* text, size_t len)
+ * \brief Parses a line "id;course;grade" and appends the grade to the student's course
+ * \param prom Pointer to the indexed cohort containing the students
+ * \param text Line view
+ * \param len Length of the line
+ * \return PARSE_OK or the PARSE_ error code of the line
+ * 
+ * Grades of an unknown student identifier are counted in prom->int_nb_unknown_ids.
+ */
+static int add_grade_line(Prom* prom, const char* text, size_t len)
+{
+    const char* course_name;
+    size_t course_len;
+    int student_id;
+    float grade;
+    int course_id;
+    int error;
+    Student* student;
+    Course* course;
+    
+    error = parse_grade_view(text, len, &student_id, &course_name, &course_len, &grade);
+    if (error != PARSE_OK)
+    {
+        return (error);
+    }
+    
+    /* Find the corresponding student through the index */
+    student = find_student_by_id(prom, student_id);
+    if (student == NULL)
+    {
+        prom->int_nb_unknown_ids++;
+        return (PARSE_OK);
+    }
+    
+    /* Find the course with a single lookup in the catalog */
+    course_id = find_course_id(&prom->catalog, course_name, course_len);
+    course = (course_id >= 0 ? find_student_course(student, course_id) : NULL);
+    if (course != NULL)
+    {
+        append_grade(prom->arena_memory, course, grade);
+    }
+    
+    return (PARSE_OK);
+}
+
+/*!
+ * \fn static void report_parse_error(int int_line, int int_error)
+ * \brief Displays a line of the data file ignored because it cannot be parsed
+ * \param int_line Number of the line in the file (from 1)
+ * \param int_error PARSE_ error code of the line
+ */
+static void report_parse_error(int int_line, int int_error)
+{
+    printf("Warning: line %d ignored (%s)\n", int_line, get_parse_error(int_error));
+}
+
+/*!
+ * \fn static void report_unknown_ids(const Prom* prom)
+ * \brief Displays the number of grades ignored for an unknown student identifier
+ * \param prom Pointer to the loaded cohort
+ */
+static void report_unknown_ids(const Prom* prom)
+{
+    if (prom->int_nb_unknown_ids > 0)
+    {
+        printf("Warning: %d grade(s) ignored for unknown student IDs\n", prom->int_nb_unknown_ids);
+    }
+}
+
+/*!
+ * \fn void get_all_students(LineReader* reader, Prom* prom)
+ * \brief Reads all students from the file
+ * \param reader Pointer to the reader of the data file
+ * \param prom Pointer to the cohort to fill
+ */
+void get_all_students(LineReader* reader, Prom* prom) 
+{
+    Line line;
+    int has_line;
+    int error;
+    
+    /* Students are appended: a lazy promotion must be fully loaded */
+    if (materialize_prom(prom) != 0)
+    {
+        return;
+    }
         
     /* Position to the ETUDIANTS section */
-    line = get_to_type(file, "ETUDIANTS");
+    has_line = get_to_type(reader, "ETUDIANTS", &line);
 
     /* Read all student lines */
-    while (line != NULL && strlen(line) > 0) 
+    while (has_line && line.size_len > 0) 
     {
-        /* Parse the line to create a student */
-        student = parse_student_line(line);
-        
-        /* Reallocate the students array to add the new student */
-        prom->student_students = (Student*)realloc(prom->student_students, (prom->int_nb_students + 1) * sizeof(Student));
-        
-        /* Add the student to the array */
-        prom->student_students[prom->int_nb_students] = student;
-        
-        /* Increment the number of students */
-        prom->int_nb_students++;
+        /* Parse the line and add the student */
+        error = add_student_line(prom, line.char_text, line.size_len);
+        if (error != PARSE_OK)
+        {
+            report_parse_error(reader->int_nb_lines, error);
+        }
         
-        /* Free the line and read the next one */
-        free(line);
-        line = read_line(file);
+        /* Read the next line */
+        has_line = read_next_line(reader, &line);
     }
+    
+    /* Index the students by identifier for the grades */
+    build_student_index(prom);
 }
 
 
 /*!
- * \fn void get_all_courses(FILE* file, Prom* prom)
+ * \fn void get_all_courses(LineReader* reader, Prom* prom)
  * \brief Reads all courses and assigns them to each student
- * \param file Pointer to the data file
+ * \param reader Pointer to the reader of the data file
  * \param prom Pointer to the cohort containing the students
  */
-void get_all_courses(FILE* file, Prom* prom)
+void get_all_courses(LineReader* reader, Prom* prom)
 {
-    char* line;
-    char name[128];
-    float coef;
-    size_t i;
-    Course new_course;
+    Line line;
+    int has_line;
+    int error;
+    
+    /* Courses are appended to the students: a lazy promotion must be fully loaded */
+    if (materialize_prom(prom) != 0)
+    {
+        return;
+    }
     
     /* Position to the MATIERES section */
-    line = get_to_type(file, "MATIERES");
+    has_line = get_to_type(reader, "MATIERES", &line);
 
     /* Read all course lines */
-    while (line != NULL && strlen(line) > 0)
+    while (has_line && line.size_len > 0)
     {
-        /* Extract the course name and coefficient */
-        sscanf(line, "%[^;];%f", name, &coef);
-        
-        /* Assign the course to each student */
-        for (i = 0; i < prom->int_nb_students; i++)
-        {
-            /* Reallocate the student's courses array */
-            prom->student_students[i].course_courses = (Course*)realloc(
-                prom->student_students[i].course_courses, 
-                (prom->student_students[i].int_nb_courses + 1) * sizeof(Course)
-            );
-            
-            /* Create a new course (deep copy) */
-            new_course = create_course(name, coef, 0);
-            
-            /* Add the course to the student's array */
-            prom->student_students[i].course_courses[prom->student_students[i].int_nb_courses] = new_course;
-            
-            /* Increment the student's number of courses */
-            prom->student_students[i].int_nb_courses++;
+        /* Parse the line and assign the course to each student */
+        error = add_course_line(prom, line.char_text, line.size_len);
+        if (error != PARSE_OK)
+        {
+            report_parse_error(reader->int_nb_lines, error);
         }
         
-        /* Free the line and read the next one */
-        free(line);
-        line = read_line(file);
+        /* Read the next line */
+        has_line = read_next_line(reader, &line);
     }
 }
 
 
 /*!
- * \fn void get_all_grades(FILE* file, Prom* prom)
- * \brief Reads all grades and assigns them to students in their respective courses
- * \param file Pointer to the data file
+ * \fn static void load_grades_serial(LineReader* reader, Prom* prom)
+ * \brief Reads all grades on the calling thread and assigns them to students in their respective courses
+ * \param reader Pointer to the reader of the data file
  * \param prom Pointer to the cohort containing the students
  */
-void get_all_grades(FILE* file, Prom* prom)
+static void load_grades_serial(LineReader* reader, Prom* prom)
 {
-    char* line;
-    int student_id;
-    char course_name[128];
-    float grade;
-    int i;
-    int j;
-    Student* student;
-    Course* course;
-    int n;
+    Line line;
+    int has_line;
+    int error;
+    
+    /* Grades are appended per course: leave the columnar store */
+    release_grade_store(prom);
     
     /* Position to the NOTES section */
-    line = get_to_type(file, "NOTES");
+    has_line = get_to_type(reader, "NOTES", &line);
 
     /* Read all grade lines */
-    while (line != NULL && strlen(line) > 0) 
+    while (has_line && line.size_len > 0) 
     {
-        /* Extract student ID, course name and grade */
-        if (sscanf(line, "%d;%127[^;];%f", &student_id, course_name, &grade) == 3) 
+        /* Parse the line and add the grade */
+        error = add_grade_line(prom, line.char_text, line.size_len);
+        if (error != PARSE_OK)
         {
-            /* Search for the corresponding student */
-            for (i = 0; i < prom->int_nb_students; i++) 
-            {
-                student = &prom->student_students[i];
-                
-                /* If the ID matches */
-                if (student->int_id == student_id) 
-                {
-                    /* Search for the corresponding course */
-                    for (j = 0; j < student->int_nb_courses; j++) 
-                    {
-                        course = &student->course_courses[j];
-                        
-                        /* If the course name matches */
-                        if (strcmp(course->char_course_name, course_name) == 0) 
-                        {
-                            /* Get the current number of grades */
-                            n = course->grades.int_nb_grades;
-                            
-                            /* Reallocate the grades array to add the new one */
-                            course->grades.tab_grades = (float*)realloc(
-                                course->grades.tab_grades, 
-                                (n + 1) * sizeof(float)
-                            );
-                            
-                            /* Check if allocation was successful */
-                            if (course->grades.tab_grades != NULL) 
-                            {
-                                /* Add the grade to the array */
-                                course->grades.tab_grades[n] = grade;
-                                
-                                /* Increment the number of grades */
-                                course->grades.int_nb_grades++;
-                            }
-                            break;
-                        }
-                    }
-                    break;
-                }
-            }
+            report_parse_error(reader->int_nb_lines, error);
         }
 
-        /* Free the line and read the next one */
-        free(line);
-        line = read_line(file);
+        /* Read the next line */
+        has_line = read_next_line(reader, &line);
     }
+    report_unknown_ids(prom);
 
     /* Update all course averages */
     update_course_average(prom);
     
     /* Update all student overall averages */
     update_student_average(prom);
+}
+
+/*!
+ * \fn static off_t get_unread_size(const LineReader* reader)
+ * \brief Gives the number of bytes of the data file not handed out by a reader yet
+ * \param reader Pointer to the reader of the data file
+ * \return Number of bytes, 0 if the file is not a regular file
+ */
+static off_t get_unread_size(const LineReader* reader)
+{
+    struct stat st;
+    off_t size_read;
+    
+    size_read = ftello(reader->file);
+    if (fstat(fileno(reader->file), &st) != 0 || !S_ISREG(st.st_mode) || size_read < 0)
+    {
+        return (0);
+    }
+    
+    return (st.st_size - size_read + (off_t)(reader->size_end - reader->size_start));
+}
+
+/*!
+ * \fn void get_all_grades(LineReader* reader, Prom* prom)
+ * \brief Reads all grades and assigns them to students in their respective courses
+ * \param reader Pointer to the reader of the data file
+ * \param prom Pointer to the cohort containing the students
+ */
+void get_all_grades(LineReader* reader, Prom* prom)
+{
+    /* Below a few batches, starting the threads costs more than it saves */
+    if (get_unread_size(reader) < PIPELINE_MIN_SIZE)
+    {
+        load_grades_serial(reader, prom);
+    }
+    else if (get_all_grades_pipelined(reader, prom, 0) != 0)
+    {
+        printf("Warning: Not enough memory, some grades were not loaded\n");
+    }
+}
+
+
+/*!
+ * \fn static const char* next_line_end(const char* text, const char* end)
+ * \brief Finds the end of the line starting at text in a memory block
+ * \param text First character of the line
+ * \param end End of the memory block
+ * \return Pointer to the newline ending the line, or end for the last line
+ */
+static const char* next_line_end(const char* text, const char* end)
+{
+    const char* newline;
+    
+    newline = memchr(text, '\n', end - text);
+    return (newline != NULL ? newline : end);
+}
+
+/*!
+ * \fn static const char* skip_line(const char* text, const char* end)
+ * \brief Returns the start of the line following the one starting at text
+ * \param text First character of the line
+ * \param end End of the memory block
+ * \return Pointer to the next line, or end if there is none
+ */
+static const char* skip_line(const char* text, const char* end)
+{
+    const char* line_end;
+    
+    line_end = next_line_end(text, end);
+    return (line_end < end ? line_end + 1 : end);
+}
+
+/*!
+ * \fn static int count_section_lines(const char* text, const char* end)
+ * \brief Counts the data lines of a section until the first empty line
+ * \param text First data line of the section
+ * \param end End of the memory block
+ * \return Number of data lines of the section
+ */
+static int count_section_lines(const char* text, const char* end)
+{
+    const char* line_end;
+    int nb_lines;
+    
+    nb_lines = 0;
+    while (text < end)
+    {
+        line_end = next_line_end(text, end);
+        if (line_end == text)
+        {
+            break;
+        }
+        nb_lines++;
+        text = line_end + 1;
+    }
+    
+    return (nb_lines);
+}
+
+/*!
+ * \fn static void reserve_student_courses(Prom* prom, int int_nb_courses)
+ * \brief Sizes the courses array of every student from the line count of the MATIERES section
+ * \param prom Pointer to the cohort whose students are loaded
+ * \param int_nb_courses Number of lines of the MATIERES section
+ */
+static void reserve_student_courses(Prom* prom, int int_nb_courses)
+{
+    int i;
+    
+    for (i = 0; i < prom->int_nb_students; i++)
+    {
+        reserve_student_courses_in(prom->arena_memory, &prom->student_students[i],
+                                   prom->student_students[i].int_nb_courses + int_nb_courses);
+    }
+}
+
+/*!
+ * \fn static void reserve_course_grades(Prom* prom, int int_nb_grades)
+ * \brief Sizes the grades of every course from the line count of the NOTES section
+ * \param prom Pointer to the cohort whose students and courses are loaded
+ * \param int_nb_grades Number of lines of the NOTES section
+ */
+static void reserve_course_grades(Prom* prom, int int_nb_grades)
+{
+    Student* student;
+    long long nb_slots;
+    int per_course;
+    int i;
+    int j;
+    
+    nb_slots = 0;
+    for (i = 0; i < prom->int_nb_students; i++)
+    {
+        nb_slots += prom->student_students[i].int_nb_courses;
+    }
+    if (nb_slots == 0)
+    {
+        return;
+    }
+    
+    /* Each course gets room for the average number of grades, the others still grow geometrically */
+    per_course = (int)((int_nb_grades + nb_slots - 1) / nb_slots);
+    for (i = 0; i < prom->int_nb_students; i++)
+    {
+        student = &prom->student_students[i];
+        for (j = 0; j < student->int_nb_courses; j++)
+        {
+            reserve_grades_in(prom->arena_memory, &student->course_courses[j].grades,
+                              student->course_courses[j].grades.int_nb_grades + per_course);
+        }
+    }
+}
+
+/*!
+ * \fn static void load_section(Prom* prom, const char* text, const char* end, int int_line, int (*add_line)(Prom*, const char*, size_t))
+ * \brief Parses in place all data lines of a section until the first empty line
+ * \param prom Pointer to the cohort to fill
+ * \param text First data line of the section
+ * \param end End of the memory block
+ * \param int_line Number of the first data line in the file, for the error messages
+ * \param add_line Function parsing one line of the section
+ */
+static void load_section(Prom* prom, const char* text, const char* end, int int_line,
+                         int (*add_line)(Prom*, const char*, size_t))
+{
+    const char* line_end;
+    int error;
+    
+    while (text < end)
+    {
+        line_end = next_line_end(text, end);
+        if (line_end == text)
+        {
+            break;
+        }
+        error = add_line(prom, text, line_end - text);
+        if (error != PARSE_OK)
+        {
+            report_parse_error(int_line, error);
+        }
+        text = line_end + 1;
+        int_line++;
+    }
+}
+
+/*!
+ * \struct ParsedGrade
+ * \brief Grade of the NOTES section parsed by a worker, with its resolved course
+ */
+typedef struct
+{
+    Course* course;           /*!< Course of the student receiving the grade */
+    float float_grade;        /*!< Grade */
+} ParsedGrade;
+
+/*!
+ * \struct LineError
+ * \brief Line of the NOTES section rejected by a worker
+ */
+typedef struct
+{
+    int int_line;             /*!< Number of the line in its chunk (from 0) */
+    int int_error;            /*!< PARSE_ error code of the line */
+} LineError;
+
+/*!
+ * \struct NotesChunk
+ * \brief Whole lines of the NOTES section parsed by one task, and their results
+ */
+typedef struct
+{
+    const char* char_begin;   /*!< First line of the chunk */
+    const char* char_end;     /*!< End of the chunk, just after a newline */
+    ParsedGrade* grade_grades; /*!< Dynamic array of the grades, in line order */
+    int int_nb_grades;        /*!< Number of grades */
+    int int_max_grades;       /*!< Allocated size of the grades array */
+    LineError* error_errors;  /*!< Dynamic array of the rejected lines */
+    int int_nb_errors;        /*!< Number of rejected lines */
+    int int_max_errors;       /*!< Allocated size of the rejected lines array */
+    int int_nb_lines;         /*!< Number of lines of the chunk */
+    int int_nb_unknown_ids;   /*!< Number of grades of an unknown student identifier */
+    int int_failed;           /*!< 1 if an allocation failed */
+} NotesChunk;
+
+/*!
+ * \struct NotesContext
+ * \brief Context of the tasks parsing the NOTES section
+ */
+typedef struct
+{
+    const Prom* prom;         /*!< Indexed cohort, only read by the tasks */
+    NotesChunk* chunk_chunks; /*!< Array of the chunks */
+} NotesContext;
+
+/*!
+ * \fn static int push_line_error(NotesChunk* chunk, int int_error)
+ * \brief Records the current line of a chunk as rejected
+ * \param chunk Pointer to the chunk
+ * \param int_error PARSE_ error code of the line
+ * \return 0 on success, -1 on allocation error
+ */
+static int push_line_error(NotesChunk* chunk, int int_error)
+{
+    LineError* new_errors;
+    int new_max;
+    
+    if (chunk->int_nb_errors == chunk->int_max_errors)
+    {
+        new_max = (chunk->int_max_errors > 0 ? chunk->int_max_errors * 2 : 16);
+        new_errors = (LineError*)realloc(chunk->error_errors, new_max * sizeof(LineError));
+        if (new_errors == NULL)
+        {
+            return (-1);
+        }
+        chunk->error_errors = new_errors;
+        chunk->int_max_errors = new_max;
+    }
+    chunk->error_errors[chunk->int_nb_errors].int_line = chunk->int_nb_lines;
+    chunk->error_errors[chunk->int_nb_errors].int_error = int_error;
+    chunk->int_nb_errors++;
+    
+    return (0);
+}
+
+/*!
+ * \fn static int push_parsed_grade(NotesChunk* chunk, Course* course, float float_grade)
+ * \brief Records a grade parsed in a chunk
+ * \param chunk Pointer to the chunk
+ * \param course Pointer to the course receiving the grade
+ * \param float_grade Grade
+ * \return 0 on success, -1 on allocation error
+ */
+static int push_parsed_grade(NotesChunk* chunk, Course* course, float float_grade)
+{
+    ParsedGrade* new_grades;
+    int new_max;
+    
+    if (chunk->int_nb_grades == chunk->int_max_grades)
+    {
+        new_max = (chunk->int_max_grades > 0 ? chunk->int_max_grades * 2 : 1024);
+        new_grades = (ParsedGrade*)realloc(chunk->grade_grades, new_max * sizeof(ParsedGrade));
+        if (new_grades == NULL)
+        {
+            return (-1);
+        }
+        chunk->grade_grades = new_grades;
+        chunk->int_max_grades = new_max;
+    }
+    chunk->grade_grades[chunk->int_nb_grades].course = course;
+    chunk->grade_grades[chunk->int_nb_grades].float_grade = float_grade;
+    chunk->int_nb_grades++;
+    
+    return (0);
+}
+
+/*!
+ * \fn static void parse_notes_chunk(const Prom* prom, NotesChunk* chunk)
+ * \brief Parses the lines of a chunk into its own grade and error arrays
+ * \param prom Pointer to the indexed cohort (student index, catalog and courses are only read)
+ * \param chunk Pointer to the chunk
+ */
+static void parse_notes_chunk(const Prom* prom, NotesChunk* chunk)
+{
+    const char* text;
+    const char* line_end;
+    const char* course_name;
+    size_t course_len;
+    int student_id;
+    int course_id;
+    int error;
+    int result;
+    float grade;
+    Student* student;
+    Course* course;
     
-    /* Free the last line if necessary */
-    if (line != NULL) 
+    text = chunk->char_begin;
+    while (text < chunk->char_end)
     {
-        free(line);
+        line_end = memchr(text, '\n', chunk->char_end - text);
+        
+        /* Same rules as add_grade_line, but the grade is only recorded */
+        result = 0;
+        error = parse_grade_view(text, line_end - text, &student_id, &course_name, &course_len, &grade);
+        if (error != PARSE_OK)
+        {
+            result = push_line_error(chunk, error);
+        }
+        else if ((student = find_student_by_id(prom, student_id)) == NULL)
+        {
+            chunk->int_nb_unknown_ids++;
+        }
+        else
+        {
+            course_id = find_course_id(&prom->catalog, course_name, course_len);
+            course = (course_id >= 0 ? find_student_course(student, course_id) : NULL);
+            if (course != NULL)
+            {
+                result = push_parsed_grade(chunk, course, grade);
+            }
+        }
+        if (result != 0)
+        {
+            chunk->int_failed = 1;
+            return;
+        }
+        
+        text = line_end + 1;
+        chunk->int_nb_lines++;
     }
 }
+
+/*!
+ * \fn static void merge_notes_chunk(Prom* prom, const NotesChunk* chunk, int int_line)
+ * \brief Reports the rejected lines of a parsed chunk and appends its grades
+ * \param prom Pointer to the cohort the chunk was parsed against
+ * \param chunk Pointer to the parsed chunk
+ * \param int_line Number of the first line of the chunk in the file
+ */
+static void merge_notes_chunk(Prom* prom, const NotesChunk* chunk, int int_line)
+{
+    int i;
+    
+    for (i = 0; i < chunk->int_nb_errors; i++)
+    {
+        report_parse_error(int_line + chunk->error_errors[i].int_line, chunk->error_errors[i].int_error);
+    }
+    for (i = 0; i < chunk->int_nb_grades; i++)
+    {
+        append_grade(prom->arena_memory, chunk->grade_grades[i].course, chunk->grade_grades[i].float_grade);
+    }
+    prom->int_nb_unknown_ids += chunk->int_nb_unknown_ids;
+}
+
+/*!
+ * \fn static void free_notes_chunk(NotesChunk* chunk)
+ * \brief Frees the results of a parsed chunk (not its lines)
+ * \param chunk Pointer to the chunk
+ */
+static void free_notes_chunk(NotesChunk* chunk)
+{
+    free(chunk->grade_grades);
+    free(chunk->error_errors);
+    chunk->grade_grades = NULL;
+    chunk->error_errors = NULL;
+}
+
+/*!
+ * \fn static void parse_notes_task(void* context, int int_begin, int int_end)
+ * \brief Thread pool task parsing the chunks [int_begin, int_end[ of the NOTES section
+ * \param context Pointer to the NotesContext
+ * \param int_begin First chunk
+ * \param int_end End of the range of chunks
+ */
+static void parse_notes_task(void* context, int int_begin, int int_end)
+{
+    NotesContext* notes;
+    int i;
+    
+    notes = (NotesContext*)context;
+    for (i = int_begin; i < int_end; i++)
+    {
+        parse_notes_chunk(notes->prom, &notes->chunk_chunks[i]);
+    }
+}
+
+/*!
+ * \fn static int load_notes_parallel(Prom* prom, const char* text, const char* end, int int_line, ThreadPool* pool)
+ * \brief Parses the NOTES section on a thread pool, then appends the grades in file order
+ * \param prom Pointer to the indexed cohort with its courses
+ * \param text First data line of the section
+ * \param end End of the memory block (just after a newline)
+ * \param int_line Number of the first data line in the file, for the error messages
+ * \param pool Pointer to the thread pool
+ * \return 0 on success, -1 if the chunks cannot be allocated (nothing is then appended)
+ * 
+ * The workers only read the cohort. The grades are appended by the calling
+ * thread, chunk after chunk: each course receives its grades in the same
+ * order as with load_section.
+ */
+static int load_notes_parallel(Prom* prom, const char* text, const char* end, int int_line, ThreadPool* pool)
+{
+    NotesContext context;
+    NotesChunk* chunk;
+    const char* section_end;
+    const char* boundary;
+    size_t size_section;
+    int nb_chunks;
+    int result;
+    int i;
+    
+    /* The section ends at the first empty line */
+    section_end = text;
+    while (section_end < end && *section_end != '\n')
+    {
+        section_end = skip_line(section_end, end);
+    }
+    size_section = section_end - text;
+    nb_chunks = (int)((size_section + NOTES_CHUNK_SIZE - 1) / NOTES_CHUNK_SIZE);
+    if (nb_chunks == 0)
+    {
+        return (0);
+    }
+    
+    context.prom = prom;
+    context.chunk_chunks = (NotesChunk*)calloc(nb_chunks, sizeof(NotesChunk));
+    if (context.chunk_chunks == NULL)
+    {
+        return (-1);
+    }
+    
+    /* Chunks of about the same size, cut just after a newline */
+    for (i = 0; i < nb_chunks; i++)
+    {
+        chunk = &context.chunk_chunks[i];
+        chunk->char_begin = (i > 0 ? context.chunk_chunks[i - 1].char_end : text);
+        boundary = text + size_section / nb_chunks * (i + 1);
+        if (i == nb_chunks - 1)
+        {
+            chunk->char_end = section_end;
+        }
+        else if (boundary <= chunk->char_begin)
+        {
+            /* The previous chunk ended past this one: it stays empty */
+            chunk->char_end = chunk->char_begin;
+        }
+        else
+        {
+            chunk->char_end = (const char*)memchr(boundary - 1, '\n', section_end - (boundary - 1)) + 1;
+        }
+    }
+    
+    run_thread_pool(pool, nb_chunks, 1, parse_notes_task, &context);
+    
+    result = 0;
+    for (i = 0; i < nb_chunks; i++)
+    {
+        if (context.chunk_chunks[i].int_failed)
+        {
+            result = -1;
+        }
+    }
+    
+    /* Merge in file order, chunk after chunk */
+    for (i = 0; result == 0 && i < nb_chunks; i++)
+    {
+        merge_notes_chunk(prom, &context.chunk_chunks[i], int_line);
+        int_line += context.chunk_chunks[i].int_nb_lines;
+    }
+    
+    for (i = 0; i < nb_chunks; i++)
+    {
+        free_notes_chunk(&context.chunk_chunks[i]);
+    }
+    free(context.chunk_chunks);
+    
+    return (result);
+}
+
+/*!
+ * \struct NotesBatch
+ * \brief Lines of the NOTES section sent by the reader stage of the pipeline to a parser
+ */
+typedef struct
+{
+    NotesChunk chunk;         /*!< Lines of the batch and, once parsed, their grades */
+    char* char_lines;         /*!< Buffer holding the lines, each followed by a newline */
+    size_t size_used;         /*!< Number of bytes of the lines */
+    size_t size_capacity;     /*!< Allocated size of the buffer */
+    int int_first_line;       /*!< Number of the first line of the batch in the file */
+} NotesBatch;
+
+/*!
+ * \struct ReaderStage
+ * \brief Arguments of the reader thread of the pipeline
+ */
+typedef struct
+{
+    LineReader* reader;       /*!< Reader of the data file, only used by the thread */
+    SpscQueue** queue_lines;  /*!< Queue of the batches of each parser */
+    int int_nb_parsers;       /*!< Number of parsers */
+    int int_failed;           /*!< 1 if a batch could not be allocated (read after the join) */
+} ReaderStage;
+
+/*!
+ * \struct ParserStage
+ * \brief Arguments of a parser thread of the pipeline
+ */
+typedef struct
+{
+    const Prom* prom;         /*!< Indexed cohort, only read */
+    SpscQueue* queue_lines;   /*!< Batches to parse, from the reader */
+    SpscQueue* queue_grades;  /*!< Parsed batches, to the inserter */
+} ParserStage;
+
+/*!
+ * \fn static void free_notes_batch(NotesBatch* batch)
+ * \brief Frees a batch of lines and its results
+ * \param batch Pointer to the batch (may be NULL)
+ */
+static void free_notes_batch(NotesBatch* batch)
+{
+    if (batch != NULL)
+    {
+        free_notes_chunk(&batch->chunk);
+        free(batch->char_lines);
+        free(batch);
+    }
+}
+
+/*!
+ * \fn static int add_batch_line(NotesBatch* batch, const Line* line)
+ * \brief Copies a line and its newline at the end of a batch
+ * \param batch Pointer to the batch
+ * \param line Pointer to the line
+ * \return 0 on success, -1 on allocation error
+ */
+static int add_batch_line(NotesBatch* batch, const Line* line)
+{
+    char* new_lines;
+    size_t new_capacity;
+    
+    if (batch->size_used + line->size_len + 1 > batch->size_capacity)
+    {
+        new_capacity = batch->size_capacity * 2;
+        if (new_capacity < batch->size_used + line->size_len + 1)
+        {
+            new_capacity = batch->size_used + line->size_len + 1;
+        }
+        new_lines = (char*)realloc(batch->char_lines, new_capacity);
+        if (new_lines == NULL)
+        {
+            return (-1);
+        }
+        batch->char_lines = new_lines;
+        batch->size_capacity = new_capacity;
+    }
+    memcpy(batch->char_lines + batch->size_used, line->char_text, line->size_len);
+    batch->char_lines[batch->size_used + line->size_len] = '\n';
+    batch->size_used += line->size_len + 1;
+    
+    return (0);
+}
+
+/*!
+ * \fn static void* read_notes_stage(void* arg)
+ * \brief Reader thread: cuts the NOTES section into batches dealt to the parsers in turn
+ * \param arg Pointer to the ReaderStage
+ * \return NULL
+ * 
+ * Batch n goes to parser n modulo the number of parsers. The end of the
+ * section is then signalled by one NULL per parser, in the same order.
+ */
+static void* read_notes_stage(void* arg)
+{
+    ReaderStage* stage;
+    NotesBatch* batch;
+    Line line;
+    int has_line;
+    int next;
+    int i;
+    
+    stage = (ReaderStage*)arg;
+    batch = NULL;
+    next = 0;
+    
+    /* Position to the NOTES section */
+    has_line = get_to_type(stage->reader, "NOTES", &line);
+    
+    while (has_line && line.size_len > 0)
+    {
+        if (batch == NULL)
+        {
+            batch = (NotesBatch*)calloc(1, sizeof(NotesBatch));
+            if (batch == NULL)
+            {
+                stage->int_failed = 1;
+                break;
+            }
+            batch->int_first_line = stage->reader->int_nb_lines;
+            batch->size_capacity = NOTES_CHUNK_SIZE;
+            batch->char_lines = (char*)malloc(batch->size_capacity);
+        }
+        if (batch->char_lines == NULL || add_batch_line(batch, &line) != 0)
+        {
+            stage->int_failed = 1;
+            break;
+        }
+        
+        /* A full batch goes to the next parser, waiting if its queue is full */
+        if (batch->size_used >= NOTES_CHUNK_SIZE)
+        {
+            batch->chunk.char_begin = batch->char_lines;
+            batch->chunk.char_end = batch->char_lines + batch->size_used;
+            push_spsc_queue(stage->queue_lines[next], batch);
+            next = (next + 1) % stage->int_nb_parsers;
+            batch = NULL;
+        }
+        
+        /* Read the next line */
+        has_line = read_next_line(stage->reader, &line);
+    }
+    
+    if (batch != NULL && !stage->int_failed)
+    {
+        batch->chunk.char_begin = batch->char_lines;
+        batch->chunk.char_end = batch->char_lines + batch->size_used;
+        push_spsc_queue(stage->queue_lines[next], batch);
+        next = (next + 1) % stage->int_nb_parsers;
+    }
+    else
+    {
+        free_notes_batch(batch);
+    }
+    
+    /* End of the section */
+    for (i = 0; i < stage->int_nb_parsers; i++)
+    {
+        push_spsc_queue(stage->queue_lines[(next + i) % stage->int_nb_parsers], NULL);
+    }
+    
+    return (NULL);
+}
+
+/*!
+ * \fn static void* parse_notes_stage(void* arg)
+ * \brief Parser thread: parses the batches of its queue and forwards them to the inserter
+ * \param arg Pointer to the ParserStage
+ * \return NULL
+ */
+static void* parse_notes_stage(void* arg)
+{
+    ParserStage* stage;
+    NotesBatch* batch;
+    
+    stage = (ParserStage*)arg;
+    do
+    {
+        batch = (NotesBatch*)pop_spsc_queue(stage->queue_lines);
+        if (batch != NULL)
+        {
+            parse_notes_chunk(stage->prom, &batch->chunk);
+        }
+        
+        /* The end of the section is forwarded as well */
+        push_spsc_queue(stage->queue_grades, batch);
+    }
+    while (batch != NULL);
+    
+    return (NULL);
+}
+
+/*!
+ * \fn static void stop_parser_stages(ParserStage* parsers, pthread_t* threads, int int_nb_started)
+ * \brief Ends parser threads that have not received any batch and waits for them
+ * \param parsers Array of the parser arguments
+ * \param threads Array of the parser threads
+ * \param int_nb_started Number of parser threads started
+ */
+static void stop_parser_stages(ParserStage* parsers, pthread_t* threads, int int_nb_started)
+{
+    int i;
+    
+    for (i = 0; i < int_nb_started; i++)
+    {
+        push_spsc_queue(parsers[i].queue_lines, NULL);
+        pop_spsc_queue(parsers[i].queue_grades);
+        pthread_join(threads[i], NULL);
+    }
+}
+
+/*!
+ * \fn static int run_notes_pipeline(LineReader* reader, Prom* prom, int int_nb_parsers)
+ * \brief Loads the NOTES section through the reader, parser and inserter stages
+ * \param reader Pointer to the reader of the data file
+ * \param prom Pointer to the indexed cohort with its courses
+ * \param int_nb_parsers Number of parser threads
+ * \return 0 on success, 1 if the pipeline cannot be started (the reader is then untouched), -1 on allocation error
+ */
+static int run_notes_pipeline(LineReader* reader, Prom* prom, int int_nb_parsers)
+{
+    ReaderStage reader_stage;
+    ParserStage* parsers;
+    SpscQueue** queues;
+    pthread_t* threads;
+    pthread_t reader_thread;
+    NotesBatch* batch;
+    int nb_started;
+    int result;
+    int next;
+    int i;
+    
+    /* One queue from the reader to each parser, one from each parser to the inserter */
+    parsers = (ParserStage*)calloc(int_nb_parsers, sizeof(ParserStage));
+    queues = (SpscQueue**)calloc(int_nb_parsers, sizeof(SpscQueue*));
+    threads = (pthread_t*)calloc(int_nb_parsers, sizeof(pthread_t));
+    result = (parsers != NULL && queues != NULL && threads != NULL ? 0 : 1);
+    for (i = 0; result == 0 && i < int_nb_parsers; i++)
+    {
+        parsers[i].prom = prom;
+        parsers[i].queue_lines = create_spsc_queue(PIPELINE_QUEUE_BATCHES);
+        parsers[i].queue_grades = create_spsc_queue(PIPELINE_QUEUE_BATCHES);
+        queues[i] = parsers[i].queue_lines;
+        if (parsers[i].queue_lines == NULL || parsers[i].queue_grades == NULL)
+        {
+            result = 1;
+        }
+    }
+    
+    /* Parsers, then the reader: the reader is the only user of the LineReader */
+    nb_started = 0;
+    while (result == 0 && nb_started < int_nb_parsers)
+    {
+        if (pthread_create(&threads[nb_started], NULL, parse_notes_stage, &parsers[nb_started]) != 0)
+        {
+            result = 1;
+            break;
+        }
+        nb_started++;
+    }
+    reader_stage.reader = reader;
+    reader_stage.queue_lines = queues;
+    reader_stage.int_nb_parsers = int_nb_parsers;
+    reader_stage.int_failed = 0;
+    if (result == 0 && pthread_create(&reader_thread, NULL, read_notes_stage, &reader_stage) != 0)
+    {
+        result = 1;
+    }
+    if (result != 0)
+    {
+        stop_parser_stages(parsers, threads, nb_started);
+    }
+    else
+    {
+        /* Inserter: the batches come back in file order by taking the parsers in turn */
+        next = 0;
+        while ((batch = (NotesBatch*)pop_spsc_queue(parsers[next].queue_grades)) != NULL)
+        {
+            if (batch->chunk.int_failed)
+            {
+                result = -1;
+            }
+            if (result == 0)
+            {
+                merge_notes_chunk(prom, &batch->chunk, batch->int_first_line);
+            }
+            free_notes_batch(batch);
+            next = (next + 1) % int_nb_parsers;
+        }
+        
+        /* The other parsers end right after it */
+        for (i = 1; i < int_nb_parsers; i++)
+        {
+            pop_spsc_queue(parsers[(next + i) % int_nb_parsers].queue_grades);
+        }
+        pthread_join(reader_thread, NULL);
+        for (i = 0; i < int_nb_parsers; i++)
+        {
+            pthread_join(threads[i], NULL);
+        }
+        if (reader_stage.int_failed)
+        {
+            result = -1;
+        }
+    }
+    
+    for (i = 0; parsers != NULL && i < int_nb_parsers; i++)
+    {
+        destroy_spsc_queue(parsers[i].queue_lines);
+        destroy_spsc_queue(parsers[i].queue_grades);
+    }
+    free(parsers);
+    free(queues);
+    free(threads);
+    
+    return (result);
+}
+
+/*!
+ * \fn int get_all_grades_pipelined(LineReader* reader, Prom* prom, int int_nb_parsers)
+ * \brief Loads all grades like get_all_grades, reading, parsing and inserting them on separate threads
+ * \param reader Pointer to the reader of the data file
+ * \param prom Pointer to the cohort containing the students
+ * \param int_nb_parsers Number of parser threads (0 or less: one less than the online processors)
+ * \return 0 on success, -1 on allocation error
+ */
+int get_all_grades_pipelined(LineReader* reader, Prom* prom, int int_nb_parsers)
+{
+    long nb_processors;
+    int result;
+    
+    /* Grades are appended per course: leave the columnar store */
+    release_grade_store(prom);
+    
+    if (int_nb_parsers <= 0)
+    {
+        nb_processors = sysconf(_SC_NPROCESSORS_ONLN);
+        int_nb_parsers = (nb_processors > 1 ? (int)nb_processors - 1 : 1);
+    }
+    if (int_nb_parsers > PIPELINE_MAX_PARSERS)
+    {
+        int_nb_parsers = PIPELINE_MAX_PARSERS;
+    }
+    
+    result = run_notes_pipeline(reader, prom, int_nb_parsers);
+    if (result > 0)
+    {
+        /* No thread could be started: serial load */
+        load_grades_serial(reader, prom);
+        return (0);
+    }
+    report_unknown_ids(prom);
+    
+    /* Update all course averages */
+    update_course_average(prom);
+    
+    /* Update all student overall averages */
+    update_student_average(prom);
+    
+    return (result);
+}
+
+/*!
+ * \fn static int load_prom_from_memory(const char* data, size_t size, Prom* prom, ThreadPool* pool)
+ * \brief Loads students, courses and grades from a data file held in memory
+ * \param data Content of the data file, ending with a newline
+ * \param size Size of the content in bytes
+ * \param prom Pointer to the Prom structure to fill
+ * \param pool Pointer to the thread pool parsing the grades, NULL to parse them on the calling thread
+ * \return 0 on success, -1 if a section is missing or on allocation error
+ */
+static int load_prom_from_memory(const char* data, size_t size, Prom* prom, ThreadPool* pool)
+{
+    const char* end;
+    const char* text;
+    const char* line_end;
+    const char* students;
+    const char* courses;
+    const char* grades;
+    size_t len;
+    int line;
+    int students_line;
+    int courses_line;
+    int grades_line;
+    
+    end = data + size;
+    students = NULL;
+    courses = NULL;
+    grades = NULL;
+    
+    /* Single scan: locate the three sections, whatever their order */
+    text = data;
+    line = 1;
+    students_line = 0;
+    courses_line = 0;
+    grades_line = 0;
+    while (text < end && (students == NULL || courses == NULL || grades == NULL))
+    {
+        line_end = next_line_end(text, end);
+        len = line_end - text;
+        
+        /* The section data starts after the separator and the header line */
+        if (len == 9 && memcmp(text, "ETUDIANTS", 9) == 0 && students == NULL)
+        {
+            students = skip_line(skip_line(text, end), end);
+            students_line = line + 2;
+        }
+        else if (len == 8 && memcmp(text, "MATIERES", 8) == 0 && courses == NULL)
+        {
+            courses = skip_line(skip_line(text, end), end);
+            courses_line = line + 2;
+        }
+        else if (len == 5 && memcmp(text, "NOTES", 5) == 0 && grades == NULL)
+        {
+            grades = skip_line(skip_line(text, end), end);
+            grades_line = line + 2;
+        }
+        
+        text = (line_end < end ? line_end + 1 : end);
+        line++;
+    }
+    
+    /* Display the sections that were not found */
+    if (students == NULL)
+    {
+        printf("ETUDIANTS not found in file\n");
+    }
+    if (courses == NULL)
+    {
+        printf("MATIERES not found in file\n");
+    }
+    if (grades == NULL)
+    {
+        printf("NOTES not found in file\n");
+    }
+    if (students == NULL || courses == NULL || grades == NULL)
+    {
+        return (-1);
+    }
+    
+    /* Parse the sections in dependency order, sizing the arrays from a count of their lines */
+    reserve_prom_students(prom, prom->int_nb_students + count_section_lines(students, end));
+    load_section(prom, students, end, students_line, add_student_line);
+    build_student_index(prom);
+    reserve_student_courses(prom, count_section_lines(courses, end));
+    load_section(prom, courses, end, courses_line, add_course_line);
+    reserve_course_grades(prom, count_section_lines(grades, end));
+    if (pool == NULL || get_thread_pool_size(pool) <= 1)
+    {
+        load_section(prom, grades, end, grades_line, add_grade_line);
+    }
+    else if (load_notes_parallel(prom, grades, end, grades_line, pool) != 0)
+    {
+        return (-1);
+    }
+    report_unknown_ids(prom);
+    
+    /* Update all course and student overall averages */
+    update_averages_parallel(prom, pool);
+    
+    return (0);
+}
+
+/*!
+ * \fn int load_prom_mapped(const char* str_filename, Prom* prom)
+ * \brief Loads students, courses and grades by mapping the data file in memory
+ * \param str_filename Name of the data file
+ * \param prom Pointer to the Prom structure to fill
+ * \return 0 on success, -1 on error
+ */
+int load_prom_mapped(const char* str_filename, Prom* prom)
+{
+    return (load_prom_mapped_parallel(str_filename, prom, NULL));
+}
+
+/*!
+ * \fn int load_prom_mapped_parallel(const char* str_filename, Prom* prom, ThreadPool* pool)
+ * \brief Loads students, courses and grades by mapping the data file, parsing the grades on a thread pool
+ * \param str_filename Name of the data file
+ * \param prom Pointer to the Prom structure to fill
+ * \param pool Pointer to the thread pool (NULL: serial load)
+ * \return 0 on success, -1 on error
+ */
+int load_prom_mapped_parallel(const char* str_filename, Prom* prom, ThreadPool* pool)
+{
+    int fd;
+    struct stat st;
+    char* data;
+    char* copy;
+    int result;
+    
+    /* Parameter verification */
+    if (str_filename == NULL || prom == NULL)
+    {
+        return (-1);
+    }
+    
+    /* Students, courses and grades are appended: a lazy promotion must be fully loaded */
+    if (materialize_prom(prom) != 0)
+    {
+        return (-1);
+    }
+    
+    /* Open the file and get its size */
+    fd = open(str_filename, O_RDONLY);
+    if (fd < 0)
+    {
+        printf("Error: Cannot open file %s\n", str_filename);
+        return (-1);
+    }
+    if (fstat(fd, &st) != 0 || st.st_size == 0)
+    {
+        close(fd);
+        return (-1);
+    }
+    
+    /* Map the whole file read-only */
+    data = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (data == MAP_FAILED)
+    {
+        printf("Error: Cannot map file %s\n", str_filename);
+        return (-1);
+    }
+    madvise(data, st.st_size, MADV_SEQUENTIAL);
+    
+    /* The field tokenizer reads the lines in place, but the NOTES chunks are cut at newlines: the last line needs one too */
+    if (data[st.st_size - 1] == '\n')
+    {
+        result = load_prom_from_memory(data, st.st_size, prom, pool);
+    }
+    else
+    {
+        /* Rare case: copy the file to add the missing final newline */
+        copy = malloc(st.st_size + 1);
+        if (copy == NULL)
+        {
+            munmap(data, st.st_size);
+            return (-1);
+        }
+        memcpy(copy, data, st.st_size);
+        copy[st.st_size] = '\n';
+        result = load_prom_from_memory(copy, st.st_size + 1, prom, pool);
+        free(copy);
+    }
+    
+    munmap(data, st.st_size);
+    
+    return (result);
+}
+
+/*!
+ * \fn static int read_section(FILE* file, const char* type, int (*add_line)(void*, const char*, size_t), void* ctx)
+ * \brief Reads all data lines of a section of a data file, from its start
+ * \param file Data file
+ * \param type Name of the section
+ * \param add_line Function parsing one line of the section
+ * \param ctx Context passed to add_line
+ * \return 0 on success, -1 if the reader cannot be created
+ */
+static int read_section(FILE* file, const char* type, int (*add_line)(void*, const char*, size_t), void* ctx)
+{
+    LineReader reader;
+    Line line;
+    int has_line;
+    int error;
+    
+    /* The sections may come in any order */
+    rewind(file);
+    if (create_line_reader(&reader, file) != 0)
+    {
+        return (-1);
+    }
+    has_line = get_to_type(&reader, type, &line);
+    while (has_line && line.size_len > 0)
+    {
+        error = add_line(ctx, line.char_text, line.size_len);
+        if (error != PARSE_OK)
+        {
+            report_parse_error(reader.int_nb_lines, error);
+        }
+        has_line = read_next_line(&reader, &line);
+    }
+    destroy_line_reader(&reader);
+    
+    return (0);
+}
+
+/*!
+ * \struct ConvertState
+ * \brief State of a conversion while the NOTES section is spilled to the buckets
+ */
+typedef struct
+{
+    Prom* prom;               /*!< Students (without courses) and catalog */
+    FILE** file_buckets;      /*!< Bucket files, by range of student positions */
+    int int_nb_buckets;       /*!< Number of bucket files */
+    int int_failed;           /*!< 1 once a bucket write has failed */
+} ConvertState;
+
+/*!
+ * \fn static int get_bucket(int int_position, int int_nb_students, int int_nb_buckets)
+ * \brief Returns the bucket of a student position
+ * \param int_position Position of the student
+ * \param int_nb_students Number of students
+ * \param int_nb_buckets Number of buckets
+ * \return Bucket index, the buckets holding consecutive ranges of positions
+ */
+static int get_bucket(int int_position, int int_nb_students, int int_nb_buckets)
+{
+    return ((int)((long long)int_position * int_nb_buckets / int_nb_students));
+}
+
+/*!
+ * \fn static int add_student_header(void* ctx, const char* text, size_t len)
+ * \brief Section callback appending a student to the cohort of a conversion
+ * \param ctx Pointer to the Prom structure
+ * \param text Line view
+ * \param len Length of the line
+ * \return PARSE_OK or the PARSE_ error code of the line
+ */
+static int add_student_header(void* ctx, const char* text, size_t len)
+{
+    return (add_student_line((Prom*)ctx, text, len));
+}
+
+/*!
+ * \fn static int add_catalog_course(void* ctx, const char* text, size_t len)
+ * \brief Section callback adding a course to the catalog of a conversion
+ * \param ctx Pointer to the Prom structure
+ * \param text Line view
+ * \param len Length of the line
+ * \return PARSE_OK or the PARSE_ error code of the line
+ */
+static int add_catalog_course(void* ctx, const char* text, size_t len)
+{
+    int id;
+    
+    return (add_course_to_catalog(&((Prom*)ctx)->catalog, text, len, &id));
+}
+
+/*!
+ * \fn static int spill_grade_line(void* ctx, const char* text, size_t len)
+ * \brief Section callback writing a grade to the bucket of its student
+ * \param ctx Pointer to the ConvertState
+ * \param text Line view
+ * \param len Length of the line
+ * \return PARSE_OK or the PARSE_ error code of the line
+ */
+static int spill_grade_line(void* ctx, const char* text, size_t len)
+{
+    ConvertState* state;
+    SpilledGrade spilled;
+    const char* course_name;
+    size_t course_len;
+    int student_id;
+    float grade;
+    int position;
+    int course_id;
+    int bucket;
+    int error;
+    
+    state = (ConvertState*)ctx;
+    error = parse_grade_view(text, len, &student_id, &course_name, &course_len, &grade);
+    if (error != PARSE_OK)
+    {
+        return (error);
+    }
+    
+    /* Same lookups as add_grade_line */
+    position = find_student_position(state->prom, student_id);
+    if (position < 0)
+    {
+        state->prom->int_nb_unknown_ids++;
+        return (PARSE_OK);
+    }
+    course_id = find_course_id(&state->prom->catalog, course_name, course_len);
+    if (course_id < 0)
+    {
+        return (PARSE_OK);
+    }
+    
+    /* Input order is kept within a bucket, hence within each course */
+    spilled.int_position = position;
+    spilled.int_course_id = course_id;
+    spilled.float_grade = grade;
+    bucket = get_bucket(position, state->prom->int_nb_students, state->int_nb_buckets);
+    if (fwrite(&spilled, sizeof(SpilledGrade), 1, state->file_buckets[bucket]) != 1)
+    {
+        state->int_failed = 1;
+    }
+    
+    return (PARSE_OK);
+}
+
+/*!
+ * \fn static int write_bucket(FILE* out, Prom* header, FILE* bucket, int int_first, int int_nb_students)
+ * \brief Builds the students of one bucket with their grades and writes their version 1 records
+ * \param out Destination binary file
+ * \param header Pointer to the cohort holding all students and the catalog
+ * \param bucket Bucket file holding the grades of the students
+ * \param int_first Position of the first student of the bucket
+ * \param int_nb_students Number of students of the bucket
+ * \return 0 on success, -1 in case of error
+ */
+static int write_bucket(FILE* out, Prom* header, FILE* bucket, int int_first, int int_nb_students)
+{
+    SpilledGrade spilled[CONVERT_READ_RECORDS];
+    Prom part;
+    Student* student;
+    size_t nb_read;
+    size_t k;
+    int nb_courses;
+    int result;
+    int i;
+    int j;
+    
+    /* The names are borrowed from the header: the part must own nothing else */
+    part = create_arena_prom(0);
+    if (part.arena_memory == NULL)
+    {
+        return (-1);
+    }
+    part.catalog = header->catalog;
+    nb_courses = header->catalog.int_nb_courses;
+    result = 0;
+    
+    /* Every student follows every course, in catalog order, as with add_course_line */
+    if (reserve_prom_students(&part, int_nb_students) != 0)
+    {
+        result = -1;
+    }
+    for (i = 0; result == 0 && i < int_nb_students; i++)
+    {
+        student = &part.student_students[i];
+        *student = header->student_students[int_first + i];
+        student->course_courses = NULL;
+        student->int_max_courses = 0;
+        if (reserve_student_courses_in(part.arena_memory, student, nb_courses) != 0)
+        {
+            result = -1;
+            break;
+        }
+        for (j = 0; j < nb_courses; j++)
+        {
+            student->course_courses[j] = create_course_in(part.arena_memory, j, 0);
+        }
+        student->int_nb_courses = nb_courses;
+        part.int_nb_students++;
+    }
+    
+    /* Grades, in input order */
+    rewind(bucket);
+    while (result == 0 && (nb_read = fread(spilled, sizeof(SpilledGrade), CONVERT_READ_RECORDS, bucket)) > 0)
+    {
+        for (k = 0; k < nb_read; k++)
+        {
+            student = &part.student_students[spilled[k].int_position - int_first];
+            append_grade(part.arena_memory, &student->course_courses[spilled[k].int_course_id],
+                         spilled[k].float_grade);
+        }
+    }
+    if (result == 0 && ferror(bucket))
+    {
+        result = -1;
+    }
+    
+    if (result == 0)
+    {
+        update_course_average(&part);
+        update_student_average(&part);
+        result = write_prom_binary_v1(out, &part, 0);
+    }
+    
+    /* Give the catalog back before freeing the part */
+    part.catalog = create_catalog();
+    destroy_prom(&part);
+    
+    return (result);
+}
+
+/*!
+ * \fn static int get_split_count(off_t size_bucket, size_t size_budget, int int_nb_students)
+ * \brief Returns the number of buckets needed for grades spilled to a given size to fit in the budget
+ * \param size_bucket Size of the spilled grades (bytes)
+ * \param size_budget Memory budget of the grades (bytes)
+ * \param int_nb_students Number of students sharing the grades
+ * \return Number of buckets, between 1 and int_nb_students, at most CONVERT_MAX_BUCKETS
+ */
+static int get_split_count(off_t size_bucket, size_t size_budget, int int_nb_students)
+{
+    uint64_t nb_needed;
+    
+    nb_needed = ((uint64_t)size_bucket + size_budget - 1) / size_budget;
+    if (nb_needed > CONVERT_MAX_BUCKETS)
+    {
+        nb_needed = CONVERT_MAX_BUCKETS;
+    }
+    if (nb_needed > (uint64_t)int_nb_students)
+    {
+        nb_needed = int_nb_students;
+    }
+    
+    return (nb_needed > 0 ? (int)nb_needed : 1);
+}
+
+/*!
+ * \fn static int write_range(FILE* out, Prom* header, FILE* bucket, int int_first, int int_nb_students, size_t size_budget)
+ * \brief Writes the students of a bucket, splitting it first while its spilled grades exceed the budget
+ * \param out Destination binary file
+ * \param header Pointer to the cohort holding all students and the catalog
+ * \param bucket Bucket file holding the grades of the students
+ * \param int_first Position of the first student of the bucket
+ * \param int_nb_students Number of students of the bucket
+ * \param size_budget Memory budget of the grades (bytes)
+ * \return 0 on success, -1 in case of error
+ * 
+ * The first buckets are cut by student position, so a few students with
+ * many grades can fill one of them over the budget: its grades are then
+ * spread again over smaller ranges of students, keeping their input
+ * order, until each range fits. A single student is written whatever the
+ * size of its grades.
+ */
+static int write_range(FILE* out, Prom* header, FILE* bucket, int int_first, int int_nb_students, size_t size_budget)
+{
+    SpilledGrade spilled[CONVERT_READ_RECORDS];
+    FILE** file_parts;
+    off_t size_bucket;
+    size_t nb_read;
+    size_t k;
+    int nb_parts;
+    int first;
+    int last;
+    int result;
+    int p;
+    
+    /* The spilled records are larger than the grades they become once parsed */
+    if (fseeko(bucket, 0, SEEK_END) != 0 || (size_bucket = ftello(bucket)) < 0)
+    {
+        return (-1);
+    }
+    if (int_nb_students <= 1 || (uint64_t)size_bucket <= size_budget)
+    {
+        return (write_bucket(out, header, bucket, int_first, int_nb_students));
+    }
+    
+    /* At least two parts, each with fewer students: the splits always end */
+    nb_parts = get_split_count(size_bucket, size_budget, int_nb_students);
+    if (nb_parts < 2)
+    {
+        nb_parts = 2;
+    }
+    file_parts = (FILE**)calloc(nb_parts, sizeof(FILE*));
+    if (file_parts == NULL)
+    {
+        return (-1);
+    }
+    result = 0;
+    for (p = 0; result == 0 && p < nb_parts; p++)
+    {
+        file_parts[p] = tmpfile();
+        if (file_parts[p] == NULL)
+        {
+            result = -1;
+        }
+    }
+    
+    /* Grades, in input order, to the part of their student */
+    rewind(bucket);
+    while (result == 0 && (nb_read = fread(spilled, sizeof(SpilledGrade), CONVERT_READ_RECORDS, bucket)) > 0)
+    {
+        for (k = 0; k < nb_read; k++)
+        {
+            p = get_bucket(spilled[k].int_position - int_first, int_nb_students, nb_parts);
+            if (fwrite(&spilled[k], sizeof(SpilledGrade), 1, file_parts[p]) != 1)
+            {
+                result = -1;
+                break;
+            }
+        }
+    }
+    if (result == 0 && ferror(bucket))
+    {
+        result = -1;
+    }
+    
+    /* The parts, in student order */
+    first = 0;
+    for (p = 0; result == 0 && p < nb_parts; p++)
+    {
+        last = first;
+        while (last < int_nb_students && get_bucket(last, int_nb_students, nb_parts) == p)
+        {
+            last++;
+        }
+        if (last > first)
+        {
+            result = write_range(out, header, file_parts[p], int_first + first, last - first, size_budget);
+        }
+        
+        /* The grades of the part are no longer needed */
+        fclose(file_parts[p]);
+        file_parts[p] = NULL;
+        first = last;
+    }
+    
+    for (p = 0; p < nb_parts; p++)
+    {
+        if (file_parts[p] != NULL)
+        {
+            fclose(file_parts[p]);
+        }
+    }
+    free(file_parts);
+    
+    return (result);
+}
+
+/*!
+ * \fn static int convert_prom(FILE* text, FILE* out, size_t size_budget)
+ * \brief Converts an open data file to an open version 1 binary file
+ * \param text Data file
+ * \param out Destination binary file
+ * \param size_budget Memory budget of the grades (bytes)
+ * \return 0 on success, -1 in case of error
+ */
+static int convert_prom(FILE* text, FILE* out, size_t size_budget)
+{
+    ConvertState state;
+    Prom header;
+    struct stat st;
+    int first;
+    int last;
+    int result;
+    int b;
+    
+    /* Students and catalog first: they are needed to route the grades */
+    header = create_arena_prom(0);
+    if (header.arena_memory == NULL)
+    {
+        return (-1);
+    }
+    result = read_section(text, "ETUDIANTS", add_student_header, &header);
+    build_student_index(&header);
+    if (result == 0)
+    {
+        result = read_section(text, "MATIERES", add_catalog_course, &header);
+    }
+    
+    /* Enough buckets for the grades of one of them to fit in the budget, if they are spread evenly */
+    state.prom = &header;
+    state.file_buckets = NULL;
+    state.int_nb_buckets = 1;
+    state.int_failed = 0;
+    if (fstat(fileno(text), &st) == 0 && st.st_size > 0)
+    {
+        /* The grades take about twice their text once parsed into courses */
+        state.int_nb_buckets = get_split_count(st.st_size * 2, size_budget, header.int_nb_students);
+    }
+    if (result == 0)
+    {
+        state.file_buckets = (FILE**)calloc(state.int_nb_buckets, sizeof(FILE*));
+        result = (state.file_buckets != NULL ? 0 : -1);
+    }
+    for (b = 0; result == 0 && b < state.int_nb_buckets; b++)
+    {
+        state.file_buckets[b] = tmpfile();
+        if (state.file_buckets[b] == NULL)
+        {
+            result = -1;
+        }
+    }
+    
+    /* Grades: spilled to the bucket of their student */
+    if (result == 0)
+    {
+        result = read_section(text, "NOTES", spill_grade_line, &state);
+        if (state.int_failed)
+        {
+            result = -1;
+        }
+        report_unknown_ids(&header);
+    }
+    
+    /* Number of students, then the records bucket by bucket, in student order */
+    if (result == 0 && fwrite(&header.int_nb_students, sizeof(int), 1, out) != 1)
+    {
+        result = -1;
+    }
+    first = 0;
+    for (b = 0; result == 0 && b < state.int_nb_buckets && first < header.int_nb_students; b++)
+    {
+        last = first;
+        while (last < header.int_nb_students && get_bucket(last, header.int_nb_students, state.int_nb_buckets) == b)
+        {
+            last++;
+        }
+        if (last > first)
+        {
+            result = write_range(out, &header, state.file_buckets[b], first, last - first, size_budget);
+        }
+        
+        /* The grades of the bucket are no longer needed */
+        fclose(state.file_buckets[b]);
+        state.file_buckets[b] = NULL;
+        first = last;
+    }
+    
+    for (b = 0; state.file_buckets != NULL && b < state.int_nb_buckets; b++)
+    {
+        if (state.file_buckets[b] != NULL)
+        {
+            fclose(state.file_buckets[b]);
+        }
+    }
+    free(state.file_buckets);
+    destroy_prom(&header);
+    
+    return (result);
+}
+
+/*!
+ * \fn int convert_text_to_binary(const char* str_text, const char* str_binary, size_t size_budget)
+ * \brief Converts a data file to a version 1 binary file without loading its grades at once
+ * \param str_text Name of the data file
+ * \param str_binary Name of the binary file
+ * \param size_budget Memory budget of the grades (bytes), 0 for CONVERT_DEFAULT_BUDGET
+ * \return 0 on success, -1 in case of error
+ */
+int convert_text_to_binary(const char* str_text, const char* str_binary, size_t size_budget)
+{
+    FILE* text;
+    FILE* out;
+    int result;
+    
+    /* Parameter verification */
+    if (str_text == NULL || str_binary == NULL)
+    {
+        return (-1);
+    }
+    if (size_budget == 0)
+    {
+        size_budget = CONVERT_DEFAULT_BUDGET;
+    }
+    
+    text = fopen(str_text, "r");
+    if (text == NULL)
+    {
+        printf("Error: Cannot open file %s\n", str_text);
+        return (-1);
+    }
+    out = fopen(str_binary, "wb");
+    if (out == NULL)
+    {
+        fclose(text);
+        return (-1);
+    }
+    
+    result = convert_prom(text, out, size_budget);
+    
+    /* Close the files, without leaving a partial binary file behind */
+    if (fclose(out) != 0)
+    {
+        result = -1;
+    }
+    fclose(text);
+    if (result != 0)
+    {
+        remove(str_binary);
+    }
+    
+    return (result);
+}
@@ -13,6 +13,11 @@
 #include <stdlib.h> 
 #include "structures.h"
 #include "show.h"
+#include "courseCatalog.h"
+#include "sorting.h"
+#include "lazyLoad.h"
+#include "init.h"
+#include <string.h>
 
 /*!
  * \fn void show_grades(Grades grades)
@@ -21,6 +26,7 @@
  */
 void show_grades(Grades grades)
 {
+    const float* data;
     int i;
     
     /* Check if grades exist */
@@ -34,9 +40,10 @@ void show_grades(Grades grades)
     printf("  |    Grades (%d): ", grades.int_nb_grades);
     
     /* Display each grade separated by a comma */
+    data = get_grades_data(&grades);
     for (i = 0; i < grades.int_nb_grades; i++)
     {
-        printf("%.2f", grades.tab_grades[i]);
+        printf("%.2f", data[i]);
         
         /* Add a comma except for the last grade */
         if (i < grades.int_nb_grades - 1)
@@ -48,15 +55,19 @@ void show_grades(Grades grades)
 }
 
 /*!
- * \fn void show_course(Course course)
+ * \fn void show_course(Course course, const CourseCatalog* catalog)
  * \brief Displays complete information of a course
  * \param course Course structure to display
+ * \param catalog Catalog holding the name and coefficient of the course
  */
-void show_course(Course course)
+void show_course(Course course, const CourseCatalog* catalog)
 {
+    const CourseInfo* info;
+    
+    info = &catalog->info_courses[course.int_course_id];
     printf("  |  - %s (Coef: %.2f, Avg: %.2f)\n",
-           course.char_course_name,
-           course.float_coef,
+           info->char_course_name,
+           info->float_coef,
            course.float_average);
     
     /* Display all grades of the course */
@@ -65,11 +76,12 @@ void show_course(Course course)
 
 
 /*!
- * \fn void show_student(Student student)
+ * \fn void show_student(Student student, const CourseCatalog* catalog)
  * \brief Displays complete information of a student
  * \param student Student structure to display
+ * \param catalog Catalog of the courses of the promotion
  */
-void show_student(Student student)
+void show_student(Student student, const CourseCatalog* catalog)
 {
     int i;
     /* Display student's basic information */
@@ -87,7 +99,7 @@ void show_student(Student student)
     for (i = 0; i < student.int_nb_courses; i++)
     {
         printf("\n  [Course %d/%d]\n", i + 1, student.int_nb_courses);
-        show_course(student.course_courses[i]);
+        show_course(student.course_courses[i], catalog);
     }
 }
 
@@ -110,6 +122,7 @@ void show_student_info(Student student)
  */
 void show_prom(Prom prom)
 {
+    int position;
     int i;
     
     /* Display cohort header */
@@ -128,11 +141,17 @@ void show_prom(Prom prom)
         return;
     }
     
-    /* Display each student in the cohort */
+    /* Display each student in the cohort, in ranking order if it is ranked */
     for (i = 0; i < prom.int_nb_students; i++)
     {
+        position = (prom.tab_ranking != NULL ? prom.tab_ranking[i] : i);
         printf("\n[Student %d/%d]", i + 1, prom.int_nb_students);
-        show_student(prom.student_students[i]);
+        if (page_student_courses(&prom, position) != 0)
+        {
+            printf("\nError: Cannot read the courses of student %d\n", prom.student_students[position].int_id);
+            continue;
+        }
+        show_student(prom.student_students[position], &prom.catalog);
     }
     
     /* Display footer */
@@ -144,14 +163,33 @@ void show_prom(Prom prom)
 
 
 /*!
- * \fn void show_best(Prom prom, int n)
+ * \fn void show_best(const Prom* prom, int n)
  * \brief Displays the n best students of a cohort
- * \param prom Prom structure to display
- * \param n Number of students to display
+ * \param prom Pointer to the Prom structure to display
+ * \param n Number of students to display (at most the number of students)
  */
-void show_best(Student* students, int n){
+void show_best(const Prom* prom, int n){
+    int* positions;
     int i;
     
+    /* Never display more students than the cohort holds */
+    if (n > prom->int_nb_students)
+    {
+        n = prom->int_nb_students;
+    }
+    
+    /* Select the n best students (the cohort is neither sorted nor reordered) */
+    positions = NULL;
+    if (n > 0)
+    {
+        positions = (int*)malloc(n * sizeof(int));
+        n = (positions != NULL ? select_best_students(prom, -1, n, positions) : 0);
+    }
+    if (n < 0)
+    {
+        n = 0;
+    }
+    
     /* Display top students header */
     printf("\n");
     printf("===============================================\n");
@@ -163,6 +201,7 @@ void show_best(Student* students, int n){
     {
         printf("\nNo students \n");
         printf("===============================================\n\n");
+        free(positions);
         return;
     }
     
@@ -170,12 +209,50 @@ void show_best(Student* students, int n){
     for (i = 0; i < n; i++)
     {
         printf("\n[Top Student %d/%d]", i + 1, n);
-        show_student_info(students[i]);
+        show_student_info(prom->student_students[positions[i]]);
     }
+    free(positions);
     
     /* Display footer */
     printf("\n");
     printf("===============================================\n");
     printf("          END OF TOP STUDENTS DATA             \n");
     printf("===============================================\n\n");
-}
\ No newline at end of file
+}
+
+/*!
+ * \fn void show_best_in_course(const Prom* prom, const char* course_name, const int* positions, int n)
+ * \brief Displays the best students of a course
+ * \param prom Pointer to the Prom structure
+ * \param course_name Name of the course
+ * \param positions Positions of the students to display, best first
+ * \param n Number of positions
+ */
+void show_best_in_course(const Prom* prom, const char* course_name, const int* positions, int n)
+{
+    const Student* student;
+    const Course* course;
+    int course_id;
+    int i;
+    
+    course_id = find_course_id(&prom->catalog, course_name, strlen(course_name));
+    
+    printf("\n===============================================\n");
+    printf("          TOP %d STUDENTS IN %s         \n", n, course_name);
+    printf("===============================================\n");
+    
+    for (i = 0; i < n; i++)
+    {
+        student = &prom->student_students[positions[i]];
+        printf("\n[Top Student %d/%d]\n", i + 1, n);
+        printf("Grade in %s: ", course_name);
+        
+        /* Display the student's average in the course */
+        course = (page_student_courses(prom, positions[i]) == 0 ? find_student_course(student, course_id) : NULL);
+        if (course != NULL)
+        {
+            printf("%.2f\n", course->float_average);
+        }
+        show_student_info(*student);
+    }
+}
@@ -13,121 +13,487 @@
 #include <stdlib.h>
 #include <string.h>
 #include "sorting.h"
-#include "show.h"
+#include "courseCatalog.h"
+#include "lazyLoad.h"
 
 /*!
-* \fn void sort_students_by_average(Prom* prom)
-* \brief Sorts students by descending average
+* \struct RankKey
+* \brief Sort key of a student: its average, its identifier and its position
+*/
+typedef struct {
+    float float_average;   /*!< Overall average of the student */
+    int int_id;            /*!< Identifier of the student (tie-break) */
+    int int_position;      /*!< Position of the student in the promotion */
+} RankKey;
+
+/*!
+* \fn static int rank_before(const RankKey* a, const RankKey* b)
+* \brief Tells whether a student is ranked before another one
+* \param a Sort key of the first student
+* \param b Sort key of the second student
+* \return 1 if a has a higher average, or the same average and a smaller identifier
+* 
+* A NaN average (student without coefficient) is ranked after every number.
+*/
+static int rank_before(const RankKey* a, const RankKey* b) {
+    int a_is_nan = (a->float_average != a->float_average);
+    int b_is_nan = (b->float_average != b->float_average);
+    
+    if (a_is_nan != b_is_nan) {
+        return (b_is_nan);
+    }
+    if (!a_is_nan && a->float_average != b->float_average) {
+        return (a->float_average > b->float_average);
+    }
+    return (a->int_id < b->int_id);
+}
+
+/*!
+* \fn static void merge_keys(const RankKey* src, RankKey* dst, int begin, int middle, int end)
+* \brief Merges two sorted runs of keys
+* \param src Keys holding the runs [begin, middle[ and [middle, end[
+* \param dst Keys receiving the merged run [begin, end[
+* \param begin Start of the first run
+* \param middle Start of the second run
+* \param end End of the second run
+*/
+static void merge_keys(const RankKey* src, RankKey* dst, int begin, int middle, int end) {
+    int i = begin;
+    int j = middle;
+    
+    for (int k = begin; k < end; k++) {
+        /* Take from the first run on ties: the merge is stable */
+        if (i < middle && (j >= end || !rank_before(&src[j], &src[i]))) {
+            dst[k] = src[i++];
+        } else {
+            dst[k] = src[j++];
+        }
+    }
+}
+
+/*!
+* \fn static RankKey* sort_rank_keys(RankKey* keys, RankKey* buffer, int n)
+* \brief Sorts keys with a bottom-up merge sort (O(n log n), stable)
+* \param keys Keys to sort
+* \param buffer Array of n keys used by the merge passes
+* \param n Number of keys
+* \return keys or buffer, whichever holds the sorted keys
+*/
+static RankKey* sort_rank_keys(RankKey* keys, RankKey* buffer, int n) {
+    /* Merge runs of doubling width, swapping the roles of the two arrays */
+    for (int width = 1; width < n; width *= 2) {
+        for (int begin = 0; begin < n; begin += 2 * width) {
+            int middle = (begin + width < n ? begin + width : n);
+            int end = (begin + 2 * width < n ? begin + 2 * width : n);
+            merge_keys(keys, buffer, begin, middle, end);
+        }
+        RankKey* temp = keys;
+        keys = buffer;
+        buffer = temp;
+    }
+    return (keys);
+}
+
+/*!
+* \fn int* rank_students_by_average(const Prom* prom)
+* \brief Computes the positions of the students by descending average
 * 
-* This function sorts the student array of a promotion
-* in descending order of average using selection sort algorithm.
+* This function sorts the keys of the students with a bottom-up merge
+* sort (O(n log n)). Equal averages are ordered by increasing identifier,
+* so the ranking does not depend on the order of the student array.
 * 
 * \param prom Pointer to the Prom structure containing students
+* \return Array of int_nb_students positions to free by the caller, NULL on error
 */
-void sort_students_by_average(Prom* prom) {
-    if (prom == NULL || prom->student_students == NULL || prom->int_nb_students <= 1) {
-        return;
+int* rank_students_by_average(const Prom* prom) {
+    if (prom == NULL || prom->student_students == NULL || prom->int_nb_students <= 0) {
+        return (NULL);
+    }
+    int n = prom->int_nb_students;
+    
+    int* ranking = malloc(n * sizeof(int));
+    RankKey* keys = malloc(n * sizeof(RankKey));
+    RankKey* buffer = malloc(n * sizeof(RankKey));
+    if (ranking == NULL || keys == NULL || buffer == NULL) {
+        free(ranking);
+        free(keys);
+        free(buffer);
+        return (NULL);
+    }
+    
+    /* Gather the keys once: the merge passes do not touch the students */
+    for (int i = 0; i < n; i++) {
+        keys[i].float_average = prom->student_students[i].float_average;
+        keys[i].int_id = prom->student_students[i].int_id;
+        keys[i].int_position = i;
+    }
+    
+    RankKey* sorted = sort_rank_keys(keys, buffer, n);
+    for (int i = 0; i < n; i++) {
+        ranking[i] = sorted[i].int_position;
     }
+    
+    free(keys);
+    free(buffer);
+    return (ranking);
+}
 
-    /* Selection sort (descending order) */
-    for (int i = 0; i < prom->int_nb_students - 1; i++) {
-        int max_idx = i;
+/*!
+* \fn static void sift_down_worst(RankKey* heap, int size, int i)
+* \brief Restores the heap below a node (the worst student stays at the root)
+* \param heap Heap of keys
+* \param size Number of keys in the heap
+* \param i Node to move down
+*/
+static void sift_down_worst(RankKey* heap, int size, int i) {
+    while (1) {
+        int worst = i;
+        int left = 2 * i + 1;
+        int right = left + 1;
         
-        /* Find the student with the highest average */
-        for (int j = i + 1; j < prom->int_nb_students; j++) {
-            if (prom->student_students[j].float_average > prom->student_students[max_idx].float_average) {
-                max_idx = j;
-            }
+        if (left < size && rank_before(&heap[worst], &heap[left])) {
+            worst = left;
         }
-        
-        /* Swap if necessary */
-        if (max_idx != i) {
-            Student temp = prom->student_students[i];
-            prom->student_students[i] = prom->student_students[max_idx];
-            prom->student_students[max_idx] = temp;
+        if (right < size && rank_before(&heap[worst], &heap[right])) {
+            worst = right;
         }
+        if (worst == i) {
+            return;
+        }
+        RankKey temp = heap[i];
+        heap[i] = heap[worst];
+        heap[worst] = temp;
+        i = worst;
     }
 }
 
 /*!
-* \fn void sort_students_from_course(Prom* prom, char* course_name)
-* \brief Sorts students by average in a specific subject
+* \fn static void sift_up_worst(RankKey* heap, int i)
+* \brief Restores the heap above a node (the worst student stays at the root)
+* \param heap Heap of keys
+* \param i Node to move up
+*/
+static void sift_up_worst(RankKey* heap, int i) {
+    while (i > 0) {
+        int parent = (i - 1) / 2;
+        if (!rank_before(&heap[parent], &heap[i])) {
+            return;
+        }
+        RankKey temp = heap[i];
+        heap[i] = heap[parent];
+        heap[parent] = temp;
+        i = parent;
+    }
+}
+
+/*!
+* \fn int select_best_students(const Prom* prom, int course_id, int k, int* positions)
+* \brief Selects the k best students without sorting nor reordering the promotion
 * 
-* This function sorts the students of a promotion according to
-* their average in a given subject and displays the top three.
+* This function keeps the k best students seen so far in a bounded heap
+* whose root is the worst of them (O(n log k)), then empties the heap
+* from the end of the result. Equal averages are ordered by increasing
+* identifier, as in rank_students_by_average.
 * 
 * \param prom Pointer to the Prom structure containing students
-* \param course_name Name of the subject for sorting
+* \param course_id ID of the course in the catalog, or -1 for the overall average
+* \param k Number of students wanted
+* \param positions Array of at least k entries receiving the positions, best first
+* \return Number of positions written (at most k), or -1 on invalid parameters or allocation error
 */
-void sort_students_from_course(Prom* prom, char* course_name) {
-    if (prom == NULL || prom->student_students == NULL || prom->int_nb_students == 0 || course_name == NULL) {
-        exit(EXIT_FAILURE);
+int select_best_students(const Prom* prom, int course_id, int k, int* positions) {
+    if (prom == NULL || positions == NULL || course_id >= prom->catalog.int_nb_courses) {
+        return (-1);
     }
-    
-    /* Create copy of students array for sorting */
-    Student *students_copy = malloc(prom->int_nb_students * sizeof(Student));
-    if (students_copy == NULL) {
-        exit(EXIT_FAILURE);
+    if (k > prom->int_nb_students) {
+        k = prom->int_nb_students;
+    }
+    if (k <= 0) {
+        return (0);
     }
     
-    for (int i = 0; i < prom->int_nb_students; i++){
-        students_copy[i] = prom->student_students[i];
+    RankKey* heap = malloc(k * sizeof(RankKey));
+    if (heap == NULL) {
+        return (-1);
     }
     
-    /* Selection sort (descending order) */
-    for (int i = 0; i < prom->int_nb_students - 1; i++){
-        int max_idx = i;
+    int size = 0;
+    for (int i = 0; i < prom->int_nb_students; i++) {
+        const Student* student = &prom->student_students[i];
+        RankKey key;
         
-        /* Find the grade of the student at index max_idx */
-        float avg_max = -1.0f;
-        for (int k = 0; k < students_copy[max_idx].int_nb_courses; k++) {
-            if (strcmp(students_copy[max_idx].course_courses[k].char_course_name, course_name) == 0) {
-                avg_max = students_copy[max_idx].course_courses[k].float_average;
-                break;
+        /* Key of the student: overall average or average in the course */
+        if (course_id < 0) {
+            key.float_average = student->float_average;
+        } else {
+            if (page_student_courses(prom, i) != 0) {
+                free(heap);
+                return (-1);
+            }
+            const Course* course = find_student_course(student, course_id);
+            if (course == NULL) {
+                continue;
             }
+            key.float_average = course->float_average;
+        }
+        key.int_id = student->int_id;
+        key.int_position = i;
+        
+        /* Keep the student if the heap is not full or if it beats the worst kept */
+        if (size < k) {
+            heap[size] = key;
+            sift_up_worst(heap, size);
+            size++;
+        } else if (rank_before(&key, &heap[0])) {
+            heap[0] = key;
+            sift_down_worst(heap, size, 0);
         }
+    }
+    
+    /* The root is the worst kept student: fill the result from its end */
+    int count = size;
+    while (size > 0) {
+        positions[size - 1] = heap[0].int_position;
+        heap[0] = heap[size - 1];
+        size--;
+        sift_down_worst(heap, size, 0);
+    }
+    
+    free(heap);
+    return (count);
+}
 
-        for(int j = i + 1; j < prom->int_nb_students; j++) {
-            /* Search for student j's grade in the subject */
-            float avg_j = -1.0f;
-            for (int k = 0; k < students_copy[j].int_nb_courses; k++) {
-                if (strcmp(students_copy[j].course_courses[k].char_course_name, course_name) == 0) {
-                    avg_j = students_copy[j].course_courses[k].float_average;
-                    break;
-                }
-            }
+/*!
+* \fn void sort_students_by_average(Prom* prom)
+* \brief Ranks students by descending average
+* 
+* This function stores in prom->tab_ranking the positions of the students
+* by descending average. The student array stays in place, so the positions
+* kept by the index and the grade store remain valid.
+* 
+* \param prom Pointer to the Prom structure containing students
+*/
+void sort_students_by_average(Prom* prom) {
+    if (prom == NULL) {
+        return;
+    }
+    
+    int* ranking = rank_students_by_average(prom);
+    if (ranking == NULL && prom->int_nb_students > 0) {
+        return;
+    }
+    
+    free(prom->tab_ranking);
+    prom->tab_ranking = ranking;
+}
 
-            /* Compare averages */
-            if (avg_j > avg_max) {
-                max_idx = j;
-                avg_max = avg_j;
-            }
-        }
+/*!
+* \fn void clear_student_ranking(Prom* prom)
+* \brief Forgets the ranking of the students once it no longer matches them
+* \param prom Pointer to the Prom structure containing students
+*/
+void clear_student_ranking(Prom* prom) {
+    free(prom->tab_ranking);
+    prom->tab_ranking = NULL;
+}
+
+/*!
+* \fn static void free_course_ranking(CourseRanking* ranking)
+* \brief Frees the arrays and the structure of a course ranking
+* \param ranking Pointer to the CourseRanking structure to free
+*/
+static void free_course_ranking(CourseRanking* ranking) {
+    free(ranking->tab_positions);
+    free(ranking->tab_course_offsets);
+    free(ranking->tab_ranks);
+    free(ranking);
+}
 
-        /* Swap if necessary */
-        if (max_idx != i) {
-            Student temp = students_copy[i];
-            students_copy[i] = students_copy[max_idx];
-            students_copy[max_idx] = temp;  
+/*!
+* \fn int build_course_ranking(Prom* prom)
+* \brief Ranks the students of each course by descending course average
+* 
+* This function sorts once, course by course, the students following the
+* course (ties broken by identifier), and records the rank of every student
+* in every course. It is called after the averages are computed.
+* 
+* \param prom Pointer to the Prom structure containing students
+* \return 0 on success, -1 on allocation error
+*/
+int build_course_ranking(Prom* prom) {
+    clear_course_ranking(prom);
+    
+    int nb_courses = prom->catalog.int_nb_courses;
+    int n = prom->int_nb_students;
+    
+    /* Count the students of each course */
+    int total = 0;
+    for (int i = 0; i < n; i++) {
+        total += prom->student_students[i].int_nb_courses;
+    }
+    
+    CourseRanking* ranking = calloc(1, sizeof(CourseRanking));
+    if (ranking == NULL) {
+        return (-1);
+    }
+    ranking->int_nb_courses = nb_courses;
+    ranking->int_nb_students = n;
+    ranking->tab_positions = malloc((total > 0 ? total : 1) * sizeof(int));
+    ranking->tab_course_offsets = calloc(nb_courses + 1, sizeof(int));
+    ranking->tab_ranks = malloc(((size_t)n * nb_courses > 0 ? (size_t)n * nb_courses : 1) * sizeof(int));
+    int* cursors = malloc((nb_courses > 0 ? nb_courses : 1) * sizeof(int));
+    RankKey* keys = malloc((total > 0 ? total : 1) * sizeof(RankKey));
+    RankKey* buffer = malloc((total > 0 ? total : 1) * sizeof(RankKey));
+    if (ranking->tab_positions == NULL || ranking->tab_course_offsets == NULL || ranking->tab_ranks == NULL
+        || cursors == NULL || keys == NULL || buffer == NULL) {
+        free_course_ranking(ranking);
+        free(cursors);
+        free(keys);
+        free(buffer);
+        return (-1);
+    }
+    
+    /* The courses of a lazily loaded promotion are paged in on each pass */
+    int paged = 1;
+    for (int i = 0; i < n && paged; i++) {
+        const Student* student = &prom->student_students[i];
+        paged = (page_student_courses(prom, i) == 0);
+        for (int j = 0; paged && j < student->int_nb_courses; j++) {
+            ranking->tab_course_offsets[student->course_courses[j].int_course_id + 1]++;
         }
     }
+    for (int c = 0; c < nb_courses; c++) {
+        ranking->tab_course_offsets[c + 1] += ranking->tab_course_offsets[c];
+        cursors[c] = ranking->tab_course_offsets[c];
+    }
     
-    printf("\n===============================================\n");
-    printf("          TOP 3 STUDENTS IN %s         \n", course_name);
-    printf("===============================================\n");
+    /* Gather the keys of each course in its own range */
+    for (int i = 0; i < n && paged; i++) {
+        const Student* student = &prom->student_students[i];
+        paged = (page_student_courses(prom, i) == 0);
+        for (int j = 0; paged && j < student->int_nb_courses; j++) {
+            RankKey* key = &keys[cursors[student->course_courses[j].int_course_id]++];
+            key->float_average = student->course_courses[j].float_average;
+            key->int_id = student->int_id;
+            key->int_position = i;
+        }
+    }
+    if (!paged) {
+        free_course_ranking(ranking);
+        free(cursors);
+        free(keys);
+        free(buffer);
+        return (-1);
+    }
     
-    for (int i = 0; i < 3; i++) {
-        printf("\n[Top Student %d/%d]\n", i + 1, 3);
-        printf("Grade in %s: ", course_name);
-        /* Search for the subject in the student's courses */
-        for (int k = 0; k < students_copy[i].int_nb_courses; k++) {
-            if (strcmp(students_copy[i].course_courses[k].char_course_name, course_name) == 0) {
-                printf("%.2f\n", students_copy[i].course_courses[k].float_average);
-                break;
-            }
+    /* Sort each course and record the ranks */
+    for (size_t i = 0; i < (size_t)n * nb_courses; i++) {
+        ranking->tab_ranks[i] = -1;
+    }
+    for (int c = 0; c < nb_courses; c++) {
+        int begin = ranking->tab_course_offsets[c];
+        int count = ranking->tab_course_offsets[c + 1] - begin;
+        RankKey* sorted = sort_rank_keys(keys + begin, buffer + begin, count);
+        
+        for (int r = 0; r < count; r++) {
+            ranking->tab_positions[begin + r] = sorted[r].int_position;
+            ranking->tab_ranks[(size_t)sorted[r].int_position * nb_courses + c] = r;
         }
-        show_student_info(students_copy[i]);
     }
+    
+    free(cursors);
+    free(keys);
+    free(buffer);
+    prom->ranking_courses = ranking;
+    return (0);
+}
 
-    free(students_copy);
+/*!
+* \fn void clear_course_ranking(Prom* prom)
+* \brief Forgets the course ranking once it no longer matches the students
+* \param prom Pointer to the Prom structure containing students
+*/
+void clear_course_ranking(Prom* prom) {
+    if (prom->ranking_courses != NULL) {
+        free_course_ranking(prom->ranking_courses);
+        prom->ranking_courses = NULL;
+    }
+}
+
+/*!
+* \fn int get_course_top(const Prom* prom, int course_id, int k, int* positions)
+* \brief Copies the positions of the k best students of a course (O(k))
+* \param prom Pointer to the Prom structure, with a course ranking
+* \param course_id ID of the course in the catalog
+* \param k Number of students wanted
+* \param positions Array of at least k entries receiving the positions, best first
+* \return Number of positions copied (at most k), or -1 if the ranking or the course is missing
+*/
+int get_course_top(const Prom* prom, int course_id, int k, int* positions) {
+    const CourseRanking* ranking = prom->ranking_courses;
+    if (ranking == NULL || course_id < 0 || course_id >= ranking->int_nb_courses) {
+        return (-1);
+    }
+    
+    int begin = ranking->tab_course_offsets[course_id];
+    int count = ranking->tab_course_offsets[course_id + 1] - begin;
+    if (k < count) {
+        count = (k > 0 ? k : 0);
+    }
+    memcpy(positions, ranking->tab_positions + begin, count * sizeof(int));
+    
+    return (count);
+}
+
+/*!
+* \fn int get_course_rank(const Prom* prom, int course_id, int position)
+* \brief Returns the rank of a student in a course (O(1))
+* \param prom Pointer to the Prom structure, with a course ranking
+* \param course_id ID of the course in the catalog
+* \param position Position of the student in the promotion
+* \return Rank of the student (0 for the best), or -1 if the student does not follow the course
+*         or if the ranking is missing
+*/
+int get_course_rank(const Prom* prom, int course_id, int position) {
+    const CourseRanking* ranking = prom->ranking_courses;
+    if (ranking == NULL || course_id < 0 || course_id >= ranking->int_nb_courses
+        || position < 0 || position >= ranking->int_nb_students) {
+        return (-1);
+    }
+    
+    return (ranking->tab_ranks[(size_t)position * ranking->int_nb_courses + course_id]);
+}
+
+/*!
+* \fn int sort_students_from_course(Prom* prom, const char* course_name, int k, int* positions)
+* \brief Returns the k best students in a specific course
+* 
+* This function looks the course up in the catalog, builds the course
+* ranking if it is missing, and copies the positions of the k best
+* students of the course, best first.
+* 
+* \param prom Pointer to the Prom structure containing students
+* \param course_name Name of the course
+* \param k Number of students wanted
+* \param positions Array of at least k entries receiving the positions
+* \return Number of positions copied (at most k), or -1 on invalid parameters,
+*         unknown course or allocation error
+*/
+int sort_students_from_course(Prom* prom, const char* course_name, int k, int* positions) {
+    if (prom == NULL || course_name == NULL || positions == NULL) {
+        return (-1);
+    }
+    
+    /* Resolve the course name once */
+    int course_id = find_course_id(&prom->catalog, course_name, strlen(course_name));
+    if (course_id < 0) {
+        return (-1);
+    }
+    
+    /* Rank all the courses once, the following calls are O(k) */
+    if (prom->ranking_courses == NULL && build_course_ranking(prom) != 0) {
+        return (-1);
+    }
+    
+    return (get_course_top(prom, course_id, k, positions));
 }
@@ -0,0 +1,171 @@
+/*!
+ * \file spscQueue.c
+ * \author Akhatar Abdelhamid <abdelhamid.akhatar@etu.cyu.fr>
+ * \version 1.0
+ * \date November 2, 2025
+ * \brief Single-producer single-consumer queue module
+ * 
+ * This file contains the implementation of the queue: a ring of slots
+ * with a head advanced only by the consumer and a tail advanced only by
+ * the producer. Each side publishes its index with a release store and
+ * reads the other one with an acquire load, so no lock is needed.
+ */
+
+#include "spscQueue.h"
+#include <sched.h>
+#include <stdatomic.h>
+#include <stdlib.h>
+
+/*!
+ * \struct SpscQueue
+ * \brief Single-producer single-consumer queue structure
+ */
+struct SpscQueue
+{
+    _Alignas(64) atomic_size_t size_head; /*!< Next slot to pop, written by the consumer (own cache line) */
+    _Alignas(64) atomic_size_t size_tail; /*!< Next slot to push, written by the producer (own cache line) */
+    _Alignas(64) size_t size_mask;        /*!< Number of slots minus one (power of two) */
+    void** ptr_slots;                     /*!< Ring of slots */
+};
+
+/*!
+ * \fn SpscQueue* create_spsc_queue(int int_capacity)
+ * \brief Creates an empty queue
+ * \param int_capacity Minimum number of items the queue holds
+ * \return Pointer to the queue, or NULL on allocation error
+ */
+SpscQueue* create_spsc_queue(int int_capacity)
+{
+    SpscQueue* queue;
+    size_t size_slots;
+    
+    size_slots = 1;
+    while (size_slots < (size_t)int_capacity)
+    {
+        size_slots *= 2;
+    }
+    
+    queue = (SpscQueue*)aligned_alloc(64, sizeof(SpscQueue));
+    if (queue == NULL)
+    {
+        return (NULL);
+    }
+    queue->ptr_slots = (void**)malloc(size_slots * sizeof(void*));
+    if (queue->ptr_slots == NULL)
+    {
+        free(queue);
+        return (NULL);
+    }
+    queue->size_mask = size_slots - 1;
+    atomic_init(&queue->size_head, 0);
+    atomic_init(&queue->size_tail, 0);
+    
+    return (queue);
+}
+
+/*!
+ * \fn void destroy_spsc_queue(SpscQueue* queue)
+ * \brief Frees a queue
+ * \param queue Pointer to the queue (may be NULL)
+ */
+void destroy_spsc_queue(SpscQueue* queue)
+{
+    if (queue != NULL)
+    {
+        free(queue->ptr_slots);
+        free(queue);
+    }
+}
+
+/*!
+ * \fn int try_push_spsc_queue(SpscQueue* queue, void* item)
+ * \brief Adds an item to a queue if it is not full
+ * \param queue Pointer to the queue
+ * \param item Item to add
+ * \return 1 if the item was added, 0 if the queue is full
+ */
+int try_push_spsc_queue(SpscQueue* queue, void* item)
+{
+    size_t tail;
+    
+    tail = atomic_load_explicit(&queue->size_tail, memory_order_relaxed);
+    if (tail - atomic_load_explicit(&queue->size_head, memory_order_acquire) > queue->size_mask)
+    {
+        return (0);
+    }
+    
+    /* The slot is written before the new tail makes it visible */
+    queue->ptr_slots[tail & queue->size_mask] = item;
+    atomic_store_explicit(&queue->size_tail, tail + 1, memory_order_release);
+    
+    return (1);
+}
+
+/*!
+ * \fn int try_pop_spsc_queue(SpscQueue* queue, void** item)
+ * \brief Removes the oldest item of a queue if it is not empty
+ * \param queue Pointer to the queue
+ * \param item Pointer receiving the item
+ * \return 1 if an item was removed, 0 if the queue is empty
+ */
+int try_pop_spsc_queue(SpscQueue* queue, void** item)
+{
+    size_t head;
+    
+    head = atomic_load_explicit(&queue->size_head, memory_order_relaxed);
+    if (head == atomic_load_explicit(&queue->size_tail, memory_order_acquire))
+    {
+        return (0);
+    }
+    
+    /* The slot is read before the new head hands it back to the producer */
+    *item = queue->ptr_slots[head & queue->size_mask];
+    atomic_store_explicit(&queue->size_head, head + 1, memory_order_release);
+    
+    return (1);
+}
+
+/*!
+ * \fn void push_spsc_queue(SpscQueue* queue, void* item)
+ * \brief Adds an item to a queue, waiting while it is full
+ * \param queue Pointer to the queue
+ * \param item Item to add
+ */
+void push_spsc_queue(SpscQueue* queue, void* item)
+{
+    int spin;
+    
+    spin = 0;
+    while (!try_push_spsc_queue(queue, item))
+    {
+        if (++spin >= SPSC_SPIN_COUNT)
+        {
+            sched_yield();
+            spin = 0;
+        }
+    }
+}
+
+/*!
+ * \fn void* pop_spsc_queue(SpscQueue* queue)
+ * \brief Removes the oldest item of a queue, waiting while it is empty
+ * \param queue Pointer to the queue
+ * \return The item
+ */
+void* pop_spsc_queue(SpscQueue* queue)
+{
+    void* item;
+    int spin;
+    
+    spin = 0;
+    while (!try_pop_spsc_queue(queue, &item))
+    {
+        if (++spin >= SPSC_SPIN_COUNT)
+        {
+            sched_yield();
+            spin = 0;
+        }
+    }
+    
+    return (item);
+}
@@ -0,0 +1,349 @@
+/*!
+ * \file studentIndex.c
+ * \author Akhatar Abdelhamid <abdelhamid.akhatar@etu.cyu.fr>
+ * \version 1.0
+ * \date November 2, 2025
+ * \brief Student index module
+ * 
+ * This file contains the implementation of the hash index (open addressing
+ * with linear probing) from a student identifier to its position in the cohort.
+ */
+
+#include "studentIndex.h"
+#include "gradeStore.h"
+#include "sorting.h"
+#include "lazyLoad.h"
+#include "init.h"
+
+/*!
+ * \fn static int hash_student_id(int int_id, int int_capacity)
+ * \brief Computes the home slot of an identifier
+ * \param int_id Identifier of the student
+ * \param int_capacity Number of slots (power of two)
+ * \return Slot number in [0, int_capacity[
+ */
+static int hash_student_id(int int_id, int int_capacity)
+{
+    unsigned int h;
+    
+    /* Mix the bits so that close identifiers are spread over the table */
+    h = (unsigned int)int_id;
+    h ^= h >> 16;
+    h *= 0x45d9f3bu;
+    h ^= h >> 16;
+    
+    return ((int)(h & (unsigned int)(int_capacity - 1)));
+}
+
+/*!
+ * \fn static int find_slot(const StudentIndex* index, int int_id)
+ * \brief Finds the slot holding an identifier
+ * \param index Pointer to the StudentIndex structure
+ * \param int_id Identifier of the student
+ * \return Slot number, or -1 if the identifier is not indexed
+ */
+static int find_slot(const StudentIndex* index, int int_id)
+{
+    int mask;
+    int i;
+    
+    if (index->int_capacity == 0)
+    {
+        return (-1);
+    }
+    
+    mask = index->int_capacity - 1;
+    i = hash_student_id(int_id, index->int_capacity);
+    
+    /* Linear probing until the identifier or an empty slot */
+    while (index->slot_slots[i].int_position >= 0)
+    {
+        if (index->slot_slots[i].int_id == int_id)
+        {
+            return (i);
+        }
+        i = (i + 1) & mask;
+    }
+    
+    return (-1);
+}
+
+/*!
+ * \fn static int insert_slot(StudentIndex* index, int int_id, int int_position)
+ * \brief Inserts an identifier in the index (the table must have a free slot)
+ * \param index Pointer to the StudentIndex structure
+ * \param int_id Identifier of the student
+ * \param int_position Position of the student in the array
+ * \return 1 if inserted, 0 if the identifier was already indexed
+ */
+static int insert_slot(StudentIndex* index, int int_id, int int_position)
+{
+    int mask;
+    int i;
+    
+    mask = index->int_capacity - 1;
+    i = hash_student_id(int_id, index->int_capacity);
+    
+    while (index->slot_slots[i].int_position >= 0)
+    {
+        if (index->slot_slots[i].int_id == int_id)
+        {
+            return (0);
+        }
+        i = (i + 1) & mask;
+    }
+    
+    index->slot_slots[i].int_id = int_id;
+    index->slot_slots[i].int_position = int_position;
+    index->int_nb_entries++;
+    
+    return (1);
+}
+
+/*!
+ * \fn static void remove_slot(StudentIndex* index, int i)
+ * \brief Empties a slot and shifts back the following entries of its cluster
+ * \param index Pointer to the StudentIndex structure
+ * \param i Slot to empty
+ */
+static void remove_slot(StudentIndex* index, int i)
+{
+    int mask;
+    int j;
+    int home;
+    
+    mask = index->int_capacity - 1;
+    index->slot_slots[i].int_position = -1;
+    index->int_nb_entries--;
+    
+    /* Move back entries whose probe sequence went through the emptied slot */
+    j = i;
+    while (1)
+    {
+        j = (j + 1) & mask;
+        if (index->slot_slots[j].int_position < 0)
+        {
+            break;
+        }
+        
+        home = hash_student_id(index->slot_slots[j].int_id, index->int_capacity);
+        if ((j > i && (home <= i || home > j)) || (j < i && home <= i && home > j))
+        {
+            index->slot_slots[i] = index->slot_slots[j];
+            index->slot_slots[j].int_position = -1;
+            i = j;
+        }
+    }
+}
+
+/*!
+ * \fn static int reserve_index(StudentIndex* index, int int_nb_entries)
+ * \brief Grows the table so that it stays at most half full
+ * \param index Pointer to the StudentIndex structure
+ * \param int_nb_entries Number of entries the table must hold
+ * \return 0 on success, -1 on allocation error
+ */
+static int reserve_index(StudentIndex* index, int int_nb_entries)
+{
+    StudentSlot* old_slots;
+    int old_capacity;
+    int capacity;
+    int i;
+    
+    capacity = (index->int_capacity > 0 ? index->int_capacity : 16);
+    while (capacity < 2 * int_nb_entries)
+    {
+        capacity *= 2;
+    }
+    if (capacity == index->int_capacity)
+    {
+        return (0);
+    }
+    
+    old_slots = index->slot_slots;
+    old_capacity = index->int_capacity;
+    
+    /* Allocate the new table with all slots empty */
+    index->slot_slots = (StudentSlot*)malloc(capacity * sizeof(StudentSlot));
+    if (index->slot_slots == NULL)
+    {
+        index->slot_slots = old_slots;
+        return (-1);
+    }
+    for (i = 0; i < capacity; i++)
+    {
+        index->slot_slots[i].int_position = -1;
+    }
+    index->int_capacity = capacity;
+    index->int_nb_entries = 0;
+    
+    /* Reinsert the previous entries */
+    for (i = 0; i < old_capacity; i++)
+    {
+        if (old_slots[i].int_position >= 0)
+        {
+            insert_slot(index, old_slots[i].int_id, old_slots[i].int_position);
+        }
+    }
+    free(old_slots);
+    
+    return (0);
+}
+
+/*!
+ * \fn int build_student_index(Prom* prom)
+ * \brief Builds (or rebuilds) the index of all students of a cohort
+ * \param prom Pointer to the Prom structure to index
+ * \return 0 on success, -1 on allocation error
+ */
+int build_student_index(Prom* prom)
+{
+    int i;
+    
+    /* Start from an empty table large enough for all students */
+    destroy_student_index(&prom->index);
+    if (reserve_index(&prom->index, prom->int_nb_students) != 0)
+    {
+        return (-1);
+    }
+    
+    /* Index every student, keeping the first of duplicated identifiers */
+    for (i = 0; i < prom->int_nb_students; i++)
+    {
+        insert_slot(&prom->index, prom->student_students[i].int_id, i);
+    }
+    
+    return (0);
+}
+
+/*!
+ * \fn void destroy_student_index(StudentIndex* index)
+ * \brief Frees the memory allocated for a student index
+ * \param index Pointer to the StudentIndex structure to destroy
+ */
+void destroy_student_index(StudentIndex* index)
+{
+    free(index->slot_slots);
+    index->slot_slots = NULL;
+    index->int_capacity = 0;
+    index->int_nb_entries = 0;
+}
+
+/*!
+ * \fn int find_student_position(const Prom* prom, int int_id)
+ * \brief Finds the position of a student in the cohort
+ * \param prom Pointer to the indexed Prom structure
+ * \param int_id Identifier of the student
+ * \return Position in prom->student_students, or -1 if the identifier is unknown
+ */
+int find_student_position(const Prom* prom, int int_id)
+{
+    int i;
+    
+    i = find_slot(&prom->index, int_id);
+    
+    return (i >= 0 ? prom->index.slot_slots[i].int_position : -1);
+}
+
+/*!
+ * \fn Student* find_student_by_id(const Prom* prom, int int_id)
+ * \brief Finds a student of the cohort by identifier
+ * \param prom Pointer to the indexed Prom structure
+ * \param int_id Identifier of the student
+ * \return Pointer to the student, or NULL if the identifier is unknown
+ */
+Student* find_student_by_id(const Prom* prom, int int_id)
+{
+    int position;
+    
+    position = find_student_position(prom, int_id);
+    
+    return (position >= 0 ? &prom->student_students[position] : NULL);
+}
+
+/*!
+ * \fn int add_student_to_prom(Prom* prom, Student student)
+ * \brief Appends a student to the cohort and indexes it
+ * \param prom Pointer to the Prom structure
+ * \param student Student to add
+ * \return 0 on success, -1 if the identifier already exists or on allocation error
+ */
+int add_student_to_prom(Prom* prom, Student student)
+{
+    /* Only a fully loaded promotion can grow */
+    if (materialize_prom(prom) != 0)
+    {
+        return (-1);
+    }
+    
+    /* Refuse duplicated identifiers */
+    if (find_slot(&prom->index, student.int_id) >= 0)
+    {
+        return (-1);
+    }
+    if (reserve_index(&prom->index, prom->index.int_nb_entries + 1) != 0)
+    {
+        return (-1);
+    }
+    
+    /* Add the student to the array, doubling it when full */
+    if (push_prom_student(prom, student) != 0)
+    {
+        return (-1);
+    }
+    
+    /* Add it to the index (the ranking misses it) */
+    clear_student_ranking(prom);
+    clear_course_ranking(prom);
+    insert_slot(&prom->index, student.int_id, prom->int_nb_students - 1);
+    
+    return (0);
+}
+
+/*!
+ * \fn int remove_student_from_prom(Prom* prom, int int_id)
+ * \brief Destroys a student of the cohort and removes it from the index
+ * \param prom Pointer to the Prom structure
+ * \param int_id Identifier of the student to remove
+ * \return 0 on success, -1 if the identifier is unknown
+ */
+int remove_student_from_prom(Prom* prom, int int_id)
+{
+    int slot;
+    int position;
+    int last;
+    
+    slot = find_slot(&prom->index, int_id);
+    if (slot < 0)
+    {
+        return (-1);
+    }
+    position = prom->index.slot_slots[slot].int_position;
+    
+    /* Students move: the columnar store cannot follow */
+    if (release_grade_store(prom) != 0)
+    {
+        return (-1);
+    }
+    
+    /* Remove the identifier from the index and the rankings, and destroy the student */
+    remove_slot(&prom->index, slot);
+    clear_student_ranking(prom);
+    clear_course_ranking(prom);
+    destroy_student_in(prom->arena_memory, &prom->student_students[position]);
+    
+    /* Move the last student into the hole and update its position */
+    last = prom->int_nb_students - 1;
+    if (position != last)
+    {
+        prom->student_students[position] = prom->student_students[last];
+        slot = find_slot(&prom->index, prom->student_students[position].int_id);
+        if (slot >= 0 && prom->index.slot_slots[slot].int_position == last)
+        {
+            prom->index.slot_slots[slot].int_position = position;
+        }
+    }
+    prom->int_nb_students--;
+    
+    return (0);
+}
@@ -0,0 +1,296 @@
+/*!
+ * \file threadPool.c
+ * \author Akhatar Abdelhamid <abdelhamid.akhatar@etu.cyu.fr>
+ * \version 1.0
+ * \date November 2, 2025
+ * \brief Thread pool module
+ * 
+ * This file contains the implementation of the thread pool: the range of
+ * items is split in one part per thread, and each part has an atomic cursor
+ * from which its owner (or a thief, once its own part is done) claims chunks.
+ */
+
+#include "threadPool.h"
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+/*!
+ * \struct WorkRange
+ * \brief Part of the range of items owned by one thread
+ */
+typedef struct
+{
+    _Alignas(64) atomic_int int_next; /*!< Next item to claim (own cache line) */
+    int int_end;                      /*!< End of the part */
+} WorkRange;
+
+/*!
+ * \struct WorkerArgs
+ * \brief Arguments of a worker thread
+ */
+typedef struct
+{
+    ThreadPool* pool;         /*!< Pool of the worker */
+    int int_worker;           /*!< Number of the worker (0 is the calling thread) */
+} WorkerArgs;
+
+/*!
+ * \struct ThreadPool
+ * \brief Thread pool structure
+ */
+struct ThreadPool
+{
+    int int_nb_threads;       /*!< Number of workers, the calling thread included */
+    pthread_t* threads;       /*!< Worker threads (int_nb_threads - 1) */
+    WorkerArgs* args;         /*!< Arguments of the worker threads */
+    WorkRange* ranges;        /*!< Part of the range of each worker */
+    pthread_mutex_t mutex;    /*!< Protects the fields below */
+    pthread_cond_t cond_start;/*!< Signals a new task or the stop */
+    pthread_cond_t cond_done; /*!< Signals the end of the work of a thread */
+    unsigned int int_generation; /*!< Incremented for each task */
+    int int_nb_running;       /*!< Number of worker threads still working on the task */
+    int int_stop;             /*!< 1 when the threads must exit */
+    ThreadTask task;          /*!< Current task */
+    void* context;            /*!< Context of the current task */
+    int int_chunk;            /*!< Chunk size of the current task */
+};
+
+/*!
+ * \fn static void work_on_ranges(ThreadPool* pool, int int_worker)
+ * \brief Processes the chunks of a worker's part, then steals from the other parts
+ * \param pool Pointer to the pool
+ * \param int_worker Number of the worker
+ */
+static void work_on_ranges(ThreadPool* pool, int int_worker)
+{
+    WorkRange* range;
+    int begin;
+    int end;
+    int i;
+    
+    for (i = 0; i < pool->int_nb_threads; i++)
+    {
+        /* Own part first, then the next parts in turn */
+        range = &pool->ranges[(int_worker + i) % pool->int_nb_threads];
+        
+        while ((begin = atomic_fetch_add(&range->int_next, pool->int_chunk)) < range->int_end)
+        {
+            end = begin + pool->int_chunk;
+            if (end > range->int_end)
+            {
+                end = range->int_end;
+            }
+            pool->task(pool->context, begin, end);
+        }
+    }
+}
+
+/*!
+ * \fn static void* worker_main(void* arg)
+ * \brief Main function of a worker thread
+ * \param arg Pointer to the WorkerArgs of the thread
+ * \return NULL
+ */
+static void* worker_main(void* arg)
+{
+    WorkerArgs* args;
+    ThreadPool* pool;
+    unsigned int generation;
+    
+    args = (WorkerArgs*)arg;
+    pool = args->pool;
+    generation = 0;
+    
+    while (1)
+    {
+        /* Wait for a new task */
+        pthread_mutex_lock(&pool->mutex);
+        while (!pool->int_stop && pool->int_generation == generation)
+        {
+            pthread_cond_wait(&pool->cond_start, &pool->mutex);
+        }
+        if (pool->int_stop)
+        {
+            pthread_mutex_unlock(&pool->mutex);
+            break;
+        }
+        generation = pool->int_generation;
+        pthread_mutex_unlock(&pool->mutex);
+        
+        work_on_ranges(pool, args->int_worker);
+        
+        /* Report the end of the work */
+        pthread_mutex_lock(&pool->mutex);
+        pool->int_nb_running--;
+        if (pool->int_nb_running == 0)
+        {
+            pthread_cond_signal(&pool->cond_done);
+        }
+        pthread_mutex_unlock(&pool->mutex);
+    }
+    
+    return (NULL);
+}
+
+/*!
+ * \fn ThreadPool* create_thread_pool(int int_nb_threads)
+ * \brief Creates a pool of threads
+ * \param int_nb_threads Number of threads, the calling thread included
+ * \return Pointer to the pool, or NULL on error
+ */
+ThreadPool* create_thread_pool(int int_nb_threads)
+{
+    ThreadPool* pool;
+    int i;
+    
+    if (int_nb_threads <= 0)
+    {
+        int_nb_threads = (int)sysconf(_SC_NPROCESSORS_ONLN);
+        if (int_nb_threads <= 0)
+        {
+            int_nb_threads = 1;
+        }
+    }
+    
+    pool = (ThreadPool*)calloc(1, sizeof(ThreadPool));
+    if (pool == NULL)
+    {
+        return (NULL);
+    }
+    pool->int_nb_threads = int_nb_threads;
+    pool->threads = (pthread_t*)malloc(int_nb_threads * sizeof(pthread_t));
+    pool->args = (WorkerArgs*)malloc(int_nb_threads * sizeof(WorkerArgs));
+    pool->ranges = (WorkRange*)aligned_alloc(64, int_nb_threads * sizeof(WorkRange));
+    if (pool->threads == NULL || pool->args == NULL || pool->ranges == NULL)
+    {
+        free(pool->threads);
+        free(pool->args);
+        free(pool->ranges);
+        free(pool);
+        return (NULL);
+    }
+    pthread_mutex_init(&pool->mutex, NULL);
+    pthread_cond_init(&pool->cond_start, NULL);
+    pthread_cond_init(&pool->cond_done, NULL);
+    
+    /* Start the worker threads (worker 0 is the calling thread) */
+    for (i = 1; i < int_nb_threads; i++)
+    {
+        pool->args[i].pool = pool;
+        pool->args[i].int_worker = i;
+        if (pthread_create(&pool->threads[i], NULL, worker_main, &pool->args[i]) != 0)
+        {
+            /* Run with the threads already started */
+            pool->int_nb_threads = i;
+            break;
+        }
+    }
+    
+    return (pool);
+}
+
+/*!
+ * \fn void destroy_thread_pool(ThreadPool* pool)
+ * \brief Stops the threads and frees the pool
+ * \param pool Pointer to the pool
+ */
+void destroy_thread_pool(ThreadPool* pool)
+{
+    int i;
+    
+    if (pool == NULL)
+    {
+        return;
+    }
+    
+    /* Wake up the threads so that they exit */
+    pthread_mutex_lock(&pool->mutex);
+    pool->int_stop = 1;
+    pthread_cond_broadcast(&pool->cond_start);
+    pthread_mutex_unlock(&pool->mutex);
+    
+    for (i = 1; i < pool->int_nb_threads; i++)
+    {
+        pthread_join(pool->threads[i], NULL);
+    }
+    
+    pthread_mutex_destroy(&pool->mutex);
+    pthread_cond_destroy(&pool->cond_start);
+    pthread_cond_destroy(&pool->cond_done);
+    free(pool->threads);
+    free(pool->args);
+    free(pool->ranges);
+    free(pool);
+}
+
+/*!
+ * \fn int get_thread_pool_size(const ThreadPool* pool)
+ * \brief Returns the number of threads working on a task
+ * \param pool Pointer to the pool
+ * \return Number of threads
+ */
+int get_thread_pool_size(const ThreadPool* pool)
+{
+    return (pool->int_nb_threads);
+}
+
+/*!
+ * \fn void run_thread_pool(ThreadPool* pool, int int_nb_items, int int_chunk, ThreadTask task, void* context)
+ * \brief Runs a task over a range of items and waits for its completion
+ * \param pool Pointer to the pool
+ * \param int_nb_items Number of items
+ * \param int_chunk Number of items per call of the task
+ * \param task Function processing a chunk of items
+ * \param context Pointer passed to the task
+ */
+void run_thread_pool(ThreadPool* pool, int int_nb_items, int int_chunk, ThreadTask task, void* context)
+{
+    int nb_threads;
+    int i;
+    
+    if (int_nb_items <= 0)
+    {
+        return;
+    }
+    nb_threads = pool->int_nb_threads;
+    
+    /* Small chunks so that idle threads have something to steal */
+    if (int_chunk <= 0)
+    {
+        int_chunk = int_nb_items / (nb_threads * 16);
+        if (int_chunk < 1)
+        {
+            int_chunk = 1;
+        }
+    }
+    
+    /* Split the range in one part per thread */
+    for (i = 0; i < nb_threads; i++)
+    {
+        atomic_store(&pool->ranges[i].int_next, (int)((long)int_nb_items * i / nb_threads));
+        pool->ranges[i].int_end = (int)((long)int_nb_items * (i + 1) / nb_threads);
+    }
+    
+    /* Publish the task and wake up the threads */
+    pthread_mutex_lock(&pool->mutex);
+    pool->task = task;
+    pool->context = context;
+    pool->int_chunk = int_chunk;
+    pool->int_nb_running = nb_threads - 1;
+    pool->int_generation++;
+    pthread_cond_broadcast(&pool->cond_start);
+    pthread_mutex_unlock(&pool->mutex);
+    
+    /* The calling thread works too */
+    work_on_ranges(pool, 0);
+    
+    /* Wait for the other threads */
+    pthread_mutex_lock(&pool->mutex);
+    while (pool->int_nb_running > 0)
+    {
+        pthread_cond_wait(&pool->cond_done, &pool->mutex);
+    }
+    pthread_mutex_unlock(&pool->mutex);
+}
@@ -11,29 +11,83 @@
 
 #include "update.h"
 #include "init.h"
+#include "gradeStore.h"
+#include "kernels.h"
+#include "sorting.h"
+#include "lazyLoad.h"
+
+/*! \brief Number of courses gathered at once for the weighted average kernel */
+#define UPDATE_BATCH_COURSES 32
+
+/*! \brief Number of students per chunk of a parallel update (small enough to be stolen) */
+#define UPDATE_CHUNK_STUDENTS 256
 
 /*!
- * \fn void update_course_average(Prom* prom)
- * \brief Updates the averages of all courses for all students
+ * \struct UpdateContext
+ * \brief Context shared by the chunks of a parallel update
+ */
+typedef struct
+{
+    Prom* prom;               /*!< Promotion being updated */
+} UpdateContext;
+
+/*!
+ * \fn static void update_course_average_from_store(Prom* prom, int int_begin, int int_end)
+ * \brief Updates the averages of the courses of a range of students with a linear scan of the columnar store
+ * \param prom Pointer to the Prom structure whose grades are in a GradeStore
+ * \param int_begin First student of the range
+ * \param int_end End of the range (excluded)
+ */
+static void update_course_average_from_store(Prom* prom, int int_begin, int int_end)
+{
+    const GradeStore* store;
+    const float* grades;
+    Student* student;
+    int nb_grades;
+    int slot;
+    int i;
+    int j;
+    
+    store = prom->store_grades;
+    
+    /* Course slots are stored student by student, in course order */
+    for (i = int_begin; i < int_end; i++)
+    {
+        student = &prom->student_students[i];
+        for (j = 0; j < student->int_nb_courses; j++)
+        {
+            slot = get_store_slot(store, i, j);
+            grades = get_store_grades(store, slot, &nb_grades);
+            
+            /* No grades: set average to 0 */
+            student->course_courses[j].float_average = (nb_grades > 0 ? sum_floats(grades, nb_grades) / nb_grades : 0.0f);
+        }
+    }
+}
+
+/*!
+ * \fn static void update_course_average_range(Prom* prom, int int_begin, int int_end)
+ * \brief Updates the averages of the courses of a range of students
  * \param prom Pointer to the Prom structure containing all students
+ * \param int_begin First student of the range
+ * \param int_end End of the range (excluded)
  */
-void update_course_average(Prom* prom) 
+static void update_course_average_range(Prom* prom, int int_begin, int int_end)
 {
     int i;
     int j;
-    int k;
     Student* student;
     Course* course;
-    float sum_grades;
     
-    /* Check input parameters */
-    if (prom == NULL || prom->student_students == NULL || prom->int_nb_students <= 0) 
+    /* Contiguous grades: scan the columnar store */
+    if (prom->store_grades != NULL)
     {
+        update_course_average_from_store(prom, int_begin, int_end);
         return;
     }
     
-    /* Loop through all students in the promotion */
-    for (i = 0; i < prom->int_nb_students; i++) 
+    /* Loop through the students of the range */
+    for (i = int_begin; i < int_end; i++) 
     {
         student = &prom->student_students[i];
         
@@ -46,18 +100,11 @@ void update_course_average(Prom* prom)
                 course = &student->course_courses[j];
                 
                 /* Check that the course contains grades */
-                if (course->grades.tab_grades != NULL && course->grades.int_nb_grades > 0) 
+                if (course->grades.int_nb_grades > 0) 
                 {
-                    sum_grades = 0.0f;
-                    
-                    /* Calculate the sum of all grades */
-                    for (k = 0; k < course->grades.int_nb_grades; k++) 
-                    {
-                        sum_grades += course->grades.tab_grades[k];
-                    }
-                    
-                    /* Calculate the course average */
-                    course->float_average = sum_grades / course->grades.int_nb_grades;
+                    /* Calculate the course average from the vectorized sum */
+                    course->float_average = sum_floats(get_grades_data(&course->grades), course->grades.int_nb_grades)
+                                            / course->grades.int_nb_grades;
                 } 
                 else 
                 {
@@ -69,28 +116,51 @@ void update_course_average(Prom* prom)
     }
 }
 
+/*!
+ * \fn void update_course_average(Prom* prom)
+ * \brief Updates the averages of all courses for all students
+ * \param prom Pointer to the Prom structure containing all students
+ */
+void update_course_average(Prom* prom) 
+{
+    /* Check input parameters */
+    if (prom == NULL || prom->student_students == NULL || prom->int_nb_students <= 0) 
+    {
+        return;
+    }
+    
+    /* Averages are written to the courses: a lazy promotion must load all of them */
+    if (materialize_prom(prom) != 0)
+    {
+        return;
+    }
+    
+    /* The course rankings no longer match the new averages */
+    clear_course_ranking(prom);
+    update_course_average_range(prom, 0, prom->int_nb_students);
+}
 
 /*!
- * \fn void update_student_average(Prom* prom)
- * \brief Updates the overall averages of all students
+ * \fn static void update_student_average_range(Prom* prom, int int_begin, int int_end)
+ * \brief Updates the overall averages of a range of students
  * \param prom Pointer to the Prom structure containing all students
+ * \param int_begin First student of the range
+ * \param int_end End of the range (excluded)
  */
-void update_student_average(Prom* prom)  
+static void update_student_average_range(Prom* prom, int int_begin, int int_end)
 {
     int i;
     int j;
+    int k;
+    int nb;
     Student* student;
     float sum_averages;
     float sum_coefs;
+    float averages[UPDATE_BATCH_COURSES];
+    float coefs[UPDATE_BATCH_COURSES];
     
-    /* Check input parameters */
-    if (prom == NULL || prom->student_students == NULL || prom->int_nb_students <= 0) 
-    {
-        return;
-    }
-    
-    /* Loop through all students in the promotion */
-    for (i = 0; i < prom->int_nb_students; i++) 
+    /* Loop through the students of the range */
+    for (i = int_begin; i < int_end; i++) 
     {
         student = &prom->student_students[i];
         
@@ -100,14 +170,27 @@ void update_student_average(Prom* prom)
             sum_averages = 0.0f;
             sum_coefs = 0.0f;
             
-            /* Calculate the weighted sum of course averages */
-            for (j = 0; j < student->int_nb_courses; j++) 
+            /* Calculate the weighted sum of course averages, batch by batch */
+            for (j = 0; j < student->int_nb_courses; j += nb) 
             {
+                nb = student->int_nb_courses - j;
+                if (nb > UPDATE_BATCH_COURSES)
+                {
+                    nb = UPDATE_BATCH_COURSES;
+                }
+                
+                /* Gather the averages and the coefficients shared by the catalog */
+                for (k = 0; k < nb; k++)
+                {
+                    averages[k] = student->course_courses[j + k].float_average;
+                    coefs[k] = prom->catalog.info_courses[student->course_courses[j + k].int_course_id].float_coef;
+                }
+                
                 /* Sum of averages multiplied by their coefficients */
-                sum_averages += student->course_courses[j].float_average * student->course_courses[j].float_coef;
+                sum_averages += dot_floats(averages, coefs, nb);
                 
                 /* Sum of coefficients */
-                sum_coefs += student->course_courses[j].float_coef;
+                sum_coefs += sum_floats(coefs, nb);
             }
             
             /* Calculate the weighted overall average */
@@ -119,4 +202,83 @@ void update_student_average(Prom* prom)
             student->float_average = 0.0f;
         }
     }
-}
\ No newline at end of file
+}
+
+/*!
+ * \fn void update_student_average(Prom* prom)
+ * \brief Updates the overall averages of all students
+ * \param prom Pointer to the Prom structure containing all students
+ */
+void update_student_average(Prom* prom)  
+{
+    /* Check input parameters */
+    if (prom == NULL || prom->student_students == NULL || prom->int_nb_students <= 0) 
+    {
+        return;
+    }
+    
+    /* Averages are written to the courses: a lazy promotion must load all of them */
+    if (materialize_prom(prom) != 0)
+    {
+        return;
+    }
+    
+    /* The ranking no longer matches the new averages */
+    clear_student_ranking(prom);
+    update_student_average_range(prom, 0, prom->int_nb_students);
+}
+
+/*!
+ * \fn static void update_averages_task(void* context, int int_begin, int int_end)
+ * \brief Updates the course averages, then the overall averages, of a chunk of students
+ * \param context Pointer to the UpdateContext of the update
+ * \param int_begin First student of the chunk
+ * \param int_end End of the chunk (excluded)
+ */
+static void update_averages_task(void* context, int int_begin, int int_end)
+{
+    Prom* prom;
+    
+    prom = ((UpdateContext*)context)->prom;
+    
+    /* Each student only reads its own grades and writes its own averages */
+    update_course_average_range(prom, int_begin, int_end);
+    update_student_average_range(prom, int_begin, int_end);
+}
+
+/*!
+ * \fn void update_averages_parallel(Prom* prom, ThreadPool* pool)
+ * \brief Updates the course and overall averages of all students with a thread pool
+ * \param prom Pointer to the Prom structure containing all students
+ * \param pool Pointer to the thread pool (NULL: serial update)
+ */
+void update_averages_parallel(Prom* prom, ThreadPool* pool)
+{
+    UpdateContext context;
+    
+    /* Check input parameters */
+    if (prom == NULL || prom->student_students == NULL || prom->int_nb_students <= 0) 
+    {
+        return;
+    }
+    
+    /* Averages are written to the courses: a lazy promotion must load all of them */
+    if (materialize_prom(prom) != 0)
+    {
+        return;
+    }
+    
+    /* The rankings no longer match the new averages */
+    clear_student_ranking(prom);
+    clear_course_ranking(prom);
+    
+    if (pool == NULL || get_thread_pool_size(pool) <= 1)
+    {
+        update_course_average_range(prom, 0, prom->int_nb_students);
+        update_student_average_range(prom, 0, prom->int_nb_students);
+        return;
+    }
+    
+    context.prom = prom;
+    run_thread_pool(pool, prom->int_nb_students, UPDATE_CHUNK_STUDENTS, update_averages_task, &context);
+}
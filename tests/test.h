@@ -0,0 +1,53 @@
+/*!
+ * \file test.h
+ * \author Akhatar Abdelhamid <abdelhamid.akhatar@etu.cyu.fr>
+ * \version 1.0
+ * \date November 2, 2025
+ * \brief Minimal checks shared by the test programs
+ * 
+ * Each test program is one file with its own main. CHECK records a failed
+ * condition and goes on, so that one run reports every failure;
+ * end_tests gives the exit status used by make test.
+ */
+
+#ifndef TEST_H
+#define TEST_H
+
+#include <stdio.h>
+
+/*! \brief Number of failed checks of the test program */
+static int int_nb_failures = 0;
+
+/*!
+ * \def CHECK(cond)
+ * \brief Reports the condition with its location when it is false
+ */
+#define CHECK(cond) \
+    do \
+    { \
+        if (!(cond)) \
+        { \
+            printf("%s:%d: check failed: %s\n", __FILE__, __LINE__, #cond); \
+            int_nb_failures++; \
+        } \
+    } while (0)
+
+/*!
+ * \fn static int end_tests(const char* str_name)
+ * \brief Displays the result of a test program
+ * \param str_name Name of the test program
+ * \return Exit status: 0 if every check passed, 1 otherwise
+ */
+static int end_tests(const char* str_name)
+{
+    if (int_nb_failures > 0)
+    {
+        printf("%s: %d check(s) failed\n", str_name, int_nb_failures);
+        return (1);
+    }
+    printf("%s: all checks passed\n", str_name);
+    
+    return (0);
+}
+
+#endif
@@ -0,0 +1,89 @@
+/*!
+ * \file testProm.h
+ * \author Akhatar Abdelhamid <abdelhamid.akhatar@etu.cyu.fr>
+ * \version 1.0
+ * \date November 2, 2025
+ * \brief Comparison of two promotions shared by the test programs
+ */
+
+#ifndef TESTPROM_H
+#define TESTPROM_H
+
+#include "test.h"
+#include "structures.h"
+#include "init.h"
+#include "lazyLoad.h"
+#include <string.h>
+
+/*!
+ * \fn static int same_float(float float_a, float float_b)
+ * \brief Compares two floats bit for bit
+ * \return 1 if they have the same bits
+ */
+static int same_float(float float_a, float float_b)
+{
+    return (memcmp(&float_a, &float_b, sizeof(float)) == 0);
+}
+
+/*!
+ * \fn static int same_prom(const Prom* prom_a, const Prom* prom_b, int int_averages)
+ * \brief Compares two promotions: students, course names and coefficients, grades bit for bit
+ * \param prom_a First promotion
+ * \param prom_b Second promotion
+ * \param int_averages 1 to also compare the student and course averages bit for bit
+ * \return 1 if they hold the same data, 0 otherwise (the first difference is displayed)
+ */
+static int same_prom(const Prom* prom_a, const Prom* prom_b, int int_averages)
+{
+    const Student* student_a;
+    const Student* student_b;
+    const Course* course_a;
+    const Course* course_b;
+    const CourseInfo* info_a;
+    const CourseInfo* info_b;
+    int i;
+    int j;
+    
+    if (prom_a->int_nb_students != prom_b->int_nb_students)
+    {
+        printf("same_prom: %d students instead of %d\n", prom_b->int_nb_students, prom_a->int_nb_students);
+        return (0);
+    }
+    for (i = 0; i < prom_a->int_nb_students; i++)
+    {
+        student_a = &prom_a->student_students[i];
+        student_b = &prom_b->student_students[i];
+        if (page_student_courses(prom_a, i) != 0 || page_student_courses(prom_b, i) != 0
+            || student_a->int_id != student_b->int_id || student_a->int_age != student_b->int_age
+            || strcmp(student_a->char_last_name, student_b->char_last_name) != 0
+            || strcmp(student_a->char_first_name, student_b->char_first_name) != 0
+            || student_a->int_nb_courses != student_b->int_nb_courses
+            || (int_averages && !same_float(student_a->float_average, student_b->float_average)))
+        {
+            printf("same_prom: student %d differs\n", i);
+            return (0);
+        }
+        for (j = 0; j < student_a->int_nb_courses; j++)
+        {
+            course_a = &student_a->course_courses[j];
+            course_b = &student_b->course_courses[j];
+            info_a = &prom_a->catalog.info_courses[course_a->int_course_id];
+            info_b = &prom_b->catalog.info_courses[course_b->int_course_id];
+            if (strcmp(info_a->char_course_name, info_b->char_course_name) != 0
+                || !same_float(info_a->float_coef, info_b->float_coef)
+                || course_a->grades.int_nb_grades != course_b->grades.int_nb_grades
+                || (course_a->grades.int_nb_grades > 0
+                    && memcmp(get_grades_data(&course_a->grades), get_grades_data(&course_b->grades),
+                              course_a->grades.int_nb_grades * sizeof(float)) != 0)
+                || (int_averages && !same_float(course_a->float_average, course_b->float_average)))
+            {
+                printf("same_prom: course %d of student %d differs\n", j, i);
+                return (0);
+            }
+        }
+    }
+    
+    return (1);
+}
+
+#endif
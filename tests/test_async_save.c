@@ -0,0 +1,195 @@
+/*!
+ * \file test_async_save.c
+ * \author Akhatar Abdelhamid <abdelhamid.akhatar@etu.cyu.fr>
+ * \version 1.0
+ * \date November 2, 2025
+ * \brief Tests of the background save
+ * 
+ * Saves data.txt on a background thread and loads it back. Then makes a
+ * save fail in the middle of its write, with a file size limit: the old
+ * file must be left byte for byte, without a temporary file beside it.
+ */
+
+#include "testProm.h"
+#include "saveData.h"
+#include "binary.h"
+#include "asyncSave.h"
+#include <stdlib.h>
+#include <signal.h>
+#include <dirent.h>
+#include <sched.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include <sys/resource.h>
+
+/*! \brief Data file of the tests */
+#define TEST_DATA "data.txt"
+
+/*! \brief Directory of the files written by the tests */
+#define TEST_DIR "bin/async_save.d"
+
+/*! \brief Binary file written by the tests */
+#define TEST_FILE TEST_DIR "/prom.bin"
+
+/*! \brief File size limit making the failed save stop (bytes) */
+#define TEST_SIZE_LIMIT 4096
+
+/*!
+ * \fn static char* read_file(const char* str_filename, long* size_file)
+ * \brief Reads a whole file
+ * \param str_filename Name of the file
+ * \param size_file Pointer receiving the size of the file
+ * \return Content of the file, to free, or NULL if it cannot be read
+ */
+static char* read_file(const char* str_filename, long* size_file)
+{
+    FILE* file;
+    char* data;
+    
+    file = fopen(str_filename, "rb");
+    if (file == NULL)
+    {
+        return (NULL);
+    }
+    fseek(file, 0, SEEK_END);
+    *size_file = ftell(file);
+    fseek(file, 0, SEEK_SET);
+    data = (char*)malloc(*size_file + 1);
+    if (data != NULL && fread(data, 1, *size_file, file) != (size_t)*size_file)
+    {
+        free(data);
+        data = NULL;
+    }
+    fclose(file);
+    
+    return (data);
+}
+
+/*!
+ * \fn static int count_files(void)
+ * \brief Counts the files of the test directory
+ * \return Number of entries other than "." and ".."
+ */
+static int count_files(void)
+{
+    DIR* dir;
+    struct dirent* entry;
+    int int_nb_files;
+    
+    int_nb_files = 0;
+    dir = opendir(TEST_DIR);
+    if (dir == NULL)
+    {
+        return (0);
+    }
+    while ((entry = readdir(dir)) != NULL)
+    {
+        if (strcmp(entry->d_name, ".") != 0 && strcmp(entry->d_name, "..") != 0)
+        {
+            int_nb_files++;
+        }
+    }
+    closedir(dir);
+    
+    return (int_nb_files);
+}
+
+/*!
+ * \fn static void check_save(Prom* prom, int int_compact)
+ * \brief Saves a promotion in the background and checks the promotion loaded back
+ * \param prom Pointer to the promotion, averages up to date
+ * \param int_compact 1 for a compact file, 0 for a plain one
+ */
+static void check_save(Prom* prom, int int_compact)
+{
+    AsyncSave* save;
+    Prom loaded;
+    
+    save = start_save_prom_binary(TEST_FILE, prom, int_compact);
+    CHECK(save != NULL);
+    if (save == NULL)
+    {
+        return;
+    }
+    CHECK(wait_async_save(save) == 0);
+    loaded = load_prom_binary(TEST_FILE);
+    CHECK(same_prom(prom, &loaded, 1));
+    destroy_prom(&loaded);
+    CHECK(count_files() == 1);
+}
+
+/*!
+ * \fn static void check_failed_save(Prom* prom)
+ * \brief Checks that a save failing in its write leaves the old file as is
+ * \param prom Pointer to the promotion, saved in TEST_FILE, larger than TEST_SIZE_LIMIT
+ */
+static void check_failed_save(Prom* prom)
+{
+    AsyncSave* save;
+    struct rlimit limit;
+    struct rlimit saved_limit;
+    char* old_data;
+    char* new_data;
+    long size_old;
+    long size_new;
+    
+    old_data = read_file(TEST_FILE, &size_old);
+    CHECK(old_data != NULL && size_old > TEST_SIZE_LIMIT);
+    
+    /* Writes past the limit fail with EFBIG instead of killing the process */
+    signal(SIGXFSZ, SIG_IGN);
+    getrlimit(RLIMIT_FSIZE, &saved_limit);
+    limit = saved_limit;
+    limit.rlim_cur = TEST_SIZE_LIMIT;
+    CHECK(setrlimit(RLIMIT_FSIZE, &limit) == 0);
+    
+    save = start_save_prom_binary(TEST_FILE, prom, 0);
+    CHECK(save != NULL);
+    if (save != NULL)
+    {
+        while (!is_async_save_done(save))
+        {
+            sched_yield();
+        }
+        CHECK(wait_async_save(save) != 0);
+    }
+    setrlimit(RLIMIT_FSIZE, &saved_limit);
+    signal(SIGXFSZ, SIG_DFL);
+    
+    new_data = read_file(TEST_FILE, &size_new);
+    CHECK(new_data != NULL && old_data != NULL && size_new == size_old
+          && memcmp(old_data, new_data, size_old) == 0);
+    CHECK(count_files() == 1);
+    free(old_data);
+    free(new_data);
+}
+
+/*!
+ * \fn int main(void)
+ * \brief Runs the background save tests
+ * \return 0 if every check passed
+ */
+int main(void)
+{
+    Prom prom;
+    
+    prom = create_arena_prom(0);
+    if (load_prom_mapped(TEST_DATA, &prom) != 0 || prom.int_nb_students == 0)
+    {
+        printf("test_async_save: cannot load %s\n", TEST_DATA);
+        return (1);
+    }
+    mkdir(TEST_DIR, 0777);
+    
+    check_save(&prom, 0);
+    check_save(&prom, 1);
+    
+    /* The old file is the compact one: the failed save would write a plain one */
+    check_failed_save(&prom);
+    
+    destroy_prom(&prom);
+    remove(TEST_FILE);
+    rmdir(TEST_DIR);
+    
+    return (end_tests("test_async_save"));
+}
@@ -0,0 +1,135 @@
+/*!
+ * \file test_compact.c
+ * \author Akhatar Abdelhamid <abdelhamid.akhatar@etu.cyu.fr>
+ * \version 1.0
+ * \date November 2, 2025
+ * \brief Tests of the compact binary format
+ * 
+ * Loads data.txt, saves it as a compact file and loads it back: every
+ * grade and average must come back bit for bit. Grades without an exact
+ * fixed-point form must be refused by the packer, the save falling back
+ * to a plain file that still round-trips exactly.
+ */
+
+#include "testProm.h"
+#include "saveData.h"
+#include "binary.h"
+#include "binaryFormat.h"
+#include "update.h"
+#include <math.h>
+
+/*! \brief Data file of the tests */
+#define TEST_DATA "data.txt"
+
+/*! \brief Binary file written by the tests */
+#define TEST_FILE "bin/test_compact.bin"
+
+/*!
+ * \fn static uint32_t get_file_flags(const char* str_filename)
+ * \brief Reads the flags of the header of a version 2 file
+ * \param str_filename Name of the file
+ * \return int_flags of the header, 0 if it cannot be read
+ */
+static uint32_t get_file_flags(const char* str_filename)
+{
+    BinHeader header;
+    FILE* file;
+    
+    file = fopen(str_filename, "rb");
+    if (file == NULL)
+    {
+        return (0);
+    }
+    if (fread(&header, sizeof(BinHeader), 1, file) != 1)
+    {
+        header.int_flags = 0;
+    }
+    fclose(file);
+    
+    return (header.int_flags);
+}
+
+/*!
+ * \fn static void check_round_trip(Prom* prom, uint32_t int_flags)
+ * \brief Saves a promotion as compact, checks the flags written and the promotion loaded back
+ * \param prom Pointer to the promotion, averages up to date
+ * \param int_flags Expected flags (0: a plain file)
+ */
+static void check_round_trip(Prom* prom, uint32_t int_flags)
+{
+    Prom loaded;
+    
+    CHECK(save_prom_binary_compact(TEST_FILE, prom) == 0);
+    CHECK(get_file_flags(TEST_FILE) == int_flags);
+    loaded = load_prom_binary(TEST_FILE);
+    CHECK(same_prom(prom, &loaded, 1));
+    destroy_prom(&loaded);
+}
+
+/*!
+ * \fn static void check_refused_grade(Prom* prom, float float_grade)
+ * \brief Checks that a grade without fixed-point form makes the save fall back to a plain file
+ * \param prom Pointer to the promotion
+ * \param float_grade Grade replacing the first grade of the first course
+ */
+static void check_refused_grade(Prom* prom, float float_grade)
+{
+    float* data;
+    float saved;
+    
+    data = get_grades_data(&prom->student_students[0].course_courses[0].grades);
+    saved = data[0];
+    data[0] = float_grade;
+    update_course_average(prom);
+    update_student_average(prom);
+    check_round_trip(prom, 0);
+    data[0] = saved;
+    update_course_average(prom);
+    update_student_average(prom);
+}
+
+/*!
+ * \fn int main(void)
+ * \brief Runs the compact format tests
+ * \return 0 if every check passed
+ */
+int main(void)
+{
+    Prom prom;
+    float* data;
+    
+    prom = create_arena_prom(0);
+    if (load_prom_mapped(TEST_DATA, &prom) != 0 || prom.int_nb_students == 0
+        || prom.student_students[0].int_nb_courses == 0
+        || prom.student_students[0].course_courses[0].grades.int_nb_grades == 0)
+    {
+        printf("test_compact: cannot load %s\n", TEST_DATA);
+        return (1);
+    }
+    
+    /* One-decimal grades up to 25.5: one byte each */
+    check_round_trip(&prom, BIN_FLAG_COMPACT);
+    
+    /* A grade above 25.5 needs two bytes */
+    data = get_grades_data(&prom.student_students[0].course_courses[0].grades);
+    data[0] = 100.5f;
+    update_course_average(&prom);
+    update_student_average(&prom);
+    check_round_trip(&prom, BIN_FLAG_COMPACT | BIN_FLAG_GRADES_16);
+    
+    /* Out of range or more than one decimal: refused by the packer */
+    check_refused_grade(&prom, -0.5f);
+    check_refused_grade(&prom, 6553.6f);
+    check_refused_grade(&prom, 1.0e9f);
+    check_refused_grade(&prom, 12.34f);
+    check_refused_grade(&prom, 19.99f);
+    check_refused_grade(&prom, NAN);
+    
+    /* Back to one-decimal grades: compact again */
+    check_round_trip(&prom, BIN_FLAG_COMPACT | BIN_FLAG_GRADES_16);
+    
+    destroy_prom(&prom);
+    remove(TEST_FILE);
+    
+    return (end_tests("test_compact"));
+}
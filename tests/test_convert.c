@@ -0,0 +1,183 @@
+/*!
+ * \file test_convert.c
+ * \author Akhatar Abdelhamid <abdelhamid.akhatar@etu.cyu.fr>
+ * \version 1.0
+ * \date November 2, 2025
+ * \brief Tests of the bounded memory conversion
+ * 
+ * Converts data.txt and a skewed data file, where one student holds most
+ * of the grades, with several memory budgets: the binary file must be the
+ * same, byte for byte, as save_prom_binary_v1 after load_prom_mapped.
+ * The small budgets make the converter split its buckets again.
+ */
+
+#include "testProm.h"
+#include "saveData.h"
+#include "binary.h"
+#include <stdlib.h>
+
+/*! \brief Data file of the tests */
+#define TEST_DATA "data.txt"
+
+/*! \brief Skewed data file written by the tests */
+#define TEST_SKEWED "bin/test_convert.txt"
+
+/*! \brief Binary file written by the converter */
+#define TEST_FILE "bin/test_convert.bin"
+
+/*! \brief Binary file written by save_prom_binary_v1 */
+#define TEST_EXPECTED "bin/test_convert_expected.bin"
+
+/*! \brief Number of students of the skewed data file */
+#define TEST_NB_STUDENTS 300
+
+/*! \brief Number of grades of the student holding most of them */
+#define TEST_NB_HEAVY 5000
+
+/*!
+ * \fn static int write_skewed(const char* str_filename)
+ * \brief Writes a data file whose first student holds most of the grades
+ * \param str_filename Name of the data file
+ * \return 0 on success, -1 in case of error
+ */
+static int write_skewed(const char* str_filename)
+{
+    FILE* file;
+    int i;
+    
+    file = fopen(str_filename, "w");
+    if (file == NULL)
+    {
+        return (-1);
+    }
+    fprintf(file, "ETUDIANTS\nnumero;prenom;nom;age\n");
+    for (i = 0; i < TEST_NB_STUDENTS; i++)
+    {
+        fprintf(file, "%d;First%d;Last%d;%d\n", 1000 + i, i, i, 18 + i % 5);
+    }
+    fprintf(file, "\nMATIERES\nnom;coef\nMaths;2\nPhysique;1.5\nHistoire;1\n");
+    fprintf(file, "\nNOTES\nid;nom;note\n");
+    for (i = 0; i < TEST_NB_HEAVY; i++)
+    {
+        fprintf(file, "1000;%s;%.1f\n", (i % 3 == 0 ? "Maths" : (i % 3 == 1 ? "Physique" : "Histoire")),
+                (float)(i % 201) / 10.0f);
+        /* The other students, interleaved */
+        if (i % 10 == 0)
+        {
+            fprintf(file, "%d;Maths;%.1f\n", 1001 + (i / 10) % (TEST_NB_STUDENTS - 1), (float)(i % 21));
+        }
+    }
+    
+    return (fclose(file) == 0 ? 0 : -1);
+}
+
+/*!
+ * \fn static unsigned char* read_whole(const char* str_filename, long* size_file)
+ * \brief Reads a whole file to memory
+ * \param str_filename Name of the file
+ * \param size_file Set to the size of the file
+ * \return Content of the file, to free, or NULL in case of error
+ */
+static unsigned char* read_whole(const char* str_filename, long* size_file)
+{
+    unsigned char* data;
+    FILE* file;
+    
+    file = fopen(str_filename, "rb");
+    if (file == NULL)
+    {
+        return (NULL);
+    }
+    fseek(file, 0, SEEK_END);
+    *size_file = ftell(file);
+    rewind(file);
+    data = (unsigned char*)malloc(*size_file > 0 ? *size_file : 1);
+    if (data != NULL && (long)fread(data, 1, *size_file, file) != *size_file)
+    {
+        free(data);
+        data = NULL;
+    }
+    fclose(file);
+    
+    return (data);
+}
+
+/*!
+ * \fn static void check_convert(const char* str_data, size_t size_budget)
+ * \brief Converts a data file with a budget and compares the result to the saved promotion
+ * \param str_data Name of the data file
+ * \param size_budget Memory budget of the conversion (bytes)
+ */
+static void check_convert(const char* str_data, size_t size_budget)
+{
+    unsigned char* expected;
+    unsigned char* converted;
+    long size_expected;
+    long size_converted;
+    
+    CHECK(convert_text_to_binary(str_data, TEST_FILE, size_budget) == 0);
+    expected = read_whole(TEST_EXPECTED, &size_expected);
+    converted = read_whole(TEST_FILE, &size_converted);
+    CHECK(expected != NULL && converted != NULL);
+    if (expected != NULL && converted != NULL)
+    {
+        CHECK(size_expected == size_converted);
+        CHECK(size_expected == size_converted && memcmp(expected, converted, size_expected) == 0);
+    }
+    free(expected);
+    free(converted);
+}
+
+/*!
+ * \fn static int save_expected(const char* str_data)
+ * \brief Loads a data file and saves it as the expected version 1 file
+ * \param str_data Name of the data file
+ * \return 0 on success, -1 in case of error
+ */
+static int save_expected(const char* str_data)
+{
+    Prom prom;
+    int result;
+    
+    prom = create_arena_prom(0);
+    result = load_prom_mapped(str_data, &prom);
+    if (result == 0)
+    {
+        result = save_prom_binary_v1(TEST_EXPECTED, &prom);
+    }
+    destroy_prom(&prom);
+    
+    return (result);
+}
+
+/*!
+ * \fn static void check_all_budgets(const char* str_data)
+ * \brief Converts a data file with budgets from one byte to the default one
+ * \param str_data Name of the data file
+ */
+static void check_all_budgets(const char* str_data)
+{
+    CHECK(save_expected(str_data) == 0);
+    check_convert(str_data, 1);
+    check_convert(str_data, 64);
+    check_convert(str_data, 4096);
+    check_convert(str_data, 0);
+}
+
+/*!
+ * \fn int main(void)
+ * \brief Runs the conversion tests
+ * \return 0 if every check passed
+ */
+int main(void)
+{
+    check_all_budgets(TEST_DATA);
+    CHECK(write_skewed(TEST_SKEWED) == 0);
+    check_all_budgets(TEST_SKEWED);
+    
+    remove(TEST_SKEWED);
+    remove(TEST_FILE);
+    remove(TEST_EXPECTED);
+    
+    return (end_tests("test_convert"));
+}
@@ -0,0 +1,148 @@
+/*!
+ * \file test_journal.c
+ * \author Akhatar Abdelhamid <abdelhamid.akhatar@etu.cyu.fr>
+ * \version 1.0
+ * \date November 2, 2025
+ * \brief Tests of the journal of grade changes
+ * 
+ * Saves data.txt as a snapshot, records grade changes in its journal and
+ * replays them: the promotion loaded back must be the one the changes
+ * were made to. Records not committed, or cut by a crash, must be
+ * ignored, and a compaction must not change the promotion.
+ */
+
+#include "testProm.h"
+#include "saveData.h"
+#include "journal.h"
+#include "update.h"
+
+/*! \brief Data file of the tests */
+#define TEST_DATA "data.txt"
+
+/*! \brief Snapshot written by the tests */
+#define TEST_FILE "bin/test_journal.bin"
+
+/*! \brief Journal of the snapshot */
+#define TEST_JOURNAL TEST_FILE ".journal"
+
+/*!
+ * \fn static void check_replay(const Prom* prom)
+ * \brief Checks that the snapshot and its journal load back as a promotion
+ * \param prom Pointer to the expected promotion, averages up to date
+ */
+static void check_replay(const Prom* prom)
+{
+    Prom loaded;
+    
+    loaded = load_prom_journaled(TEST_FILE, NULL);
+    CHECK(same_prom(prom, &loaded, 1));
+    destroy_prom(&loaded);
+}
+
+/*!
+ * \fn static void make_changes(Journal* journal, Prom* prom)
+ * \brief Adds and replaces grades of the first and last students
+ * \param journal Pointer to the opened journal
+ * \param prom Pointer to the promotion of the journal
+ */
+static void make_changes(Journal* journal, Prom* prom)
+{
+    Student* first;
+    Student* last;
+    
+    first = &prom->student_students[0];
+    last = &prom->student_students[prom->int_nb_students - 1];
+    CHECK(journal_add_grade(journal, prom, first->int_id, first->course_courses[0].int_course_id, 17.5f) == 0);
+    CHECK(journal_add_grade(journal, prom, first->int_id, first->course_courses[0].int_course_id, 3.25f) == 0);
+    CHECK(journal_set_grade(journal, prom, last->int_id, last->course_courses[0].int_course_id, 0, 20.0f) == 0);
+    
+    /* Unknown student, course or grade: refused, nothing recorded */
+    CHECK(journal_add_grade(journal, prom, -1, first->course_courses[0].int_course_id, 1.0f) != 0);
+    CHECK(journal_add_grade(journal, prom, first->int_id, prom->catalog.int_nb_courses, 1.0f) != 0);
+    CHECK(journal_set_grade(journal, prom, last->int_id, last->course_courses[0].int_course_id,
+                            last->course_courses[0].grades.int_nb_grades, 1.0f) != 0);
+    
+    update_course_average(prom);
+    update_student_average(prom);
+}
+
+/*!
+ * \fn static void append_torn_record(void)
+ * \brief Appends half a record to the journal, as a crash during a write would
+ */
+static void append_torn_record(void)
+{
+    JournalRecord record;
+    FILE* file;
+    
+    memset(&record, 0x5A, sizeof(JournalRecord));
+    file = fopen(TEST_JOURNAL, "ab");
+    CHECK(file != NULL);
+    if (file != NULL)
+    {
+        CHECK(fwrite(&record, sizeof(JournalRecord) / 2, 1, file) == 1);
+        fclose(file);
+    }
+}
+
+/*!
+ * \fn int main(void)
+ * \brief Runs the journal tests
+ * \return 0 if every check passed
+ */
+int main(void)
+{
+    Journal journal;
+    Prom prom;
+    Prom reopened;
+    
+    prom = create_arena_prom(0);
+    if (load_prom_mapped(TEST_DATA, &prom) != 0 || prom.int_nb_students < 2
+        || prom.student_students[0].int_nb_courses == 0
+        || prom.student_students[prom.int_nb_students - 1].int_nb_courses == 0
+        || prom.student_students[prom.int_nb_students - 1].course_courses[0].grades.int_nb_grades == 0)
+    {
+        printf("test_journal: cannot load %s\n", TEST_DATA);
+        return (1);
+    }
+    
+    /* Empty journal: the snapshot alone */
+    CHECK(create_journal(TEST_FILE, &prom, &journal) == 0);
+    check_replay(&prom);
+    
+    /* Committed changes are replayed */
+    make_changes(&journal, &prom);
+    CHECK(commit_journal(&journal, &prom) == 0);
+    check_replay(&prom);
+    close_journal(&journal);
+    
+    /* Changes not committed are dropped with the journal */
+    reopened = load_prom_journaled(TEST_FILE, &journal);
+    CHECK(same_prom(&prom, &reopened, 1));
+    make_changes(&journal, &reopened);
+    close_journal(&journal);
+    check_replay(&prom);
+    destroy_prom(&reopened);
+    
+    /* A torn record ends the replay, and the next record overwrites it */
+    append_torn_record();
+    check_replay(&prom);
+    reopened = load_prom_journaled(TEST_FILE, &journal);
+    CHECK(same_prom(&prom, &reopened, 1));
+    make_changes(&journal, &reopened);
+    CHECK(commit_journal(&journal, &reopened) == 0);
+    check_replay(&reopened);
+    
+    /* Compaction folds the journal into the snapshot */
+    CHECK(compact_journal(&journal, &reopened) == 0);
+    CHECK(journal.size_journal == sizeof(JournalHeader));
+    check_replay(&reopened);
+    close_journal(&journal);
+    
+    destroy_prom(&reopened);
+    destroy_prom(&prom);
+    remove(TEST_FILE);
+    remove(TEST_JOURNAL);
+    
+    return (end_tests("test_journal"));
+}
@@ -0,0 +1,113 @@
+/*!
+ * \file test_kernels.c
+ * \author Akhatar Abdelhamid <abdelhamid.akhatar@etu.cyu.fr>
+ * \version 1.0
+ * \date November 2, 2025
+ * \brief Tests of the vectorized average kernels
+ * 
+ * Runs sum_floats and dot_floats at every kernel level, on lengths below
+ * and above KERNEL_MIN_VECTOR with odd tails, and compares them with a
+ * scalar left-to-right loop within the bound documented in kernels.h.
+ */
+
+#include "test.h"
+#include "kernels.h"
+#include <stdlib.h>
+#include <math.h>
+
+/*! \brief Largest array length tested */
+#define TEST_MAX_LENGTH 1031
+
+/*!
+ * \fn static int check_level(int int_level, const float* tab_a, const float* tab_b)
+ * \brief Compares the kernels of one level with the scalar loops, for every tested length
+ * \param int_level Requested kernel level
+ * \param tab_a Grades
+ * \param tab_b Coefficients
+ * \return Level actually selected
+ */
+static int check_level(int int_level, const float* tab_a, const float* tab_b)
+{
+    static const int tab_lengths[] = { 0, 1, 2, 3, 7, 8, 15, 16, 17, 23, 31, 32, 33, 47, 63, 64, 65, 100, 257, 1001, TEST_MAX_LENGTH };
+    double sum;
+    double abs_sum;
+    double dot;
+    double abs_dot;
+    float scalar_sum;
+    float scalar_dot;
+    int selected;
+    size_t k;
+    int n;
+    int i;
+    
+    selected = set_kernel_level(int_level);
+    CHECK(get_kernel_level() == selected);
+    for (k = 0; k < sizeof(tab_lengths) / sizeof(tab_lengths[0]); k++)
+    {
+        n = tab_lengths[k];
+        scalar_sum = 0.0f;
+        scalar_dot = 0.0f;
+        abs_sum = 0.0;
+        abs_dot = 0.0;
+        for (i = 0; i < n; i++)
+        {
+            scalar_sum += tab_a[i];
+            scalar_dot += tab_a[i] * tab_b[i];
+            abs_sum += fabs(tab_a[i]);
+            abs_dot += fabs((double)tab_a[i] * tab_b[i]);
+        }
+        
+        /* Bound of kernels.h: 2 * n * 2^-24 * sum(|x_i|) */
+        sum = sum_floats(tab_a, n);
+        dot = dot_floats(tab_a, tab_b, n);
+        CHECK(fabs(sum - scalar_sum) <= 2.0 * n * ldexp(1.0, -24) * abs_sum);
+        CHECK(fabs(dot - scalar_dot) <= 2.0 * n * ldexp(1.0, -24) * abs_dot);
+        
+        /* The scalar loop is used below KERNEL_MIN_VECTOR: bit-identical */
+        if (n < KERNEL_MIN_VECTOR || selected == KERNEL_SCALAR)
+        {
+            CHECK((float)sum == scalar_sum);
+            CHECK((float)dot == scalar_dot);
+        }
+    }
+    
+    return (selected);
+}
+
+/*!
+ * \fn int main(void)
+ * \brief Runs the kernel tests
+ * \return 0 if every check passed
+ */
+int main(void)
+{
+    float tab_a[TEST_MAX_LENGTH];
+    float tab_b[TEST_MAX_LENGTH];
+    int level;
+    int i;
+    
+    /* Grades in [0, 20] with a quarter step, coefficients in [0.5, 5] */
+    srand(42);
+    for (i = 0; i < TEST_MAX_LENGTH; i++)
+    {
+        tab_a[i] = (float)(rand() % 81) * 0.25f;
+        tab_b[i] = 0.5f + (float)(rand() % 10) * 0.5f;
+    }
+    
+    for (level = KERNEL_SCALAR; level <= KERNEL_AVX2; level++)
+    {
+        printf("test_kernels: level %d requested, %d selected\n", level, check_level(level, tab_a, tab_b));
+    }
+    
+    /* Values that do not sum exactly: the bound must still hold */
+    for (i = 0; i < TEST_MAX_LENGTH; i++)
+    {
+        tab_a[i] = (float)rand() / (float)RAND_MAX * 20.0f;
+    }
+    for (level = KERNEL_SCALAR; level <= KERNEL_AVX2; level++)
+    {
+        check_level(level, tab_a, tab_b);
+    }
+    
+    return (end_tests("test_kernels"));
+}
@@ -0,0 +1,91 @@
+/*!
+ * \file test_packed.c
+ * \author Akhatar Abdelhamid <abdelhamid.akhatar@etu.cyu.fr>
+ * \version 1.0
+ * \date November 2, 2025
+ * \brief Tests of the packed binary container
+ * 
+ * Loads data.txt, saves it packed, plain and compact, and loads it back
+ * through load_prom_binary: every grade and average must come back bit
+ * for bit. A container cut short must be refused.
+ */
+
+#include "testProm.h"
+#include "saveData.h"
+#include "binary.h"
+#include "packedFile.h"
+#include <unistd.h>
+
+/*! \brief Data file of the tests */
+#define TEST_DATA "data.txt"
+
+/*! \brief Packed file written by the tests */
+#define TEST_FILE "bin/test_packed.bin"
+
+/*!
+ * \fn static void check_round_trip(Prom* prom, int int_compact)
+ * \brief Saves a promotion packed and checks the promotion loaded back
+ * \param prom Pointer to the promotion, averages up to date
+ * \param int_compact 1 to pack a compact file, 0 for a plain one
+ */
+static void check_round_trip(Prom* prom, int int_compact)
+{
+    Prom loaded;
+    
+    CHECK(save_prom_binary_packed(TEST_FILE, prom, int_compact) == 0);
+    loaded = load_prom_binary(TEST_FILE);
+    CHECK(same_prom(prom, &loaded, 1));
+    destroy_prom(&loaded);
+}
+
+/*!
+ * \fn static void check_truncated(void)
+ * \brief Checks that a packed file missing its last bytes is refused
+ */
+static void check_truncated(void)
+{
+    Prom loaded;
+    FILE* file;
+    long size_file;
+    
+    file = fopen(TEST_FILE, "rb");
+    CHECK(file != NULL);
+    if (file == NULL)
+    {
+        return;
+    }
+    fseek(file, 0, SEEK_END);
+    size_file = ftell(file);
+    fclose(file);
+    
+    CHECK(truncate(TEST_FILE, size_file - 1) == 0);
+    loaded = load_prom_binary(TEST_FILE);
+    CHECK(loaded.int_nb_students == 0);
+    destroy_prom(&loaded);
+}
+
+/*!
+ * \fn int main(void)
+ * \brief Runs the packed container tests
+ * \return 0 if every check passed
+ */
+int main(void)
+{
+    Prom prom;
+    
+    prom = create_arena_prom(0);
+    if (load_prom_mapped(TEST_DATA, &prom) != 0 || prom.int_nb_students == 0)
+    {
+        printf("test_packed: cannot load %s\n", TEST_DATA);
+        return (1);
+    }
+    
+    check_round_trip(&prom, 0);
+    check_round_trip(&prom, 1);
+    check_truncated();
+    
+    destroy_prom(&prom);
+    remove(TEST_FILE);
+    
+    return (end_tests("test_packed"));
+}
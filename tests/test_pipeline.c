@@ -0,0 +1,165 @@
+/*!
+ * \file test_pipeline.c
+ * \author Akhatar Abdelhamid <abdelhamid.akhatar@etu.cyu.fr>
+ * \version 1.0
+ * \date November 2, 2025
+ * \brief Tests of the loading pipeline of the grades
+ * 
+ * Loads data.txt through the line reader, the grades being loaded by
+ * get_all_grades_pipelined with several numbers of parsers, and by
+ * get_all_grades: every promotion must be the one of the sequential
+ * mapped loader, grade for grade. A file smaller than PIPELINE_MIN_SIZE,
+ * which get_all_grades reads on the calling thread, is checked the same way.
+ */
+
+#include "testProm.h"
+#include "saveData.h"
+#include "read.h"
+
+/*! \brief Data file of the tests */
+#define TEST_DATA "data.txt"
+
+/*! \brief Small data file written by the tests */
+#define TEST_SMALL "bin/test_pipeline.txt"
+
+/*! \brief Number of grade lines kept in the small data file */
+#define TEST_SMALL_GRADES 500
+
+/*!
+ * \fn static int load_streamed(const char* str_filename, Prom* prom, int int_nb_parsers)
+ * \brief Loads a data file through the line reader
+ * \param str_filename Name of the data file
+ * \param prom Pointer to the Prom structure to fill
+ * \param int_nb_parsers Parser threads of get_all_grades_pipelined, -1 for get_all_grades
+ * \return 0 on success, -1 if the file cannot be read or the pipeline fails
+ */
+static int load_streamed(const char* str_filename, Prom* prom, int int_nb_parsers)
+{
+    LineReader reader;
+    FILE* file;
+    int result;
+    
+    file = fopen(str_filename, "r");
+    if (file == NULL)
+    {
+        return (-1);
+    }
+    if (create_line_reader(&reader, file) != 0)
+    {
+        fclose(file);
+        return (-1);
+    }
+    
+    result = 0;
+    get_all_students(&reader, prom);
+    get_all_courses(&reader, prom);
+    if (int_nb_parsers < 0)
+    {
+        get_all_grades(&reader, prom);
+    }
+    else
+    {
+        result = get_all_grades_pipelined(&reader, prom, int_nb_parsers);
+    }
+    
+    destroy_line_reader(&reader);
+    fclose(file);
+    return (result);
+}
+
+/*!
+ * \fn static void check_streamed(const char* str_filename, const Prom* expected, int int_nb_parsers)
+ * \brief Checks that a streamed load gives the promotion of the sequential loader
+ * \param str_filename Name of the data file
+ * \param expected Pointer to the promotion of the sequential loader
+ * \param int_nb_parsers Parser threads of get_all_grades_pipelined, -1 for get_all_grades
+ */
+static void check_streamed(const char* str_filename, const Prom* expected, int int_nb_parsers)
+{
+    Prom prom;
+    
+    prom = create_arena_prom(0);
+    CHECK(load_streamed(str_filename, &prom, int_nb_parsers) == 0);
+    CHECK(same_prom(expected, &prom, 1));
+    destroy_prom(&prom);
+}
+
+/*!
+ * \fn static int write_small_file(void)
+ * \brief Writes the first TEST_SMALL_GRADES grade lines of the data file, with its other sections
+ * \return 0 on success, -1 if the file cannot be written
+ */
+static int write_small_file(void)
+{
+    FILE* source;
+    FILE* destination;
+    char line[512];
+    int int_nb_grades;
+    
+    source = fopen(TEST_DATA, "r");
+    destination = fopen(TEST_SMALL, "w");
+    if (source == NULL || destination == NULL)
+    {
+        if (source != NULL)
+        {
+            fclose(source);
+        }
+        if (destination != NULL)
+        {
+            fclose(destination);
+        }
+        return (-1);
+    }
+    
+    /* Everything up to the column names of NOTES, then the first grades */
+    int_nb_grades = -2;
+    while (int_nb_grades < TEST_SMALL_GRADES && fgets(line, sizeof(line), source) != NULL)
+    {
+        if (int_nb_grades > -2 || strcmp(line, "NOTES\n") == 0)
+        {
+            int_nb_grades++;
+        }
+        fputs(line, destination);
+    }
+    fclose(source);
+    
+    return (fclose(destination) == 0 ? 0 : -1);
+}
+
+/*!
+ * \fn int main(void)
+ * \brief Runs the loading pipeline tests
+ * \return 0 if every check passed
+ */
+int main(void)
+{
+    Prom expected;
+    int parsers[] = {0, 1, 2, 3, 8, PIPELINE_MAX_PARSERS + 4};
+    int i;
+    
+    expected = create_arena_prom(0);
+    if (load_prom_mapped(TEST_DATA, &expected) != 0 || expected.int_nb_students == 0)
+    {
+        printf("test_pipeline: cannot load %s\n", TEST_DATA);
+        return (1);
+    }
+    
+    /* data.txt is large enough for get_all_grades to use the pipeline */
+    for (i = 0; i < (int)(sizeof(parsers) / sizeof(int)); i++)
+    {
+        check_streamed(TEST_DATA, &expected, parsers[i]);
+    }
+    check_streamed(TEST_DATA, &expected, -1);
+    destroy_prom(&expected);
+    
+    /* A small file: read on the calling thread by get_all_grades */
+    CHECK(write_small_file() == 0);
+    expected = create_arena_prom(0);
+    CHECK(load_prom_mapped(TEST_SMALL, &expected) == 0);
+    check_streamed(TEST_SMALL, &expected, -1);
+    check_streamed(TEST_SMALL, &expected, 2);
+    destroy_prom(&expected);
+    remove(TEST_SMALL);
+    
+    return (end_tests("test_pipeline"));
+}
@@ -0,0 +1,92 @@
+/*!
+ * \file test_resave.c
+ * \author Akhatar Abdelhamid <abdelhamid.akhatar@etu.cyu.fr>
+ * \version 1.0
+ * \date November 2, 2025
+ * \brief Tests of saving a promotion back to the file it was loaded from
+ * 
+ * A promotion loaded from a version 2 file, entirely or lazily, reads its
+ * names and grades from a mapping of that file. Saving it back to the same
+ * name, in every layout, must leave it readable, and the file reloaded
+ * must hold the same promotion.
+ */
+
+#include "testProm.h"
+#include "saveData.h"
+#include "binary.h"
+#include "lazyLoad.h"
+#include "packedFile.h"
+#include <unistd.h>
+
+/*! \brief Data file of the tests */
+#define TEST_DATA "data.txt"
+
+/*! \brief Binary file written by the tests */
+#define TEST_FILE "bin/test_resave.bin"
+
+/*!
+ * \fn static int save_packed(const char* str_filename, Prom* prom)
+ * \brief Saves a promotion as a packed compact file
+ * \param str_filename Name of the file
+ * \param prom Pointer to the promotion
+ * \return 0 if success, -1 in case of error
+ */
+static int save_packed(const char* str_filename, Prom* prom)
+{
+    return (save_prom_binary_packed(str_filename, prom, 1));
+}
+
+/*!
+ * \fn static void check_resave(const Prom* expected, int int_lazy, int (*save)(const char*, Prom*))
+ * \brief Loads the test file, saves it back to its own name and reloads it
+ * \param expected Pointer to the promotion held by the test file
+ * \param int_lazy 1 to load the test file lazily, 0 to load it entirely
+ * \param save Save function of the layout written back
+ */
+static void check_resave(const Prom* expected, int int_lazy, int (*save)(const char*, Prom*))
+{
+    Prom loaded;
+    Prom reloaded;
+    
+    CHECK(save_prom_binary(TEST_FILE, (Prom*)expected) == 0);
+    loaded = (int_lazy ? load_prom_binary_lazy(TEST_FILE, LAZY_DEFAULT_BUDGET) : load_prom_binary(TEST_FILE));
+    CHECK(save(TEST_FILE, &loaded) == 0);
+    
+    /* The mapping of the old file is still readable */
+    CHECK(same_prom(expected, &loaded, 1));
+    destroy_prom(&loaded);
+    
+    reloaded = load_prom_binary(TEST_FILE);
+    CHECK(same_prom(expected, &reloaded, 1));
+    destroy_prom(&reloaded);
+    CHECK(access(TEST_FILE ".tmp", F_OK) != 0);
+}
+
+/*!
+ * \fn int main(void)
+ * \brief Runs the tests of saving back to the same file
+ * \return 0 if every check passed
+ */
+int main(void)
+{
+    Prom prom;
+    
+    prom = create_arena_prom(0);
+    if (load_prom_mapped(TEST_DATA, &prom) != 0 || prom.int_nb_students == 0)
+    {
+        printf("test_resave: cannot load %s\n", TEST_DATA);
+        return (1);
+    }
+    
+    check_resave(&prom, 0, save_prom_binary);
+    check_resave(&prom, 0, save_prom_binary_compact);
+    check_resave(&prom, 0, save_prom_binary_v1);
+    check_resave(&prom, 0, save_packed);
+    check_resave(&prom, 1, save_prom_binary);
+    check_resave(&prom, 1, save_prom_binary_v1);
+    
+    destroy_prom(&prom);
+    remove(TEST_FILE);
+    
+    return (end_tests("test_resave"));
+}